@@ -0,0 +1,463 @@
+/**
+ * @brief - Benchmark of the computation of the fractals: fixed views are
+ *          rendered without the graphical interface and the time spent to
+ *          compute them is reported, along with the statistics of the tiles
+ *          or the accuracy of the pixels. The variant of the kernels can be
+ *          forced through the `FRACTSIM_KERNELS` environment variable to
+ *          compare the instruction sets.
+ */
+
+# include <chrono>
+# include <cmath>
+# include <cstdio>
+# include <cstdlib>
+# include <limits>
+# include <memory>
+# include <string>
+# include <vector>
+# include <gmp.h>
+# include <core_utils/log/Locator.hh>
+# include <core_utils/log/PrefixedLogger.hh>
+# include <core_utils/log/StdLogger.hh>
+# include <core_utils/CoreException.hh>
+# include "Fractal.hh"
+# include "KernelDispatch.hh"
+# include "MandelbrotRenderingOptions.hh"
+# include "JuliaRenderingOptions.hh"
+# include "NewtonRenderingOptions.hh"
+# include "RenderingTile.hh"
+
+namespace {
+
+  /**
+   * @brief - The dimensions of the canvas of each view, in pixels. The views
+   *          are divided into tiles by the fractal, just like in the application.
+   */
+  constexpr float CANVAS_WIDTH = 256.0f;
+  constexpr float CANVAS_HEIGHT = 192.0f;
+
+  /**
+   * @brief - The number of times each view is rendered: the fastest run is the
+   *          one reported, which filters out most of the noise of the host.
+   */
+  constexpr unsigned RUNS = 3u;
+
+  /**
+   * @brief - The difference between the confidence of a pixel and the one of
+   *          the arbitrary precision above which the pixel is considered wrong.
+   */
+  constexpr float TOLERANCE = 0.01f;
+
+  /**
+   * @brief - Points close to the boundary of the cubic Mandelbrot set and of
+   *          the Julia set of `-0.123+0.745i`, used as the center of the deep
+   *          zooms. Enough digits are provided for the deepest view.
+   */
+  constexpr const char* CUBIC_X = "0.391699888248519257555865459807645895287349039";
+  constexpr const char* CUBIC_Y = "0.615528395819101779194775248393012581710496401";
+  constexpr const char* JULIA_X = "0.218666374542415853102526308146082131462151003";
+  constexpr const char* JULIA_Y = "0.281142481554534693046966858259072364378969419";
+
+  /**
+   * @brief - A point of the Seahorse valley of the Mandelbrot set, used as the
+   *          center of a view mostly made of escaping points.
+   */
+  constexpr const char* SEAHORSE_X = "-0.743643887037158704752191506114774";
+  constexpr const char* SEAHORSE_Y = "0.131825904205311970493132056385139";
+
+  /**
+   * @brief - Convenience structure describing the result of a benchmark.
+   */
+  struct Timing {
+    double ms;
+    fractsim::RenderingStatistics stats;
+  };
+
+  /**
+   * @brief - Used to compute the input tiles and measure the time spent to do
+   *          so. The tiles are created anew for each run through the provided
+   *          generator so that no cached value can be reused.
+   * @param generator - creates the tiles to compute.
+   * @return - the fastest of the runs with the statistics of its tiles.
+   */
+  template <typename Generator>
+  Timing
+  measure(Generator generator) {
+    Timing best{std::numeric_limits<double>::max(), fractsim::RenderingStatistics{}};
+
+    for (unsigned run = 0u ; run < RUNS ; ++run) {
+      std::vector<fractsim::RenderingTileShPtr> tiles = generator();
+      fractsim::RenderingStatistics stats{};
+
+      auto start = std::chrono::steady_clock::now();
+      for (unsigned id = 0u ; id < tiles.size() ; ++id) {
+        tiles[id]->compute();
+      }
+      auto end = std::chrono::steady_clock::now();
+
+      for (unsigned id = 0u ; id < tiles.size() ; ++id) {
+        stats.merge(tiles[id]->getStatistics());
+      }
+
+      double ms = std::chrono::duration<double, std::milli>(end - start).count();
+      if (ms < best.ms) {
+        best = Timing{ms, stats};
+      }
+    }
+
+    return best;
+  }
+
+  /**
+   * @brief - Renders all the tiles of the input view with the specified strategy
+   *          and traversal, using the precisions selected by the fractal.
+   * @param options - the fractal to render.
+   * @param area - the view to render.
+   * @param strategy - the strategy used to fill the tiles.
+   * @param traversal - the order of the pixels in the packets.
+   * @return - the time spent to compute the view.
+   */
+  Timing
+  renderView(fractsim::FractalOptionsShPtr options,
+             const fractsim::GMPBox& area,
+             const fractsim::tile::Strategy& strategy,
+             const fractsim::kernels::Traversal& traversal)
+  {
+    return measure(
+      [&]() {
+        fractsim::Fractal fractal(utils::Sizef(CANVAS_WIDTH, CANVAS_HEIGHT), area);
+        options->prepareRendering(area, fractal.getPixelSize());
+
+        return fractal.generateRenderingTiles(options, strategy, traversal);
+      }
+    );
+  }
+
+  /**
+   * @brief - Creates a view of the default window of the input fractal zoomed
+   *          `zooms` times by a factor `2` around the input point.
+   * @param options - the fractal providing the default window.
+   * @param x - the abscissa of the center of the zoom.
+   * @param y - the ordinate of the center of the zoom.
+   * @param zooms - the number of zoom operations.
+   * @return - the zoomed view.
+   */
+  fractsim::GMPBox
+  zoomOn(const fractsim::FractalOptions& options,
+         const char* x,
+         const char* y,
+         unsigned zooms)
+  {
+    mpf_t cx, cy;
+    mpf_init2(cx, 256u);
+    mpf_init2(cy, 256u);
+    mpf_set_str(cx, x, 10);
+    mpf_set_str(cy, y, 10);
+
+    fractsim::GMPVector2 center(cx, cy);
+
+    mpf_clear(cx);
+    mpf_clear(cy);
+
+    fractsim::GMPBox area(options.getDefaultRenderingWindow());
+    for (unsigned id = 0u ; id < zooms ; ++id) {
+      area.zoom(center, 2.0f);
+    }
+
+    return area;
+  }
+
+  /**
+   * @brief - Renders a single tile of the input view close to its center with
+   *          each precision, and compares the result with the one computed in
+   *          arbitrary precision. The precision selected by the fractal for the
+   *          tile is flagged.
+   * @param name - a description of the view.
+   * @param options - the fractal to render.
+   * @param area - the view to render.
+   */
+  void
+  benchmarkPrecisions(const std::string& name,
+                      fractsim::FractalOptionsShPtr options,
+                      const fractsim::GMPBox& area)
+  {
+    fractsim::Fractal fractal(utils::Sizef(CANVAS_WIDTH, CANVAS_HEIGHT), area);
+    options->prepareRendering(area, fractal.getPixelSize());
+
+    std::vector<fractsim::RenderingTileShPtr> tiles = fractal.generateRenderingTiles(
+      options,
+      fractsim::tile::Strategy::PerPixel,
+      fractsim::kernels::Traversal::Morton
+    );
+
+    // The tiles are generated row by row from the bottom left corner of the
+    // view: the center of the view is the bottom left corner of this one.
+    unsigned count = static_cast<unsigned>(std::sqrt(tiles.size()));
+    fractsim::RenderingTileShPtr model = tiles[count * count / 2u + count / 2u];
+
+    utils::Sizef dims = model->getArea().toSize();
+    utils::Sizei pixels(
+      static_cast<int>(CANVAS_WIDTH) / count,
+      static_cast<int>(CANVAS_HEIGHT) / count
+    );
+    utils::Sizef step(dims.w() / pixels.w(), dims.h() / pixels.h());
+
+    auto create = [&](const fractsim::scalar::Precision& precision) {
+      return std::make_shared<fractsim::RenderingTile>(
+        model->getAnchor(),
+        model->getXMin(),
+        model->getYMin(),
+        dims,
+        step,
+        model->getScale(),
+        options,
+        fractsim::tile::Strategy::PerPixel,
+        fractsim::kernels::Traversal::Morton,
+        precision
+      );
+    };
+
+    fractsim::RenderingTileShPtr reference = create(fractsim::scalar::Precision::Arbitrary);
+    reference->compute();
+
+    std::printf(
+      "%s, pixel 2^%ld\n",
+      name.c_str(),
+      fractsim::GMPFloat::getExponent(fractal.getPixelSize().get())
+    );
+
+    const fractsim::scalar::Precision precisions[] = {
+      fractsim::scalar::Precision::DoubleDouble,
+      fractsim::scalar::Precision::Fixed128,
+      fractsim::scalar::Precision::Quadruple,
+      fractsim::scalar::Precision::Fixed192,
+      fractsim::scalar::Precision::Arbitrary
+    };
+
+    for (const fractsim::scalar::Precision& precision : precisions) {
+      if (!fractsim::scalar::isAvailable(precision)) {
+        continue;
+      }
+
+      fractsim::RenderingTileShPtr tile;
+      Timing timing = measure(
+        [&]() {
+          tile = create(precision);
+          return std::vector<fractsim::RenderingTileShPtr>{tile};
+        }
+      );
+
+      // Compare the confidence of each pixel with the one of the reference.
+      unsigned wrong = 0u;
+      bool inside = false;
+
+      for (int y = 0 ; y < pixels.h() ; ++y) {
+        for (int x = 0 ; x < pixels.w() ; ++x) {
+          double px = x * static_cast<double>(step.w());
+          double py = y * static_cast<double>(step.h());
+
+          float expected = reference->getConfidenceAt(px, py, inside);
+          float actual = tile->getConfidenceAt(px, py, inside);
+
+          if (std::abs(expected - actual) > TOLERANCE) {
+            ++wrong;
+          }
+        }
+      }
+
+      std::printf(
+        "    %-13s %10.1fms %5u wrong pixel(s)%s\n",
+        fractsim::scalar::toString(precision).c_str(),
+        timing.ms,
+        wrong,
+        precision == model->getPrecision() ? " (selected)" : ""
+      );
+    }
+  }
+
+  /**
+   * @brief - Renders the input view of a fractal with each strategy to fill the
+   *          tiles.
+   * @param name - a description of the view.
+   * @param options - the fractal to render.
+   * @param area - the view to render.
+   */
+  void
+  benchmarkStrategies(const std::string& name,
+                      fractsim::FractalOptionsShPtr options,
+                      const fractsim::GMPBox& area)
+  {
+    const fractsim::tile::Strategy strategies[] = {
+      fractsim::tile::Strategy::PerPixel,
+      fractsim::tile::Strategy::Subdivision,
+      fractsim::tile::Strategy::BoundaryTracing
+    };
+
+    std::printf("%s\n", name.c_str());
+
+    for (const fractsim::tile::Strategy& strategy : strategies) {
+      Timing timing = renderView(options, area, strategy, fractsim::kernels::Traversal::Morton);
+
+      std::printf(
+        "    %-16s %8.1fms %s\n",
+        fractsim::tile::toString(strategy).c_str(),
+        timing.ms,
+        timing.stats.toString().c_str()
+      );
+    }
+  }
+
+  /**
+   * @brief - Renders the default view of the input fractal with the per pixel
+   *          strategy, which only measures the speed of the kernels.
+   * @param name - a description of the fractal.
+   * @param options - the fractal to render.
+   */
+  void
+  benchmarkKernels(const std::string& name,
+                   fractsim::FractalOptionsShPtr options)
+  {
+    Timing timing = renderView(
+      options,
+      fractsim::GMPBox(options->getDefaultRenderingWindow()),
+      fractsim::tile::Strategy::PerPixel,
+      fractsim::kernels::Traversal::Morton
+    );
+
+    std::printf("  %-28s %8.1fms %s\n", name.c_str(), timing.ms, timing.stats.toString().c_str());
+  }
+
+}
+
+int main(int /*argc*/, char** /*argv*/) {
+  // Create the logger: only the errors are displayed so that the messages of
+  // the tiles do not get mixed with the results.
+  utils::log::StdLogger raw;
+  raw.setLevel(utils::log::Severity::ERROR);
+  utils::log::PrefixedLogger logger("fractsim", "bench");
+  utils::log::Locator::provide(&raw);
+
+  try {
+    std::printf("Kernels: %s\n\n", fractsim::kernels::getVariantName().c_str());
+
+    // The cheapest precision able to compute a view accurately depends on
+    // the zoom level: the cubic Mandelbrot set and the Julia sets are never
+    // computed through perturbation so every precision can be compared.
+    std::printf("Precisions\n");
+
+    auto cubic = std::make_shared<fractsim::MandelbrotRenderingOptions>(3.0f);
+    cubic->setAccuracy(1000u);
+
+    auto julia = std::make_shared<fractsim::JuliaRenderingOptions>(utils::Vector2f(-0.123f, 0.745f));
+    julia->setAccuracy(1000u);
+
+    for (unsigned zooms : {60u, 96u, 106u}) {
+      benchmarkPrecisions(
+        "  cubic Mandelbrot, " + std::to_string(zooms) + " zoom(s)",
+        cubic,
+        zoomOn(*cubic, CUBIC_X, CUBIC_Y, zooms)
+      );
+      benchmarkPrecisions(
+        "  Julia -0.123+0.745i, " + std::to_string(zooms) + " zoom(s)",
+        julia,
+        zoomOn(*julia, JULIA_X, JULIA_Y, zooms)
+      );
+    }
+
+    // The strategies skipping the computation of some pixels of the tiles: the
+    // default views contain large regions inside the sets, while the zoomed one
+    // mostly contains escaping points.
+    std::printf("\nStrategies\n");
+
+    auto mandelbrot = std::make_shared<fractsim::MandelbrotRenderingOptions>();
+    mandelbrot->setAccuracy(1000u);
+
+    benchmarkStrategies(
+      "  Mandelbrot",
+      mandelbrot,
+      fractsim::GMPBox(mandelbrot->getDefaultRenderingWindow())
+    );
+    benchmarkStrategies(
+      "  Mandelbrot, 10 zoom(s)",
+      mandelbrot,
+      zoomOn(*mandelbrot, SEAHORSE_X, SEAHORSE_Y, 10u)
+    );
+    benchmarkStrategies(
+      "  Julia -0.123+0.745i",
+      julia,
+      fractsim::GMPBox(julia->getDefaultRenderingWindow())
+    );
+
+    // The cost of the Newton fractals grows with the degree of the polynom.
+    std::printf("\nNewton polynoms\n");
+
+    for (unsigned degree : {5u, 10u, 20u, 50u}) {
+      auto newton = std::make_shared<fractsim::NewtonRenderingOptions>(
+        std::vector<fractsim::NewtonRenderingOptions::Coefficient>{
+          {0.0f, utils::Vector2f(-1.0f, 0.0f)},
+          {static_cast<float>(degree), utils::Vector2f(1.0f, 0.0f)}
+        }
+      );
+
+      benchmarkKernels("z^" + std::to_string(degree) + " - 1", newton);
+    }
+
+    // The escape time kernels with long series, where the bailout tests are
+    // a significant part of the work: they are checked after each iteration
+    // or after chunks of iterations.
+    std::printf("\nEscape time kernels\n");
+
+    for (bool chunked : {true, false}) {
+      std::string suffix = chunked ? ", chunks" : ", no chunks";
+
+      for (unsigned accuracy : {256u, 4096u}) {
+        auto quadratic = std::make_shared<fractsim::MandelbrotRenderingOptions>();
+        quadratic->setAccuracy(accuracy);
+        quadratic->setPeriodicityCheck(false);
+        quadratic->setChunkedBailout(chunked);
+        benchmarkKernels("Mandelbrot " + std::to_string(accuracy) + suffix, quadratic);
+      }
+
+      auto periodic = std::make_shared<fractsim::MandelbrotRenderingOptions>();
+      periodic->setAccuracy(4096u);
+      periodic->setChunkedBailout(chunked);
+      benchmarkKernels("periodicity" + suffix, periodic);
+
+      auto dendrite = std::make_shared<fractsim::JuliaRenderingOptions>(utils::Vector2f(-0.8f, 0.156f));
+      dendrite->setAccuracy(4096u);
+      dendrite->setChunkedBailout(chunked);
+      benchmarkKernels("Julia -0.8+0.156i" + suffix, dendrite);
+    }
+
+    // The lanes of the packets can either be refilled with a new pixel as soon
+    // as their series ends or wait for the other lanes of their packet.
+    std::printf("\nLane refill\n");
+
+    for (bool refill : {true, false}) {
+      std::string suffix = refill ? ", refill" : ", no refill";
+
+      for (unsigned accuracy : {256u, 4096u}) {
+        auto quadratic = std::make_shared<fractsim::MandelbrotRenderingOptions>();
+        quadratic->setAccuracy(accuracy);
+        quadratic->setPeriodicityCheck(false);
+        quadratic->setLaneRefill(refill);
+        benchmarkKernels("Mandelbrot " + std::to_string(accuracy) + suffix, quadratic);
+      }
+
+      auto dendrite = std::make_shared<fractsim::JuliaRenderingOptions>(utils::Vector2f(-0.8f, 0.156f));
+      dendrite->setAccuracy(4096u);
+      dendrite->setLaneRefill(refill);
+      benchmarkKernels("Julia -0.8+0.156i" + suffix, dendrite);
+    }
+  }
+  catch (const utils::CoreException& e) {
+    logger.error("Caught internal exception while running benchmark", e.what());
+    return EXIT_FAILURE;
+  }
+  catch (const std::exception& e) {
+    logger.error("Caught internal exception while running benchmark", e.what());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -20,22 +20,6 @@
 # include "RenderingStatus.hh"
 # include "StatusBar.hh"
 
-// TODO: At high zoom level the precision of the float is not enough. We could go
-// with `double` but it would just temporarily hide the problem and not solve it.
-// What would be cool is to introduce an arbitrary precision library like GMP.
-// See here: https://gmplib.org/manual/Initializing-Floats.html#Initializing-Floats
-// The `CMake` is already updated, and there's some sample code in the `GMPBox` and
-// `GMPVector2` class.
-// What is left to do is to use these types of values for most of the places where
-// the `utils::Vector2f` and `utils::Boxf` classes are used. This will require some
-// effort are there are a lot of manipulations that are done with these objects.
-// Also we have to find a way to pass around the `mpf_t` elements (for method like
-// the `x` in `GMPVector2` or `w` in `GMPBox`): should we pass them by pointer or
-// reference or whatever ? Probably not pass them at all would be cool but it might
-// require a lot of efforts.
-// This would truly solve the problems of precision though, even if it might be at
-// the cost of performance.
-
 namespace {
 constexpr auto APP_NAME = "fractsim";
 constexpr auto APP_TITLE = "The best way to get wallpapers (c)";
@@ -73,7 +57,7 @@ int main(int /*argc*/, char** /*argv*/) {
     fractsim::JuliaOptions* juliaOpt = new fractsim::JuliaOptions();
     app->addDockWidget(juliaOpt, sdl::app::DockWidgetArea::RightArea, std::string("Julia"));
 
-    fractsim::NewtonOptions* newtonOpt = new fractsim::NewtonOptions(5u);
+    fractsim::NewtonOptions* newtonOpt = new fractsim::NewtonOptions(64u);
     app->addDockWidget(newtonOpt, sdl::app::DockWidgetArea::RightArea, std::string("Newton"));
 
     fractsim::RenderingStatus* status = new fractsim::RenderingStatus();
@@ -0,0 +1,504 @@
+
+# include "ArbitraryKernel.hh"
+# include <algorithm>
+
+namespace fractsim {
+  namespace kernels {
+
+    namespace {
+
+      /**
+       * @brief - The gmp floats used by a thread to iterate the series. They are
+       *          allocated once per thread and only reallocated when the precision
+       *          of the computations changes, so that computing a pixel does not
+       *          allocate.
+       */
+      class Scratch {
+        public:
+
+          /**
+           * @brief - Creates the gmp floats with the default precision.
+           */
+          Scratch();
+
+          /**
+           * @brief - Releases the gmp floats.
+           */
+          ~Scratch();
+
+          Scratch(const Scratch&) = delete;
+
+          Scratch&
+          operator=(const Scratch&) = delete;
+
+          /**
+           * @brief - Sets the precision of the gmp floats. Nothing happens if they
+           *          already have this precision. Keeping a higher precision than
+           *          needed would slow down the computations of the shallower views.
+           * @param bits - the precision of the gmp floats.
+           */
+          void
+          setPrecision(unsigned bits);
+
+        public:
+
+          // The coordinates of the current pixel.
+          mpf_t px, py;
+
+          // The constant and the current term of the series.
+          mpf_t cr, ci;
+          mpf_t zr, zi;
+
+          // The saved term used to detect periodic orbits.
+          mpf_t sr, si;
+
+          // Temporary values.
+          mpf_t pr, pi;
+          mpf_t tr, ti, tmp;
+
+        private:
+
+          /**
+           * @brief - Used to apply a function to all the gmp floats of this object.
+           * @param func - the function to apply.
+           */
+          template <typename Function>
+          void
+          forEach(Function func);
+
+          /**
+           * @brief - The current precision of the gmp floats.
+           */
+          unsigned m_bits;
+      };
+
+      Scratch::Scratch():
+        m_bits(GMPFloat::getDefaultPrecision())
+      {
+        forEach([this](mpf_ptr value) { mpf_init2(value, m_bits); });
+      }
+
+      Scratch::~Scratch() {
+        forEach([](mpf_ptr value) { mpf_clear(value); });
+      }
+
+      void
+      Scratch::setPrecision(unsigned bits) {
+        if (bits == m_bits) {
+          return;
+        }
+
+        m_bits = bits;
+        forEach([this](mpf_ptr value) { mpf_set_prec(value, m_bits); });
+      }
+
+      template <typename Function>
+      void
+      Scratch::forEach(Function func) {
+        mpf_ptr values[] = {px, py, cr, ci, zr, zi, sr, si, pr, pi, tr, ti, tmp};
+
+        for (unsigned id = 0u ; id < sizeof(values) / sizeof(values[0]) ; ++id) {
+          func(values[id]);
+        }
+      }
+
+      /**
+       * @brief - Used to retrieve the gmp floats of the calling thread.
+       * @return - the gmp floats to use to compute pixels.
+       */
+      Scratch&
+      getScratch() {
+        thread_local Scratch scratch;
+        return scratch;
+      }
+
+      /**
+       * @brief - Computes the precision needed to process a block: it should allow
+       *          to distinguish neighboring pixels, in the same way as the fixed
+       *          precisions are selected, and keep all the bits of the origin.
+       * @param block - the block to process.
+       * @return - the precision to use in bits.
+       */
+      unsigned
+      getPrecision(const PixelBlock<scalar::Arbitrary>& block) noexcept {
+        long extent = std::max(GMPFloat::getExponent(block.xMin.get()), GMPFloat::getExponent(block.yMin.get())) + 1l;
+        long step = std::min(GMPFloat::getExponent(block.stepX.get()), GMPFloat::getExponent(block.stepY.get()));
+
+        unsigned bits = std::max(block.xMin.getPrecision(), block.yMin.getPrecision());
+        if (extent > step) {
+          bits = std::max(bits, static_cast<unsigned>(extent - step));
+        }
+
+        return bits + scalar::getMarginBits();
+      }
+
+      /**
+       * @brief - Similar to the above method but for a list of points. The points
+       *          hold the bits needed to distinguish them from one another so the
+       *          precision is derived from the one of the coordinates.
+       * @param points - the points to process.
+       * @return - the precision to use in bits.
+       */
+      unsigned
+      getPrecision(const PointList<scalar::Arbitrary>& points) noexcept {
+        unsigned bits = GMPFloat::getDefaultPrecision();
+
+        for (unsigned id = 0u ; id < points.count ; ++id) {
+          bits = std::max(bits, std::max(points.xs[id].getPrecision(), points.ys[id].getPrecision()));
+        }
+
+        return bits + scalar::getMarginBits();
+      }
+
+      /**
+       * @brief - Calls the input function with the coordinates of each pixel of the
+       *          block, computed with the precision of the scratch values.
+       * @param block - the block of pixels to process.
+       * @param s - the gmp floats of the thread.
+       * @param func - the function to call for each pixel: it receives the index
+       *               of the pixel while its coordinates are in `s.px` and `s.py`.
+       */
+      template <typename Function>
+      void
+      forEachPixel(const PixelBlock<scalar::Arbitrary>& block,
+                   Scratch& s,
+                   Function func)
+      {
+        for (unsigned y = 0u ; y < block.h ; ++y) {
+          mpf_mul_ui(s.py, block.stepY.get(), y);
+          mpf_add(s.py, s.py, block.yMin.get());
+
+          for (unsigned x = 0u ; x < block.w ; ++x) {
+            mpf_mul_ui(s.px, block.stepX.get(), x);
+            mpf_add(s.px, s.px, block.xMin.get());
+
+            func(y * block.w + x);
+          }
+        }
+      }
+
+      template <typename Function>
+      void
+      forEachPixel(const PointList<scalar::Arbitrary>& points,
+                   Scratch& s,
+                   Function func)
+      {
+        for (unsigned id = 0u ; id < points.count ; ++id) {
+          mpf_set(s.px, points.xs[id].get());
+          mpf_set(s.py, points.ys[id].get());
+
+          func(id);
+        }
+      }
+
+      /**
+       * @brief - Computes `z^exponent` where `z` is the current term of the series
+       *          held by `s.zr` and `s.zi`. The result is saved in `s.pr` and `s.pi`.
+       * @param s - the gmp floats of the thread.
+       * @param exponent - the exponent to apply.
+       */
+      void
+      power(Scratch& s,
+            unsigned exponent) noexcept
+      {
+        if (exponent == 2u) {
+          mpf_mul(s.tr, s.zr, s.zr);
+          mpf_mul(s.ti, s.zi, s.zi);
+
+          mpf_mul(s.pi, s.zr, s.zi);
+          mpf_mul_2exp(s.pi, s.pi, 1u);
+
+          mpf_sub(s.pr, s.tr, s.ti);
+
+          return;
+        }
+
+        mpf_set(s.pr, s.zr);
+        mpf_set(s.pi, s.zi);
+
+        for (unsigned id = 1u ; id < exponent ; ++id) {
+          mpf_mul(s.tr, s.pr, s.zr);
+          mpf_mul(s.ti, s.pi, s.zi);
+          mpf_mul(s.tmp, s.pr, s.zi);
+
+          mpf_mul(s.pi, s.pi, s.zr);
+          mpf_add(s.pi, s.pi, s.tmp);
+
+          mpf_sub(s.pr, s.tr, s.ti);
+        }
+      }
+
+      /**
+       * @brief - Used to determine whether the constant of the series, held by
+       *          `s.cr` and `s.ci`, lies inside the main cardioid or the period-2
+       *          bulb of the quadratic Mandelbrot set.
+       * @param s - the gmp floats of the thread.
+       * @return - `true` if the point belongs to one of the regions.
+       */
+      bool
+      insideMainBulbs(Scratch& s) noexcept {
+        // y2 = ci^2
+        mpf_mul(s.ti, s.ci, s.ci);
+
+        // xq = cr - 1/4 and q = xq^2 + y2
+        mpf_set_d(s.tmp, 0.25);
+        mpf_sub(s.pr, s.cr, s.tmp);
+        mpf_mul(s.tr, s.pr, s.pr);
+        mpf_add(s.tr, s.tr, s.ti);
+
+        // q * (q + xq) < y2 / 4
+        mpf_add(s.pi, s.tr, s.pr);
+        mpf_mul(s.pi, s.pi, s.tr);
+        mpf_div_2exp(s.tmp, s.ti, 2u);
+
+        if (mpf_cmp(s.pi, s.tmp) < 0) {
+          return true;
+        }
+
+        // (cr + 1)^2 + y2 < 1/16
+        mpf_set_d(s.tmp, 1.0);
+        mpf_add(s.pr, s.cr, s.tmp);
+        mpf_mul(s.pr, s.pr, s.pr);
+        mpf_add(s.pr, s.pr, s.ti);
+
+        return mpf_cmp_d(s.pr, 0.0625) < 0;
+      }
+
+      /**
+       * @brief - Iterates the series starting from the term held by `s.zr` and
+       *          `s.zi` with the constant held by `s.cr` and `s.ci`. This follows
+       *          exactly the same termination conditions as the other kernels.
+       * @param s - the gmp floats of the thread.
+       * @param exponent - the exponent of the series.
+       * @param params - the parameters of the series.
+       * @param terms - output value receiving the number of terms computed.
+       * @param len - output value receiving the squared modulus of the last term.
+       * @param periodic - output value set to `true` in case the orbit was detected
+       *                   to be periodic.
+       */
+      void
+      iterate(Scratch& s,
+              unsigned exponent,
+              const EscapeTimeParams& params,
+              unsigned& terms,
+              float& len,
+              bool& periodic) noexcept
+      {
+        unsigned conv = 0u;
+        terms = 0u;
+        len = 0.0f;
+        periodic = false;
+
+        const bool detect = params.periodicity > 0.0;
+        mpf_set(s.sr, s.zr);
+        mpf_set(s.si, s.zi);
+        unsigned checkpoint = 1u;
+
+        while ((len < params.threshold && terms < params.accuracy) || terms - conv < params.overshoot) {
+          power(s, exponent);
+          mpf_add(s.zr, s.pr, s.cr);
+          mpf_add(s.zi, s.pi, s.ci);
+
+          // The modulus is only needed to compare it to the thresholds: the
+          // double precision is enough for that.
+          double re = mpf_get_d(s.zr);
+          double im = mpf_get_d(s.zi);
+
+          len = static_cast<float>(re * re + im * im);
+          if (len >= params.threshold && conv == 0u) {
+            conv = terms;
+          }
+          ++terms;
+
+          if (detect) {
+            mpf_sub(s.tr, s.zr, s.sr);
+            mpf_sub(s.ti, s.zi, s.si);
+
+            double dr = mpf_get_d(s.tr);
+            double di = mpf_get_d(s.ti);
+
+            if (len < params.threshold && dr * dr + di * di < params.periodicity) {
+              periodic = true;
+              return;
+            }
+
+            if (terms == checkpoint) {
+              mpf_set(s.sr, s.zr);
+              mpf_set(s.si, s.zi);
+              checkpoint *= 2u;
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief - Used to finalize the results of a pixel: the pixels which were
+       *          detected to be part of the set are assigned the number of terms
+       *          they would have reached without any optimization.
+       * @param interior - `true` if the pixel is known to be part of the set.
+       * @param accuracy - the number of terms reached by the points of the set.
+       * @param terms - the number of terms actually computed for the pixel.
+       * @param stats - the statistics to update.
+       */
+      void
+      finalize(bool interior,
+               unsigned accuracy,
+               unsigned& terms,
+               RenderingStatistics& stats) noexcept
+      {
+        stats.iterations += terms;
+
+        if (interior) {
+          stats.saved += accuracy - terms;
+          terms = accuracy;
+        }
+      }
+
+      /**
+       * @brief - Processes all the pixels of the input for the Mandelbrot series.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param exponent - the exponent of the series.
+       * @param params - the parameters of the series.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param lens - output array receiving the squared modulus of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Input>
+      void
+      mandelbrotSeries(const Input& input,
+                       unsigned exponent,
+                       const EscapeTimeParams& params,
+                       unsigned* terms,
+                       float* lens,
+                       RenderingStatistics& stats) noexcept
+      {
+        const unsigned interior = params.accuracy > params.overshoot ? params.accuracy : params.overshoot;
+
+        Scratch& s = getScratch();
+        s.setPrecision(getPrecision(input));
+
+        forEachPixel(
+          input,
+          s,
+          [&](unsigned offset) {
+            mpf_set(s.cr, s.px);
+            mpf_set(s.ci, s.py);
+
+            unsigned t = 0u;
+            float len = 0.0f;
+            bool periodic = false;
+
+            bool inside = (exponent == 2u && insideMainBulbs(s));
+            if (!inside) {
+              mpf_set_ui(s.zr, 0u);
+              mpf_set_ui(s.zi, 0u);
+
+              iterate(s, exponent, params, t, len, periodic);
+            }
+            finalize(inside || periodic, interior, t, stats);
+
+            terms[offset] = t;
+            lens[offset] = len;
+          }
+        );
+      }
+
+      /**
+       * @brief - Processes all the pixels of the input for the Julia series with
+       *          the constant `(cx, cy)`.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param cx - the real part of the constant of the Julia set.
+       * @param cy - the imaginary part of the constant of the Julia set.
+       * @param params - the parameters of the series.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param lens - output array receiving the squared modulus of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Input>
+      void
+      juliaSeries(const Input& input,
+                  float cx,
+                  float cy,
+                  const EscapeTimeParams& params,
+                  unsigned* terms,
+                  float* lens,
+                  RenderingStatistics& stats) noexcept
+      {
+        const unsigned interior = params.accuracy > params.overshoot ? params.accuracy : params.overshoot;
+
+        Scratch& s = getScratch();
+        s.setPrecision(getPrecision(input));
+
+        mpf_set_d(s.cr, cx);
+        mpf_set_d(s.ci, cy);
+
+        forEachPixel(
+          input,
+          s,
+          [&](unsigned offset) {
+            mpf_set(s.zr, s.px);
+            mpf_set(s.zi, s.py);
+
+            unsigned t;
+            float len;
+            bool periodic;
+
+            iterate(s, 2u, params, t, len, periodic);
+            finalize(periodic, interior, t, stats);
+
+            terms[offset] = t;
+            lens[offset] = len;
+          }
+        );
+      }
+
+    }
+
+    void
+    mandelbrot(const PixelBlock<scalar::Arbitrary>& block,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept
+    {
+      mandelbrotSeries(block, exponent, params, terms, lens, stats);
+    }
+
+    void
+    mandelbrot(const PointList<scalar::Arbitrary>& points,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept
+    {
+      mandelbrotSeries(points, exponent, params, terms, lens, stats);
+    }
+
+    void
+    julia(const PixelBlock<scalar::Arbitrary>& block,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept
+    {
+      juliaSeries(block, cx, cy, params, terms, lens, stats);
+    }
+
+    void
+    julia(const PointList<scalar::Arbitrary>& points,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept
+    {
+      juliaSeries(points, cx, cy, params, terms, lens, stats);
+    }
+
+  }
+}
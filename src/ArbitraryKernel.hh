@@ -0,0 +1,112 @@
+#ifndef    ARBITRARY_KERNEL_HH
+# define   ARBITRARY_KERNEL_HH
+
+# include "EscapeTimeKernel.hh"
+# include "ScalarPrecision.hh"
+
+namespace fractsim {
+  namespace kernels {
+
+    /**
+     * @brief - Version of the `mandelbrot` kernel for values with arbitrary precision.
+     *          It follows exactly the same termination conditions as the other ones
+     *          but computes the series with gmp floats. The precision is derived from
+     *          the size of the pixels compared to their coordinates, so that it grows
+     *          along with the zoom level.
+     *          Each thread owns its own set of gmp floats which is reused from one
+     *          call to the next: the only allocations happen when the precision
+     *          needs to grow, never while iterating the series.
+     *          The overloads are selected instead of the templated kernels when the
+     *          input pixels are described with `scalar::Arbitrary` values.
+     * @param block - the block of pixels to process.
+     * @param exponent - the exponent of the series. Should be supported according
+     *                   to `supportsExponent`.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the block.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the block.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    mandelbrot(const PixelBlock<scalar::Arbitrary>& block,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Similar to the above method but processes an arbitrary list of
+     *          pixels instead of a block. As there is no pixel size available,
+     *          the precision is derived from the precision of the coordinates.
+     * @param points - the list of pixels to process.
+     * @param exponent - the exponent of the series. Should be supported according
+     *                   to `supportsExponent`.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the list.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the list.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    mandelbrot(const PointList<scalar::Arbitrary>& points,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Version of the `julia` kernel for values with arbitrary precision.
+     *          See the `mandelbrot` overloads for more details.
+     * @param block - the block of pixels to process.
+     * @param cx - the real part of the constant of the Julia set.
+     * @param cy - the imaginary part of the constant of the Julia set.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the block.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the block.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    julia(const PixelBlock<scalar::Arbitrary>& block,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Similar to the above method but processes an arbitrary list of
+     *          pixels instead of a block.
+     * @param points - the list of pixels to process.
+     * @param cx - the real part of the constant of the Julia set.
+     * @param cy - the imaginary part of the constant of the Julia set.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the list.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the list.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    julia(const PointList<scalar::Arbitrary>& points,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept;
+
+  }
+}
+
+#endif    /* ARBITRARY_KERNEL_HH */
@@ -0,0 +1,187 @@
+#ifndef    DOUBLE_DOUBLE_HH
+# define   DOUBLE_DOUBLE_HH
+
+namespace fractsim {
+  namespace dd {
+
+    /**
+     * @brief - Describes a value represented as the unevaluated sum of two double
+     *          precision values, where the `lo` part holds the rounding error of
+     *          the `hi` part. This provides about 106 bits of mantissa with the
+     *          exponent range of a double, which is enough for the zoom levels
+     *          lying between the double precision and the arbitrary precision.
+     *          The arithmetic only relies on the basic operations of the `T` type
+     *          so it can be used both with scalar values and with packets: all the
+     *          lanes of the packets are then processed at once.
+     *          The error-free transformations used by the operations require that
+     *          the computations are not contracted into fused multiply-add: the
+     *          translation units using this type should be compiled accordingly.
+     *          See https://www.davidhbailey.com/dhbpapers/qd.pdf for details.
+     */
+    template <typename T>
+    struct Number {
+      T hi;
+      T lo;
+
+      /**
+       * @brief - Creates a null value.
+       */
+      Number() = default;
+
+      /**
+       * @brief - Creates a value from its two parts. The parts are expected to be
+       *          normalized, i.e. `lo` should be smaller than half a unit in the
+       *          last place of `hi`.
+       * @param h - the high part of the value.
+       * @param l - the low part of the value.
+       */
+      Number(const T& h,
+             const T& l) noexcept;
+
+      /**
+       * @brief - Creates a value from a scalar of any floating point type. The
+       *          bits of the input which do not fit in the high part are kept in
+       *          the low part.
+       * @param value - the value to convert.
+       */
+      template <typename U>
+      explicit
+      Number(const U& value) noexcept;
+
+      /**
+       * @brief - Converts this value to another floating point type.
+       * @return - the converted value.
+       */
+      template <typename U>
+      explicit
+      operator U() const noexcept;
+
+      Number&
+      operator+=(const Number& rhs) noexcept;
+
+      Number&
+      operator-=(const Number& rhs) noexcept;
+
+      Number&
+      operator*=(const Number& rhs) noexcept;
+    };
+
+    /**
+     * @brief - Computes the sum of the input values along with its rounding error,
+     *          so that `s + e = a + b` exactly. The operands are copied so that the
+     *          outputs can be the same variables as the inputs.
+     * @param a - the first operand.
+     * @param b - the second operand.
+     * @param s - output value receiving the rounded sum.
+     * @param e - output value receiving the rounding error.
+     */
+    template <typename T>
+    void
+    twoSum(T a,
+           T b,
+           T& s,
+           T& e) noexcept;
+
+    /**
+     * @brief - Similar to `twoSum` but assumes that the magnitude of `a` is larger
+     *          than the magnitude of `b`, which saves some operations.
+     * @param a - the first operand.
+     * @param b - the second operand.
+     * @param s - output value receiving the rounded sum.
+     * @param e - output value receiving the rounding error.
+     */
+    template <typename T>
+    void
+    quickTwoSum(T a,
+                T b,
+                T& s,
+                T& e) noexcept;
+
+    /**
+     * @brief - Computes the product of the input values along with its rounding
+     *          error, so that `p + e = a * b` exactly. The operands are split in
+     *          halves (Dekker's algorithm) so that no fused multiply-add is needed.
+     * @param a - the first operand.
+     * @param b - the second operand.
+     * @param p - output value receiving the rounded product.
+     * @param e - output value receiving the rounding error.
+     */
+    template <typename T>
+    void
+    twoProd(T a,
+            T b,
+            T& p,
+            T& e) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator-(const Number<T>& value) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator+(const Number<T>& lhs,
+              const Number<T>& rhs) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator+(const Number<T>& lhs,
+              double rhs) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator+(double lhs,
+              const Number<T>& rhs) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator-(const Number<T>& lhs,
+              const Number<T>& rhs) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator-(const Number<T>& lhs,
+              double rhs) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator-(double lhs,
+              const Number<T>& rhs) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator*(const Number<T>& lhs,
+              const Number<T>& rhs) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator*(const Number<T>& lhs,
+              double rhs) noexcept;
+
+    template <typename T>
+    Number<T>
+    operator*(double lhs,
+              const Number<T>& rhs) noexcept;
+
+    /**
+     * @brief - Compares two values. This is only available for scalar values as
+     *          the result of the comparison of packets would be a mask.
+     * @param lhs - the left operand of the comparison.
+     * @param rhs - the right operand of the comparison.
+     * @return - `true` if `lhs < rhs`.
+     */
+    template <typename T>
+    bool
+    operator<(const Number<T>& lhs,
+              const Number<T>& rhs) noexcept;
+
+    template <typename T>
+    bool
+    operator<(const Number<T>& lhs,
+              double rhs) noexcept;
+
+  }
+}
+
+# include "DoubleDouble.hxx"
+
+#endif    /* DOUBLE_DOUBLE_HH */
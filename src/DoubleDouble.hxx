@@ -0,0 +1,244 @@
+#ifndef    DOUBLE_DOUBLE_HXX
+# define   DOUBLE_DOUBLE_HXX
+
+# include "DoubleDouble.hh"
+
+namespace fractsim {
+  namespace dd {
+
+    template <typename T>
+    inline
+    Number<T>::Number(const T& h,
+                      const T& l) noexcept:
+      hi(h),
+      lo(l)
+    {}
+
+    template <typename T>
+    template <typename U>
+    inline
+    Number<T>::Number(const U& value) noexcept:
+      hi(static_cast<double>(value)),
+      lo(static_cast<double>(value - static_cast<U>(static_cast<double>(value))))
+    {}
+
+    template <typename T>
+    template <typename U>
+    inline
+    Number<T>::operator U() const noexcept {
+      return static_cast<U>(hi) + static_cast<U>(lo);
+    }
+
+    template <typename T>
+    inline
+    Number<T>&
+    Number<T>::operator+=(const Number& rhs) noexcept {
+      *this = *this + rhs;
+      return *this;
+    }
+
+    template <typename T>
+    inline
+    Number<T>&
+    Number<T>::operator-=(const Number& rhs) noexcept {
+      *this = *this - rhs;
+      return *this;
+    }
+
+    template <typename T>
+    inline
+    Number<T>&
+    Number<T>::operator*=(const Number& rhs) noexcept {
+      *this = *this * rhs;
+      return *this;
+    }
+
+    template <typename T>
+    inline
+    void
+    twoSum(T a,
+           T b,
+           T& s,
+           T& e) noexcept
+    {
+      s = a + b;
+      T bb = s - a;
+      e = (a - (s - bb)) + (b - bb);
+    }
+
+    template <typename T>
+    inline
+    void
+    quickTwoSum(T a,
+                T b,
+                T& s,
+                T& e) noexcept
+    {
+      s = a + b;
+      e = b - (s - a);
+    }
+
+    template <typename T>
+    inline
+    void
+    twoProd(T a,
+            T b,
+            T& p,
+            T& e) noexcept
+    {
+      // Split each operand in two halves of 26 bits so that the products
+      // of the halves are exact.
+      const double splitter = 134217729.0;
+
+      T t = splitter * a;
+      T aHi = t - (t - a);
+      T aLo = a - aHi;
+
+      t = splitter * b;
+      T bHi = t - (t - b);
+      T bLo = b - bHi;
+
+      p = a * b;
+      e = ((aHi * bHi - p) + aHi * bLo + aLo * bHi) + aLo * bLo;
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator-(const Number<T>& value) noexcept {
+      return Number<T>(-value.hi, -value.lo);
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator+(const Number<T>& lhs,
+              const Number<T>& rhs) noexcept
+    {
+      // The kernels regularly subtract close values (typically when computing
+      // the real part of a square) so we use the accurate version of the sum
+      // which accounts for the error of both parts.
+      T s, e, t, f;
+      twoSum(lhs.hi, rhs.hi, s, e);
+      twoSum(lhs.lo, rhs.lo, t, f);
+
+      e = e + t;
+      quickTwoSum(s, e, s, e);
+      e = e + f;
+      quickTwoSum(s, e, s, e);
+
+      return Number<T>(s, e);
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator+(const Number<T>& lhs,
+              double rhs) noexcept
+    {
+      T s, e;
+      twoSum(lhs.hi, T{} + rhs, s, e);
+
+      e = e + lhs.lo;
+      quickTwoSum(s, e, s, e);
+
+      return Number<T>(s, e);
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator+(double lhs,
+              const Number<T>& rhs) noexcept
+    {
+      return rhs + lhs;
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator-(const Number<T>& lhs,
+              const Number<T>& rhs) noexcept
+    {
+      return lhs + (-rhs);
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator-(const Number<T>& lhs,
+              double rhs) noexcept
+    {
+      return lhs + (-rhs);
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator-(double lhs,
+              const Number<T>& rhs) noexcept
+    {
+      return (-rhs) + lhs;
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator*(const Number<T>& lhs,
+              const Number<T>& rhs) noexcept
+    {
+      T p, e;
+      twoProd(lhs.hi, rhs.hi, p, e);
+
+      e = e + (lhs.hi * rhs.lo + lhs.lo * rhs.hi);
+      quickTwoSum(p, e, p, e);
+
+      return Number<T>(p, e);
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator*(const Number<T>& lhs,
+              double rhs) noexcept
+    {
+      T p, e;
+      twoProd(lhs.hi, T{} + rhs, p, e);
+
+      e = e + lhs.lo * rhs;
+      quickTwoSum(p, e, p, e);
+
+      return Number<T>(p, e);
+    }
+
+    template <typename T>
+    inline
+    Number<T>
+    operator*(double lhs,
+              const Number<T>& rhs) noexcept
+    {
+      return rhs * lhs;
+    }
+
+    template <typename T>
+    inline
+    bool
+    operator<(const Number<T>& lhs,
+              const Number<T>& rhs) noexcept
+    {
+      return lhs.hi < rhs.hi || (lhs.hi == rhs.hi && lhs.lo < rhs.lo);
+    }
+
+    template <typename T>
+    inline
+    bool
+    operator<(const Number<T>& lhs,
+              double rhs) noexcept
+    {
+      return lhs.hi < rhs || (lhs.hi == rhs && lhs.lo < 0.0);
+    }
+
+  }
+}
+
+#endif    /* DOUBLE_DOUBLE_HXX */
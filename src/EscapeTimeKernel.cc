@@ -0,0 +1,1298 @@
+
+# include "EscapeTimeKernel.hh"
+# include <algorithm>
+# include <cmath>
+# include <type_traits>
+# include <vector>
+# include "ScalarPrecision.hh"
+# include "SimdMath.hh"
+# include "SimdPacket.hh"
+# include "SimdTraversal.hh"
+
+namespace fractsim {
+  namespace kernels::inline FRACTSIM_KERNELS_VARIANT {
+    namespace {
+
+      /**
+       * @brief - Computes the `N`-th power of the input packet of complex numbers
+       *          through repeated multiplications. The exponent being known at
+       *          compile time the multiplications are fully unrolled and we use
+       *          exponentiation by squaring to minimize their number.
+       *          This works both with packets and with scalar values.
+       * @param zr - the real part of the numbers to raise to the `N`-th power.
+       * @param zi - the imaginary part of the numbers to raise to the `N`-th power.
+       * @param pr - output value receiving the real part of the result.
+       * @param pi - output value receiving the imaginary part of the result.
+       */
+      template <unsigned N, typename Values>
+      inline
+      void
+      power(const Values& zr,
+            const Values& zi,
+            Values& pr,
+            Values& pi) noexcept
+      {
+        static_assert(N > 0u, "Exponent should be strictly positive");
+
+        if constexpr (N == 1u) {
+          pr = zr;
+          pi = zi;
+        }
+        else if constexpr (N % 2u == 0u) {
+          Values hr, hi;
+          power<N / 2u>(zr, zi, hr, hi);
+
+          pr = hr * hr - hi * hi;
+          pi = 2.0f * hr * hi;
+        }
+        else {
+          Values hr, hi;
+          power<N - 1u>(zr, zi, hr, hi);
+
+          pr = hr * zr - hi * zi;
+          pi = hr * zi + hi * zr;
+        }
+      }
+
+      /**
+       * @brief - Computes the input packet of complex numbers raised to any real
+       *          exponent through their polar form: `z^n = exp(n * log(|z|)) *
+       *          (cos(n * arg(z)), sin(n * arg(z)))`. This relies on the vectorized
+       *          approximations of the elementary functions rather than on the
+       *          generic `std::pow`, which processes the lanes one at a time.
+       *          The argument is taken in `[-pi; pi]` just like `std::arg` so that
+       *          the branch cut of non-integer exponents is the same as the one of
+       *          the scalar path, and the power of the origin is `0`.
+       * @param zr - the real part of the numbers to raise to the power.
+       * @param zi - the imaginary part of the numbers to raise to the power.
+       * @param exponent - the exponent of the power.
+       * @param pr - output value receiving the real part of the result.
+       * @param pi - output value receiving the imaginary part of the result.
+       */
+      inline
+      void
+      power(const simd::Floats& zr,
+            const simd::Floats& zi,
+            float exponent,
+            simd::Floats& pr,
+            simd::Floats& pi) noexcept
+      {
+        const simd::Mask sign = reinterpret_cast<simd::Mask>(simd::broadcast<simd::Floats>(-0.0f));
+        const simd::Floats ar = reinterpret_cast<simd::Floats>(reinterpret_cast<simd::Mask>(zr) & ~sign);
+        const simd::Floats ai = reinterpret_cast<simd::Floats>(reinterpret_cast<simd::Mask>(zi) & ~sign);
+        const simd::Floats m = simd::select(ar > ai, ar, ai);
+
+        // The squared modulus of the terms following the divergence of the
+        // series may overflow: the coordinates are scaled by the power of two
+        // of the largest one, which is exact, and the scaling is accounted for
+        // in the logarithm.
+        simd::Mask k = ((reinterpret_cast<simd::Mask>(m) >> 23) & 0xff) - 127;
+        k += (k > 127);
+
+        const simd::Floats scale = reinterpret_cast<simd::Floats>((127 - k) << 23);
+        const simd::Floats sr = zr * scale;
+        const simd::Floats si = zi * scale;
+        const simd::Floats fk = __builtin_convertvector(k, simd::Floats);
+
+        simd::Floats lr = 0.5f * simd::log(sr * sr + si * si) + fk * -2.12194440e-4f;
+        lr += fk * 0.693359375f;
+
+        simd::Floats s, c;
+        simd::sincos(exponent * simd::atan2(zi, zr), s, c);
+
+        const simd::Floats rho = simd::exp(exponent * lr);
+        const simd::Mask origin = m == 0.0f;
+
+        pr = simd::select(origin, simd::Floats{}, rho * c);
+        pi = simd::select(origin, simd::Floats{}, rho * s);
+      }
+
+      /**
+       * @brief - Used to retrieve the number of iterations performed by the packet
+       *          kernels between two checks of the status of the lanes. Larger
+       *          chunks make the checks less frequent but waste more iterations
+       *          each time a lane stops during a chunk.
+       * @return - the number of iterations of each chunk.
+       */
+      constexpr
+      unsigned
+      getChunkSize() noexcept {
+        return 8u;
+      }
+
+      /**
+       * @brief - Used to retrieve the maximum number of iterations processed one
+       *          at a time by the packet kernels after a chunk was rolled back.
+       * @return - the maximum number of iterations between two chunks.
+       */
+      inline
+      unsigned
+      getMaxBackoff() noexcept {
+        return 128u;
+      }
+
+      /**
+       * @brief - Used to retrieve the number of lanes which should be idle before
+       *          refilling them with new pixels when streaming the pixels through
+       *          the lanes. Lower values keep more lanes busy but refill them more
+       *          often.
+       * @return - the minimum number of idle lanes triggering a refill.
+       */
+      constexpr
+      unsigned
+      getRefillThreshold() noexcept {
+        return simd::Width / 4u;
+      }
+
+      /**
+       * @brief - Iterates the series `z(n+1) = z(n)^N + c` for a packet of pixels
+       *          until each lane either diverged (and performed the overshoot steps)
+       *          or reached the accuracy. The power is computed by the input `step`
+       *          so that the same loop serves all the exponents.
+       *          When `Chunk` is not null the iterations are speculatively run in
+       *          chunks of `Chunk` iterations, the status of the lanes being only
+       *          checked at the end of each chunk. Chunks during which some lanes
+       *          stopped are rolled back and processed one iteration at a time so
+       *          that the results are strictly identical in both cases.
+       *          The lanes which are not `valid` are never iterated.
+       *          In case the periodicity detection is enabled, the lanes for which
+       *          a term of the series is repeated are also stopped and flagged in
+       *          the `periodic` mask.
+       *          The comparisons to the threshold are always performed in single
+       *          precision as they are not native for packets of doubles, while the
+       *          distance to the periodicity reference is compared in double so
+       *          that small tolerances do not vanish.
+       * @param zr - the real part of the first term of the series for each lane.
+       * @param zi - the imaginary part of the first term of the series for each lane.
+       * @param cr - the real part of the constant of the series for each lane.
+       * @param ci - the imaginary part of the constant of the series for each lane.
+       * @param valid - the lanes which should be processed.
+       * @param params - the parameters of the series.
+       * @param terms - output packet receiving the number of terms computed.
+       * @param len - output packet receiving the squared modulus of the last term.
+       * @param periodic - output mask receiving the lanes for which the orbit was
+       *                   detected to be periodic.
+       * @param step - the function raising a term of the series to the power `N`,
+       *               following the prototype of `power`.
+       * @return - the number of iterations performed on the packet, including the
+       *           ones which were rolled back.
+       */
+      template <unsigned Chunk, typename Values, typename Step>
+      inline
+      unsigned
+      iterate(Values zr,
+              Values zi,
+              const Values& cr,
+              const Values& ci,
+              const simd::Mask& valid,
+              const EscapeTimeParams& params,
+              simd::Counters& terms,
+              simd::Floats& len,
+              simd::Mask& periodic,
+              const Step& step) noexcept
+      {
+        simd::Counters conv = simd::Counters{};
+        terms = simd::Counters{};
+        len = simd::Floats{};
+        periodic = simd::Mask{};
+
+        // This reproduces the scalar loop condition, evaluated independently for
+        // each lane: a lane stays active as long as it did not diverge nor reach
+        // the accuracy, or while it did not perform the overshoot steps.
+        simd::Mask active = valid & (
+          ((len < params.threshold) & (terms < params.accuracy)) |
+          ((terms - conv) < params.overshoot)
+        );
+
+        // All the active lanes compute their terms in lockstep so the index of
+        // the current term is the same for all of them: it is thus enough to
+        // track the next time the reference term should be saved with a single
+        // counter. The reference is refreshed at each power of two.
+        const bool detect = params.periodicity > 0.0;
+        Values sr = zr, si = zi;
+        unsigned iteration = 0u, checkpoint = 1u, steps = 0u;
+
+        Values nr, ni;
+
+        // Performs a single iteration and updates the status of each lane.
+        auto advance = [&]() {
+          ++steps;
+          step(zr, zi, nr, ni);
+          nr += cr;
+          ni += ci;
+
+          zr = simd::select(active, nr, zr);
+          zi = simd::select(active, ni, zi);
+          len = active ? simd::norm(nr, ni) : len;
+
+          simd::Mask diverged = active & (len >= params.threshold) & (conv == 0u);
+          conv = diverged ? terms : conv;
+
+          // Active lanes are equal to `-1` so subtracting them increments the
+          // counters of the lanes still iterating.
+          terms -= reinterpret_cast<simd::Counters>(active);
+          ++iteration;
+
+          if (detect) {
+            Values dr = zr - sr;
+            Values di = zi - si;
+
+            periodic |= active & (len < params.threshold) & simd::within(dr, di, params.periodicity);
+
+            if (iteration == checkpoint) {
+              sr = zr;
+              si = zi;
+              checkpoint *= 2u;
+            }
+          }
+
+          active = valid & ~periodic & (
+            ((len < params.threshold) & (terms < params.accuracy)) |
+            ((terms - conv) < params.overshoot)
+          );
+        };
+
+        if constexpr (Chunk == 0u) {
+          while (simd::any(active)) {
+            advance();
+          }
+
+          return steps;
+        }
+
+        // The number of iterations to process one at a time before trying to
+        // process a chunk again. It grows each time a chunk is rolled back so
+        // that the packets where lanes stop frequently do not waste too many
+        // iterations. Many lanes stop during the first iterations so chunks
+        // are not attempted right away.
+        unsigned delay = Chunk, backoff = Chunk;
+
+        while (simd::any(active)) {
+          // Most iterations do not change the status of any lane: they are run
+          // in chunks where only the terms are updated, the status being checked
+          // once at the end of the chunk. As the chunk does not reach the accu-
+          // racy and no lane performs its overshoot steps, the lanes can only
+          // stop because they diverged or were found to be periodic.
+          if (delay > 0u || iteration + Chunk > params.accuracy || simd::any(active & (conv != 0u))) {
+            advance();
+            delay -= (delay > 0u ? 1u : 0u);
+            continue;
+          }
+
+          const Values br = zr, bi = zi, bsr = sr, bsi = si;
+          const simd::Floats blen = len;
+          const unsigned bIteration = iteration, bCheckpoint = checkpoint;
+
+          simd::Mask stopped = simd::Mask{};
+
+          steps += Chunk;
+
+          for (unsigned id = 0u ; id < Chunk ; ++id) {
+            step(zr, zi, nr, ni);
+            nr += cr;
+            ni += ci;
+
+            zr = simd::select(active, nr, zr);
+            zi = simd::select(active, ni, zi);
+            len = active ? simd::norm(nr, ni) : len;
+
+            // Also catches the lanes which would produce a `NaN`.
+            stopped |= ~(len < params.threshold);
+            ++iteration;
+
+            if (detect) {
+              Values dr = zr - sr;
+              Values di = zi - si;
+
+              stopped |= simd::within(dr, di, params.periodicity);
+
+              if (iteration == checkpoint) {
+                sr = zr;
+                si = zi;
+                checkpoint *= 2u;
+              }
+            }
+          }
+
+          if (!simd::any(active & stopped)) {
+            terms = active ? terms + Chunk : terms;
+            active = valid & ~periodic & (
+              ((len < params.threshold) & (terms < params.accuracy)) |
+              ((terms - conv) < params.overshoot)
+            );
+
+            backoff = Chunk;
+            continue;
+          }
+
+          // Some lanes stopped during the chunk: roll back to its beginning and
+          // process it again one iteration at a time to find out when exactly.
+          zr = br;
+          zi = bi;
+          sr = bsr;
+          si = bsi;
+          len = blen;
+          iteration = bIteration;
+          checkpoint = bCheckpoint;
+
+          delay = backoff;
+          backoff = std::min(2u * backoff, getMaxBackoff());
+        }
+
+        return steps;
+      }
+
+      /**
+       * @brief - Computes the squared modulus of a complex number in single precision.
+       *          The fixed point values are converted beforehand as the squares of
+       *          the terms of the series might not fit in their range.
+       * @param zr - the real part of the number.
+       * @param zi - the imaginary part of the number.
+       * @return - the squared modulus of the number.
+       */
+      template <typename Scalar>
+      inline
+      float
+      squaredModulus(const Scalar& zr,
+                     const Scalar& zi) noexcept
+      {
+        if constexpr (fixed::isNumber<Scalar>) {
+          double r = static_cast<double>(zr);
+          double i = static_cast<double>(zi);
+
+          return static_cast<float>(r * r + i * i);
+        }
+        else {
+          return static_cast<float>(zr * zr + zi * zi);
+        }
+      }
+
+      /**
+       * @brief - Continues the series of a single pixel which already diverged,
+       *          until the overshoot steps are performed. This follows the same
+       *          termination conditions as the scalar version of `iterate`, which
+       *          hands over the iterations to this method when its terms would
+       *          overflow.
+       * @param zr - the real part of the current term of the series.
+       * @param zi - the imaginary part of the current term of the series.
+       * @param cr - the real part of the constant of the series.
+       * @param ci - the imaginary part of the constant of the series.
+       * @param params - the parameters of the series.
+       * @param conv - the index of the term which diverged.
+       * @param terms - the number of terms computed so far, updated with the
+       *                ones computed by this method.
+       * @param len - the squared modulus of the current term, updated with the
+       *              one of the last term.
+       */
+      template <unsigned N>
+      inline
+      void
+      overshoot(double zr,
+                double zi,
+                double cr,
+                double ci,
+                const EscapeTimeParams& params,
+                unsigned conv,
+                unsigned& terms,
+                float& len) noexcept
+      {
+        double nr, ni;
+
+        while ((len < params.threshold && terms < params.accuracy) || terms - conv < params.overshoot) {
+          power<N>(zr, zi, nr, ni);
+          zr = nr + cr;
+          zi = ni + ci;
+
+          len = static_cast<float>(zr * zr + zi * zi);
+          if (len >= params.threshold && conv == 0u) {
+            conv = terms;
+          }
+          ++terms;
+        }
+      }
+
+      /**
+       * @brief - Similar to the packet version of `iterate` but iterates the series
+       *          of a single pixel. This is used for the scalar types which cannot
+       *          be packed, and it follows exactly the same termination conditions.
+       *          The fixed point values cannot hold the terms following the ones
+       *          which diverged: the overshoot steps are then performed in double
+       *          precision, which is plenty for the smoothing.
+       * @param zr - the real part of the first term of the series.
+       * @param zi - the imaginary part of the first term of the series.
+       * @param cr - the real part of the constant of the series.
+       * @param ci - the imaginary part of the constant of the series.
+       * @param params - the parameters of the series.
+       * @param terms - output value receiving the number of terms computed.
+       * @param len - output value receiving the squared modulus of the last term.
+       * @param periodic - output value set to `true` in case the orbit was detected
+       *                   to be periodic.
+       */
+      template <unsigned N, typename Scalar>
+      inline
+      void
+      iterate(Scalar zr,
+              Scalar zi,
+              const Scalar& cr,
+              const Scalar& ci,
+              const EscapeTimeParams& params,
+              unsigned& terms,
+              float& len,
+              bool& periodic) noexcept
+      {
+        unsigned conv = 0u;
+        terms = 0u;
+        len = 0.0f;
+        periodic = false;
+
+        const bool detect = params.periodicity > 0.0;
+        Scalar sr = zr, si = zi;
+        unsigned checkpoint = 1u;
+
+        Scalar nr, ni;
+
+        while ((len < params.threshold && terms < params.accuracy) || terms - conv < params.overshoot) {
+          power<N>(zr, zi, nr, ni);
+          zr = nr + cr;
+          zi = ni + ci;
+
+          len = squaredModulus(zr, zi);
+          if (len >= params.threshold && conv == 0u) {
+            conv = terms;
+          }
+          ++terms;
+
+          if constexpr (fixed::isNumber<Scalar>) {
+            if (len >= params.threshold) {
+              overshoot<N>(
+                static_cast<double>(zr),
+                static_cast<double>(zi),
+                static_cast<double>(cr),
+                static_cast<double>(ci),
+                params,
+                conv,
+                terms,
+                len
+              );
+              return;
+            }
+          }
+
+          if (detect) {
+            // The differences are converted before being squared: the square
+            // of a small difference would vanish with fixed point values.
+            double dr = static_cast<double>(zr - sr);
+            double di = static_cast<double>(zi - si);
+
+            if (len < params.threshold && dr * dr + di * di < params.periodicity) {
+              periodic = true;
+              return;
+            }
+
+            if (terms == checkpoint) {
+              sr = zr;
+              si = zi;
+              checkpoint *= 2u;
+            }
+          }
+        }
+      }
+
+      /**
+       * @brief - Used to finalize the results of a packet of pixels: the lanes which
+       *          were detected to be part of the set are assigned the number of terms
+       *          they would have reached without any optimization and the statistics
+       *          are updated with the work performed on the packet.
+       * @param valid - the lanes which hold actual pixels.
+       * @param interior - the lanes known to be part of the set.
+       * @param accuracy - the number of terms reached by the points of the set.
+       * @param terms - the number of terms actually computed for each lane, which
+       *                is updated to reflect the lanes belonging to the set.
+       * @param stats - the statistics to update.
+       */
+      inline
+      void
+      finalize(const simd::Mask& valid,
+               const simd::Mask& interior,
+               unsigned accuracy,
+               simd::Counters& terms,
+               RenderingStatistics& stats) noexcept
+      {
+        const simd::Counters zero = simd::Counters{};
+        const simd::Counters full = zero + accuracy;
+
+        const unsigned long long computed = simd::sum(valid ? terms : zero);
+
+        stats.iterations += computed;
+        stats.busy += computed;
+        stats.saved += simd::sum(interior ? full - terms : zero);
+
+        terms = interior ? full : terms;
+      }
+
+      /**
+       * @brief - Similar to the above method but for a single pixel.
+       * @param interior - `true` if the pixel is known to be part of the set.
+       * @param accuracy - the number of terms reached by the points of the set.
+       * @param terms - the number of terms actually computed for the pixel.
+       * @param stats - the statistics to update.
+       */
+      inline
+      void
+      finalize(bool interior,
+               unsigned accuracy,
+               unsigned& terms,
+               RenderingStatistics& stats) noexcept
+      {
+        stats.iterations += terms;
+
+        if (interior) {
+          stats.saved += accuracy - terms;
+          terms = accuracy;
+        }
+      }
+
+      /**
+       * @brief - Used to determine which lanes of the packet lie inside the main
+       *          cardioid or the period-2 bulb of the quadratic Mandelbrot set.
+       *          The points of these regions are known to belong to the set so
+       *          there is no need to iterate the series for them.
+       *          See https://en.wikipedia.org/wiki/Plotting_algorithms_for_the_Mandelbrot_set#Cardioid_/_bulb_checking
+       *          This works both with packets, in which case a mask is returned,
+       *          and with scalar values.
+       * @param cr - the real part of the points to check.
+       * @param ci - the imaginary part of the points to check.
+       * @return - a value indicating which points are inside one of the regions.
+       */
+      template <typename Values>
+      inline
+      auto
+      insideMainBulbs(const Values& cr,
+                      const Values& ci) noexcept
+      {
+        Values y2 = ci * ci;
+
+        Values xq = cr - 0.25f;
+        Values q = xq * xq + y2;
+
+        Values xb = cr + 1.0f;
+
+        if constexpr (std::is_arithmetic_v<Values> || std::is_same_v<Values, scalar::Quad> || fixed::isNumber<Values>) {
+          return q * (q + xq) < 0.25f * y2 || xb * xb + y2 < 0.0625f;
+        }
+        else {
+          simd::Mask cardioid = simd::less(q * (q + xq), 0.25f * y2);
+          simd::Mask bulb = simd::less(xb * xb + y2, simd::broadcast<Values>(0.0625f));
+
+          return cardioid | bulb;
+        }
+      }
+
+      /**
+       * @brief - Iterates the series of a list of pixels while keeping all the lanes
+       *          of the vector units busy: as soon as the series of a lane ends its
+       *          results are saved and the lane picks up the next pending pixel, so
+       *          that no lane idles until the slowest lane of its packet is done.
+       *          As the lanes are no longer iterated in lockstep, the reference term
+       *          used to detect periodic orbits is tracked for each lane. Each lane
+       *          performs the same operations as with the packet version of
+       *          `iterate`: the results are strictly identical. The iterations are
+       *          processed in chunks of `Chunk` iterations in the same way.
+       * @param xs - the real part of the coordinates of the pixels.
+       * @param ys - the imaginary part of the coordinates of the pixels.
+       * @param offsets - the index of each pixel in the output arrays.
+       * @param julia - `true` if the pixels define the first term of the series and
+       *                `false` if they define its constant.
+       * @param kr - the real part of the value shared by all the pixels: either the
+       *             constant of the series or its first term.
+       * @param ki - the imaginary part of the value shared by all the pixels.
+       * @param params - the parameters of the series.
+       * @param step - the function raising a term of the series to its power.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param lens - output array receiving the squared modulus of the last term.
+       * @param stats - output statistics updated with the work performed.
+       * @return - the number of iterations performed by the vector units, including
+       *           the ones which were rolled back.
+       */
+      template <unsigned Chunk, typename Scalar, typename Step>
+      inline
+      unsigned long long
+      stream(const std::vector<Scalar>& xs,
+             const std::vector<Scalar>& ys,
+             const std::vector<unsigned>& offsets,
+             bool julia,
+             const Scalar& kr,
+             const Scalar& ki,
+             const EscapeTimeParams& params,
+             const Step& step,
+             unsigned* terms,
+             float* lens,
+             RenderingStatistics& stats) noexcept
+      {
+        using Values = simd::Packet<Scalar>;
+
+        const unsigned interior = params.accuracy > params.overshoot ? params.accuracy : params.overshoot;
+        const bool detect = params.periodicity > 0.0;
+
+        Values zr = Values{}, zi = Values{}, cr = Values{}, ci = Values{};
+        Values sr = Values{}, si = Values{};
+        simd::Counters t = simd::Counters{}, conv = simd::Counters{}, checkpoint = simd::Counters{};
+        simd::Floats len = simd::Floats{};
+        simd::Mask valid = simd::Mask{}, periodic = simd::Mask{};
+
+        unsigned slots[simd::Width];
+        unsigned next = 0u;
+
+        // Assigns the next pending pixel to a lane, or disables the lane in case
+        // all the pixels were already assigned.
+        auto refill = [&](unsigned lane) {
+          if (next >= offsets.size()) {
+            valid[lane] = 0;
+            return;
+          }
+
+          simd::insert(zr, lane, julia ? xs[next] : kr);
+          simd::insert(zi, lane, julia ? ys[next] : ki);
+          simd::insert(cr, lane, julia ? kr : xs[next]);
+          simd::insert(ci, lane, julia ? ki : ys[next]);
+          simd::insert(sr, lane, simd::extract<Scalar>(zr, lane));
+          simd::insert(si, lane, simd::extract<Scalar>(zi, lane));
+
+          t[lane] = 0u;
+          conv[lane] = 0u;
+          checkpoint[lane] = 1u;
+          len[lane] = 0.0f;
+          valid[lane] = -1;
+          periodic[lane] = 0;
+          slots[lane] = offsets[next];
+
+          ++next;
+        };
+
+        for (unsigned lane = 0u ; lane < simd::Width ; ++lane) {
+          refill(lane);
+        }
+
+        unsigned long long steps = 0u;
+        Values nr, ni;
+
+        // Just like for `iterate`, chunks are only attempted after a few single
+        // iterations.
+        unsigned delay = Chunk, backoff = Chunk;
+
+        while (true) {
+          simd::Mask active = valid & ~periodic & (
+            ((len < params.threshold) & (t < params.accuracy)) |
+            ((t - conv) < params.overshoot)
+          );
+
+          // Save the results of the lanes which are done and assign them a new
+          // pixel: their status is evaluated again before iterating. Refilling
+          // lanes one at a time is costly so idle lanes are accumulated first.
+          simd::Mask done = valid & ~active;
+          if (simd::any(done) && (!simd::any(active) || simd::sum(reinterpret_cast<simd::Counters>(done) & 1u) >= getRefillThreshold())) {
+            for (unsigned lane = 0u ; lane < simd::Width ; ++lane) {
+              if (done[lane] == 0) {
+                continue;
+              }
+
+              unsigned count = t[lane];
+              stats.busy += count;
+              finalize(periodic[lane] != 0, interior, count, stats);
+
+              terms[slots[lane]] = count;
+              lens[slots[lane]] = len[lane];
+
+              refill(lane);
+            }
+
+            continue;
+          }
+
+          if (!simd::any(active)) {
+            break;
+          }
+
+          // Similar to the chunks of `iterate` except that the lanes do not all
+          // have the same number of terms: the conditions are evaluated for each
+          // lane, including the times at which the reference terms are saved.
+          if constexpr (Chunk > 0u) {
+            const simd::Mask late = (t + Chunk > params.accuracy) | (conv != 0u);
+
+            if (delay == 0u && !simd::any(active & late)) {
+              const Values br = zr, bi = zi, bsr = sr, bsi = si;
+              const simd::Floats blen = len;
+              const simd::Counters bCheckpoint = checkpoint;
+
+              simd::Mask stopped = simd::Mask{};
+              simd::Counters count = t;
+
+              steps += Chunk;
+
+              for (unsigned id = 0u ; id < Chunk ; ++id) {
+                step(zr, zi, nr, ni);
+                nr += cr;
+                ni += ci;
+
+                zr = simd::select(active, nr, zr);
+                zi = simd::select(active, ni, zi);
+                len = active ? simd::norm(nr, ni) : len;
+
+                // Also catches the lanes which would produce a `NaN`.
+                stopped |= ~(len < params.threshold);
+                count -= reinterpret_cast<simd::Counters>(active);
+
+                if (detect) {
+                  Values dr = zr - sr;
+                  Values di = zi - si;
+
+                  stopped |= simd::within(dr, di, params.periodicity);
+
+                  simd::Mask save = active & (count == checkpoint);
+                  sr = simd::select(save, zr, sr);
+                  si = simd::select(save, zi, si);
+                  checkpoint = save ? checkpoint + checkpoint : checkpoint;
+                }
+              }
+
+              if (!simd::any(active & stopped)) {
+                t = count;
+                backoff = Chunk;
+                continue;
+              }
+
+              zr = br;
+              zi = bi;
+              sr = bsr;
+              si = bsi;
+              len = blen;
+              checkpoint = bCheckpoint;
+
+              delay = backoff;
+              backoff = std::min(2u * backoff, getMaxBackoff());
+            }
+          }
+
+          ++steps;
+          step(zr, zi, nr, ni);
+          nr += cr;
+          ni += ci;
+
+          zr = simd::select(active, nr, zr);
+          zi = simd::select(active, ni, zi);
+          len = active ? simd::norm(nr, ni) : len;
+
+          simd::Mask diverged = active & (len >= params.threshold) & (conv == 0u);
+          conv = diverged ? t : conv;
+
+          t -= reinterpret_cast<simd::Counters>(active);
+
+          if (detect) {
+            Values dr = zr - sr;
+            Values di = zi - si;
+
+            periodic |= active & (len < params.threshold) & simd::within(dr, di, params.periodicity);
+
+            simd::Mask save = active & (t == checkpoint);
+            sr = simd::select(save, zr, sr);
+            si = simd::select(save, zi, si);
+            checkpoint = save ? checkpoint + checkpoint : checkpoint;
+          }
+
+          delay -= (delay > 0u ? 1u : 0u);
+        }
+
+        return steps;
+      }
+
+      /**
+       * @brief - Processes all the pixels of the input in packets. Depending on the
+       *          parameters each packet is either iterated until all its lanes are
+       *          done, or the pixels are streamed through the lanes with `stream`.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param julia - `true` if the pixels define the first term of the series and
+       *                `false` if they define its constant.
+       * @param kr - the real part of the value shared by all the pixels: either the
+       *             constant of the series or its first term.
+       * @param ki - the imaginary part of the value shared by all the pixels.
+       * @param params - the parameters of the series.
+       * @param inside - a function returning the lanes of a packet of pixels known
+       *                 to belong to the set, which are not iterated.
+       * @param step - the function raising a term of the series to its power.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param lens - output array receiving the squared modulus of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <unsigned Chunk, typename Scalar, typename Input, typename Inside, typename Step>
+      void
+      packetSeries(const Input& input,
+                   bool julia,
+                   const Scalar& kr,
+                   const Scalar& ki,
+                   const EscapeTimeParams& params,
+                   const Inside& inside,
+                   const Step& step,
+                   unsigned* terms,
+                   float* lens,
+                   RenderingStatistics& stats) noexcept
+      {
+        using Values = simd::Packet<Scalar>;
+
+        // The points belonging to the set would iterate until reaching the
+        // accuracy (or at least the overshoot).
+        const unsigned interior = params.accuracy > params.overshoot ? params.accuracy : params.overshoot;
+        const Values shr = simd::broadcast<Values>(kr);
+        const Values shi = simd::broadcast<Values>(ki);
+
+        if (!params.refill) {
+          simd::forEachPacket(
+            input,
+            [&](const Values& px,
+                const Values& py,
+                const simd::Mask& valid,
+                const simd::Counters& slots)
+            {
+              simd::Counters t;
+              simd::Floats len;
+              simd::Mask periodic;
+
+              simd::Mask in = valid & inside(px, py);
+
+              unsigned steps = iterate<Chunk>(
+                julia ? px : shr,
+                julia ? py : shi,
+                julia ? shr : px,
+                julia ? shi : py,
+                valid & ~in,
+                params,
+                t,
+                len,
+                periodic,
+                step
+              );
+
+              stats.lanes += simd::Width * steps;
+              finalize(valid, in | periodic, interior, t, stats);
+              simd::accumulateSpread(t, valid, stats);
+
+              simd::scatter(t, terms, slots, valid);
+              simd::scatter(len, lens, slots, valid);
+            }
+          );
+
+          return;
+        }
+
+        // Gather the pixels to iterate, the ones known to belong to the set being
+        // directly assigned their results.
+        std::vector<Scalar> xs, ys;
+        std::vector<unsigned> offsets;
+        std::vector<simd::Counters> packets;
+        std::vector<simd::Mask> masks;
+
+        simd::forEachPacket(
+          input,
+          [&](const Values& px,
+              const Values& py,
+              const simd::Mask& valid,
+              const simd::Counters& slots)
+          {
+            simd::Mask in = valid & inside(px, py);
+
+            packets.push_back(slots);
+            masks.push_back(valid);
+
+            for (unsigned lane = 0u ; lane < simd::Width ; ++lane) {
+              if (valid[lane] == 0) {
+                continue;
+              }
+
+              if (in[lane] != 0) {
+                unsigned t = 0u;
+                finalize(true, interior, t, stats);
+
+                terms[slots[lane]] = t;
+                lens[slots[lane]] = 0.0f;
+
+                continue;
+              }
+
+              xs.push_back(simd::extract<Scalar>(px, lane));
+              ys.push_back(simd::extract<Scalar>(py, lane));
+              offsets.push_back(slots[lane]);
+            }
+          }
+        );
+
+        stats.lanes += simd::Width * stream<Chunk>(xs, ys, offsets, julia, kr, ki, params, step, terms, lens, stats);
+
+        // The coherence is evaluated on the packets built by the traversal even
+        // though their pixels were not iterated together.
+        for (unsigned id = 0u ; id < packets.size() ; ++id) {
+          simd::Counters t = simd::Counters{};
+
+          for (unsigned lane = 0u ; lane < simd::Width ; ++lane) {
+            t[lane] = (masks[id][lane] != 0 ? terms[packets[id][lane]] : 0u);
+          }
+
+          simd::accumulateSpread(t, masks[id], stats);
+        }
+      }
+
+      /**
+       * @brief - Processes all the pixels of the input for the Mandelbrot series
+       *          with the exponent `N`. The pixels are processed in packets when
+       *          the scalar type allows it and one by one otherwise.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param params - the parameters of the series.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param lens - output array receiving the squared modulus of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <unsigned N, typename Scalar, typename Input>
+      void
+      mandelbrotSeries(const Input& input,
+                       const EscapeTimeParams& params,
+                       unsigned* terms,
+                       float* lens,
+                       RenderingStatistics& stats) noexcept
+      {
+        // The points belonging to the set would iterate until reaching the
+        // accuracy (or at least the overshoot).
+        const unsigned interior = params.accuracy > params.overshoot ? params.accuracy : params.overshoot;
+
+        if constexpr (!simd::isPacked<Scalar>) {
+          const Scalar zero = static_cast<Scalar>(0);
+
+          simd::forEachPixel(
+            input,
+            [&](const Scalar& cr,
+                const Scalar& ci,
+                unsigned offset)
+            {
+              unsigned t;
+              float len = 0.0f;
+              bool periodic = false;
+
+              bool inside = false;
+              if constexpr (N == 2u) {
+                inside = insideMainBulbs(cr, ci);
+              }
+
+              t = 0u;
+              if (!inside) {
+                iterate<N>(zero, zero, cr, ci, params, t, len, periodic);
+              }
+              finalize(inside || periodic, interior, t, stats);
+
+              terms[offset] = t;
+              lens[offset] = len;
+            }
+          );
+        }
+        else {
+          using Values = simd::Packet<Scalar>;
+          const Scalar zero = static_cast<Scalar>(0);
+
+          auto step = [](const Values& zr, const Values& zi, Values& pr, Values& pi) {
+            power<N>(zr, zi, pr, pi);
+          };
+
+          // The shape of the interior is only known for the quadratic series.
+          auto inside = [](const Values& cr, const Values& ci) {
+            if constexpr (N == 2u) {
+              return insideMainBulbs(cr, ci);
+            }
+            else {
+              return simd::Mask{};
+            }
+          };
+
+          if (params.chunked) {
+            packetSeries<getChunkSize()>(input, false, zero, zero, params, inside, step, terms, lens, stats);
+          }
+          else {
+            packetSeries<0u>(input, false, zero, zero, params, inside, step, terms, lens, stats);
+          }
+        }
+      }
+
+      /**
+       * @brief - Selects the version of the Mandelbrot kernel specialized for the
+       *          input exponent and uses it to process the input pixels.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param exponent - the exponent of the series.
+       * @param params - the parameters of the series.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param lens - output array receiving the squared modulus of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Scalar, typename Input>
+      void
+      mandelbrotSeries(const Input& input,
+                       unsigned exponent,
+                       const EscapeTimeParams& params,
+                       unsigned* terms,
+                       float* lens,
+                       RenderingStatistics& stats) noexcept
+      {
+        switch (exponent) {
+          case 3u:
+            mandelbrotSeries<3u, Scalar>(input, params, terms, lens, stats);
+            break;
+          case 4u:
+            mandelbrotSeries<4u, Scalar>(input, params, terms, lens, stats);
+            break;
+          case 5u:
+            mandelbrotSeries<5u, Scalar>(input, params, terms, lens, stats);
+            break;
+          case 6u:
+            mandelbrotSeries<6u, Scalar>(input, params, terms, lens, stats);
+            break;
+          case 7u:
+            mandelbrotSeries<7u, Scalar>(input, params, terms, lens, stats);
+            break;
+          case 8u:
+            mandelbrotSeries<8u, Scalar>(input, params, terms, lens, stats);
+            break;
+          case 2u:
+          default:
+            mandelbrotSeries<2u, Scalar>(input, params, terms, lens, stats);
+            break;
+        }
+      }
+
+      /**
+       * @brief - Processes all the pixels of the input for the Mandelbrot series
+       *          with an arbitrary exponent, using the polar form of the terms to
+       *          compute their power. Only single precision is supported as the
+       *          approximations of the elementary functions are not accurate enough
+       *          for the other scalar types.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param exponent - the exponent of the series.
+       * @param params - the parameters of the series.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param lens - output array receiving the squared modulus of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Input>
+      void
+      multibrotSeries(const Input& input,
+                      float exponent,
+                      const EscapeTimeParams& params,
+                      unsigned* terms,
+                      float* lens,
+                      RenderingStatistics& stats) noexcept
+      {
+        auto step = [exponent](const simd::Floats& zr, const simd::Floats& zi, simd::Floats& pr, simd::Floats& pi) {
+          power(zr, zi, exponent, pr, pi);
+        };
+
+        auto inside = [](const simd::Floats& /*cr*/, const simd::Floats& /*ci*/) {
+          return simd::Mask{};
+        };
+
+        // Computing the power dominates the cost of the iterations: checking the
+        // status of the lanes at each iteration is cheaper than the work wasted
+        // when rolling back chunks.
+        packetSeries<0u>(input, false, 0.0f, 0.0f, params, inside, step, terms, lens, stats);
+      }
+
+      /**
+       * @brief - Processes all the pixels of the input for the Julia series with
+       *          the constant `(cx, cy)`.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param cx - the real part of the constant of the Julia set.
+       * @param cy - the imaginary part of the constant of the Julia set.
+       * @param params - the parameters of the series.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param lens - output array receiving the squared modulus of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Scalar, typename Input>
+      void
+      juliaSeries(const Input& input,
+                  float cx,
+                  float cy,
+                  const EscapeTimeParams& params,
+                  unsigned* terms,
+                  float* lens,
+                  RenderingStatistics& stats) noexcept
+      {
+        const unsigned interior = params.accuracy > params.overshoot ? params.accuracy : params.overshoot;
+
+        if constexpr (!simd::isPacked<Scalar>) {
+          const Scalar cr = static_cast<Scalar>(cx);
+          const Scalar ci = static_cast<Scalar>(cy);
+
+          simd::forEachPixel(
+            input,
+            [&](const Scalar& zr,
+                const Scalar& zi,
+                unsigned offset)
+            {
+              unsigned t;
+              float len;
+              bool periodic;
+
+              iterate<2u>(zr, zi, cr, ci, params, t, len, periodic);
+              finalize(periodic, interior, t, stats);
+
+              terms[offset] = t;
+              lens[offset] = len;
+            }
+          );
+        }
+        else {
+          using Values = simd::Packet<Scalar>;
+
+          auto step = [](const Values& zr, const Values& zi, Values& pr, Values& pi) {
+            power<2u>(zr, zi, pr, pi);
+          };
+
+          auto inside = [](const Values& /*zr*/, const Values& /*zi*/) {
+            return simd::Mask{};
+          };
+
+          const Scalar kr = static_cast<Scalar>(cx);
+          const Scalar ki = static_cast<Scalar>(cy);
+
+          if (params.chunked) {
+            packetSeries<getChunkSize()>(input, true, kr, ki, params, inside, step, terms, lens, stats);
+          }
+          else {
+            packetSeries<0u>(input, true, kr, ki, params, inside, step, terms, lens, stats);
+          }
+        }
+      }
+
+    }
+
+    bool
+    supportsExponent(float exponent) noexcept {
+      return exponent >= 2.0f && exponent <= 8.0f && std::floor(exponent) == exponent;
+    }
+
+    bool
+    supportsPolarExponent(float exponent) noexcept {
+      // The angle of the power is at most `pi * exponent`: the bound keeps it
+      // well within the range where `sincos` is accurate.
+      return exponent > 0.0f && exponent <= 256.0f;
+    }
+
+    void
+    multibrot(const PixelBlock<float>& block,
+              float exponent,
+              const EscapeTimeParams& params,
+              unsigned* terms,
+              float* lens,
+              RenderingStatistics& stats) noexcept
+    {
+      multibrotSeries(block, exponent, params, terms, lens, stats);
+    }
+
+    void
+    multibrot(const PointList<float>& points,
+              float exponent,
+              const EscapeTimeParams& params,
+              unsigned* terms,
+              float* lens,
+              RenderingStatistics& stats) noexcept
+    {
+      multibrotSeries(points, exponent, params, terms, lens, stats);
+    }
+
+    template <typename Scalar>
+    void
+    mandelbrot(const PixelBlock<Scalar>& block,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept
+    {
+      // Select the specialized version of the kernel once for the whole block.
+      mandelbrotSeries<Scalar>(block, exponent, params, terms, lens, stats);
+    }
+
+    template <typename Scalar>
+    void
+    mandelbrot(const PointList<Scalar>& points,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept
+    {
+      mandelbrotSeries<Scalar>(points, exponent, params, terms, lens, stats);
+    }
+
+    template <typename Scalar>
+    void
+    julia(const PixelBlock<Scalar>& block,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept
+    {
+      juliaSeries<Scalar>(block, cx, cy, params, terms, lens, stats);
+    }
+
+    template <typename Scalar>
+    void
+    julia(const PointList<Scalar>& points,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept
+    {
+      juliaSeries<Scalar>(points, cx, cy, params, terms, lens, stats);
+    }
+
+    // Instantiate the kernels for all the supported scalar types.
+    template void mandelbrot<float>(const PixelBlock<float>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<double>(const PixelBlock<double>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<long double>(const PixelBlock<long double>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<scalar::DoubleDouble>(const PixelBlock<scalar::DoubleDouble>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# ifdef __SIZEOF_FLOAT128__
+    template void mandelbrot<scalar::Quad>(const PixelBlock<scalar::Quad>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# endif
+    template void mandelbrot<scalar::Fixed128>(const PixelBlock<scalar::Fixed128>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<scalar::Fixed192>(const PixelBlock<scalar::Fixed192>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+
+    template void mandelbrot<float>(const PointList<float>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<double>(const PointList<double>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<long double>(const PointList<long double>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<scalar::DoubleDouble>(const PointList<scalar::DoubleDouble>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# ifdef __SIZEOF_FLOAT128__
+    template void mandelbrot<scalar::Quad>(const PointList<scalar::Quad>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# endif
+    template void mandelbrot<scalar::Fixed128>(const PointList<scalar::Fixed128>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<scalar::Fixed192>(const PointList<scalar::Fixed192>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+
+    template void julia<float>(const PixelBlock<float>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<double>(const PixelBlock<double>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<long double>(const PixelBlock<long double>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<scalar::DoubleDouble>(const PixelBlock<scalar::DoubleDouble>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# ifdef __SIZEOF_FLOAT128__
+    template void julia<scalar::Quad>(const PixelBlock<scalar::Quad>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# endif
+    template void julia<scalar::Fixed128>(const PixelBlock<scalar::Fixed128>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<scalar::Fixed192>(const PixelBlock<scalar::Fixed192>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+
+    template void julia<float>(const PointList<float>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<double>(const PointList<double>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<long double>(const PointList<long double>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<scalar::DoubleDouble>(const PointList<scalar::DoubleDouble>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# ifdef __SIZEOF_FLOAT128__
+    template void julia<scalar::Quad>(const PointList<scalar::Quad>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# endif
+    template void julia<scalar::Fixed128>(const PointList<scalar::Fixed128>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<scalar::Fixed192>(const PointList<scalar::Fixed192>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+
+  }
+}
@@ -0,0 +1,242 @@
+#ifndef    ESCAPE_TIME_KERNEL_HH
+# define   ESCAPE_TIME_KERNEL_HH
+
+# include "PixelBlock.hh"
+# include "KernelDispatch.hh"
+# include "RenderingStatistics.hh"
+
+namespace fractsim {
+  namespace kernels {
+
+    /**
+     * @brief - Convenience structure regrouping the values controlling the iterations
+     *          of an escape-time series. These are the same values as the ones used by
+     *          the scalar computations of the fractal options.
+     *          The `periodicity` describes the squared distance below which two terms
+     *          of the series are considered equal when looking for periodic orbits: a
+     *          null value disables the detection. It should be scaled with the size
+     *          of the pixels so that it stays meaningful at deep zooms, which is why
+     *          it is kept (and compared) in double precision.
+     *          The `refill` flag selects how the packets are scheduled: when set the
+     *          pixels are streamed through the lanes of the vector units, each lane
+     *          picking up a new pixel as soon as the series of its current one ends.
+     *          Otherwise each packet is iterated until all its lanes are done. Both
+     *          produce the same results: refilling keeps the lanes busy when the
+     *          number of terms varies a lot between neighbouring pixels, at the
+     *          cost of some bookkeeping each time a lane is refilled.
+     *          The `chunked` flag selects how often the packet kernels check the
+     *          status of their lanes: when set they speculatively run chunks of
+     *          iterations and roll back the ones where a lane stopped, otherwise
+     *          the lanes are checked after each iteration. Both produce the same
+     *          results as well.
+     */
+    struct EscapeTimeParams {
+      unsigned accuracy;
+      unsigned overshoot;
+      float threshold;
+      double periodicity;
+      bool refill;
+      bool chunked;
+    };
+
+  }
+
+  // The kernels are defined in the namespace of the variant they belong to, see
+  // `KernelDispatch.hh` for more details.
+  namespace kernels::inline FRACTSIM_KERNELS_VARIANT {
+
+    /**
+     * @brief - Used to determine whether the input exponent can be handled by the
+     *          `mandelbrot` kernel. Only integer exponents in the range `[2; 8]` are
+     *          supported as each one of them has its own specialized version.
+     * @param exponent - the exponent of the Mandelbrot series.
+     * @return - `true` if the kernel can be used for this exponent.
+     */
+    bool
+    supportsExponent(float exponent) noexcept;
+
+    /**
+     * @brief - Used to determine whether the input exponent can be handled by the
+     *          `multibrot` kernel. Any strictly positive exponent up to `256` is
+     *          supported, though the integer exponents in `[2; 8]` are better served
+     *          by `mandelbrot` which is both faster and exact.
+     * @param exponent - the exponent of the Mandelbrot series.
+     * @return - `true` if the kernel can be used for this exponent.
+     */
+    bool
+    supportsPolarExponent(float exponent) noexcept;
+
+    /**
+     * @brief - Iterates the Mandelbrot series `z(n+1) = z(n)^exponent + c` for each
+     *          pixel of a block, where the exponent can be any real value. Just like
+     *          for `mandelbrot` the pixels are processed in packets and follow the
+     *          same termination conditions as the scalar path.
+     *          The power of each term is computed from its polar form with vector-
+     *          ized approximations of `log`, `exp`, `atan2` and `sincos`. The error
+     *          contract is the following: the relative error of `z^exponent` is at
+     *          most `2^-23 * exponent * (|log(|z|)| + pi)`, which is the same bound
+     *          as the one of `std::pow` applied on single precision values. The
+     *          resulting values thus only differ from the scalar path by rounding
+     *          errors, which may change the number of terms of the pixels lying
+     *          close to the boundary of the set.
+     *          Only single precision is supported: deeper zooms still rely on the
+     *          scalar path.
+     * @param block - the block of pixels to process.
+     * @param exponent - the exponent of the series. Should be supported according
+     *                   to `supportsPolarExponent`.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the block.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the block.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    multibrot(const PixelBlock<float>& block,
+              float exponent,
+              const EscapeTimeParams& params,
+              unsigned* terms,
+              float* lens,
+              RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Similar to the above method but processes an arbitrary list of
+     *          pixels instead of a block.
+     * @param points - the list of pixels to process.
+     * @param exponent - the exponent of the series. Should be supported according
+     *                   to `supportsPolarExponent`.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the list.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the list.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    multibrot(const PointList<float>& points,
+              float exponent,
+              const EscapeTimeParams& params,
+              unsigned* terms,
+              float* lens,
+              RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Iterates the Mandelbrot series `z(n+1) = z(n)^exponent + c` for each
+     *          pixel of a block. The pixels are processed in packets so that all the
+     *          lanes of the vector units are used, each lane being either disabled
+     *          or refilled with a new pixel as soon as its series ends (see the
+     *          `refill` flag of the parameters).
+     *          The power is computed through repeated complex multiplications in a
+     *          version of the kernel specialized for each exponent: the selection
+     *          of the version happens once for the whole block.
+     *          The termination condition (including the overshoot used by the
+     *          smoothing) is strictly identical to the one of the scalar path.
+     *          This method does not apply any smoothing: it only produces the
+     *          raw data needed to compute it.
+     *          When enabled in the parameters, the orbit of each pixel is checked
+     *          for periodicity using Brent's method: a term of the series is saved
+     *          at each power of two iterations and compared to the following ones.
+     *          Pixels revisiting the saved term are declared part of the set as if
+     *          they reached the accuracy.
+     *          The kernel is instantiated for `float`, `double`, `long double` and
+     *          the quadruple precision type: the first two are processed in packets
+     *          while the others iterate the pixels one by one.
+     * @param block - the block of pixels to process.
+     * @param exponent - the exponent of the series. Should be supported according
+     *                   to `supportsExponent`.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the block.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the block.
+     * @param stats - output statistics updated with the work performed.
+     */
+    template <typename Scalar>
+    void
+    mandelbrot(const PixelBlock<Scalar>& block,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Similar to the above method but processes an arbitrary list of
+     *          pixels instead of a block. This allows to compute sparse sets of
+     *          pixels while still filling all the lanes of the vector units.
+     * @param points - the list of pixels to process.
+     * @param exponent - the exponent of the series. Should be supported according
+     *                   to `supportsExponent`.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the list.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the list.
+     * @param stats - output statistics updated with the work performed.
+     */
+    template <typename Scalar>
+    void
+    mandelbrot(const PointList<Scalar>& points,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Similar to `mandelbrot` but iterates the series of a Julia set, where
+     *          each pixel defines the first term of the series and the constant is
+     *          shared by all the pixels.
+     * @param block - the block of pixels to process.
+     * @param cx - the real part of the constant of the Julia set.
+     * @param cy - the imaginary part of the constant of the Julia set.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the block.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the block.
+     * @param stats - output statistics updated with the work performed.
+     */
+    template <typename Scalar>
+    void
+    julia(const PixelBlock<Scalar>& block,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Similar to the above method but processes an arbitrary list of
+     *          pixels instead of a block.
+     * @param points - the list of pixels to process.
+     * @param cx - the real part of the constant of the Julia set.
+     * @param cy - the imaginary part of the constant of the Julia set.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the list.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the list.
+     * @param stats - output statistics updated with the work performed.
+     */
+    template <typename Scalar>
+    void
+    julia(const PointList<Scalar>& points,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept;
+
+  }
+}
+
+#endif    /* ESCAPE_TIME_KERNEL_HH */
@@ -0,0 +1,194 @@
+#ifndef    FIXED_POINT_HH
+# define   FIXED_POINT_HH
+
+# include <cstdint>
+# include <type_traits>
+
+namespace fractsim {
+  namespace fixed {
+
+    /**
+     * @brief - The integer type used to hold the product of two limbs. It is an
+     *          extension of the compiler, hence the annotation which silences the
+     *          pedantic warnings.
+     */
+    __extension__ typedef unsigned __int128 Product;
+
+    /**
+     * @brief - Describes a value with a fixed number of fractional bits stored in
+     *          `Limbs` 64-bit integers. The limbs hold the two's complement of the
+     *          value scaled by `2^getFractionalBits()`, the first limb being the
+     *          least significant one. The most significant bits hold the sign and
+     *          the integral part, which is enough for the terms of the escape time
+     *          series before they diverge.
+     *          Unlike floating point values the resolution is absolute: all the
+     *          values are known up to `2^-getFractionalBits()`. This is well suited
+     *          to the fractals as the interesting points all lie close to the origin
+     *          and the operations only rely on integer arithmetic: the products use
+     *          the 128-bit multiplications of the hardware, which is much faster
+     *          than the software emulation of the quadruple precision or gmp.
+     *          Overflows are not detected: the kernels should make sure the values
+     *          stay in range.
+     */
+    template <unsigned Limbs>
+    struct Number {
+      static_assert(Limbs >= 2u, "Fixed point values need at least two limbs");
+
+      std::uint64_t limbs[Limbs];
+
+      /**
+       * @brief - Creates an uninitialized value.
+       */
+      Number() = default;
+
+      /**
+       * @brief - Creates a value from a scalar of any type providing a conversion
+       *          to double precision. The input is split into as many doubles as
+       *          needed to fill all the fractional bits.
+       * @param value - the value to convert.
+       */
+      template <typename U>
+      explicit
+      Number(const U& value) noexcept;
+
+      /**
+       * @brief - Converts this value to a floating point type. The conversion is
+       *          performed in at least double precision so that the smallest bits
+       *          do not underflow.
+       * @return - the converted value.
+       */
+      template <typename U>
+      explicit
+      operator U() const noexcept;
+
+      Number&
+      operator+=(const Number& rhs) noexcept;
+
+      Number&
+      operator-=(const Number& rhs) noexcept;
+
+      Number&
+      operator*=(const Number& rhs) noexcept;
+
+      /**
+       * @brief - Used to determine whether this value is strictly negative.
+       * @return - `true` if this value is negative.
+       */
+      bool
+      isNegative() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the number of bits dedicated to the fractional
+       *          part of the values. The remaining bits hold the sign and integral
+       *          part, which allows values in the range `]-32768; 32768[`.
+       * @return - the number of fractional bits.
+       */
+      static
+      unsigned
+      getFractionalBits() noexcept;
+
+      /**
+       * @brief - Creates a value from a double precision value. The bits of the
+       *          input below the resolution of the fixed point values are dropped.
+       * @param value - the value to convert.
+       * @return - the fixed point value.
+       */
+      static
+      Number
+      fromDouble(double value) noexcept;
+    };
+
+    /**
+     * @brief - Indicates whether the type `T` is a fixed point value.
+     */
+    template <typename T>
+    struct IsNumber: std::false_type {};
+
+    template <unsigned Limbs>
+    struct IsNumber<Number<Limbs>>: std::true_type {};
+
+    template <typename T>
+    constexpr bool isNumber = IsNumber<T>::value;
+
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator-(const Number<Limbs>& value) noexcept;
+
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator+(const Number<Limbs>& lhs,
+              const Number<Limbs>& rhs) noexcept;
+
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator+(const Number<Limbs>& lhs,
+              double rhs) noexcept;
+
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator+(double lhs,
+              const Number<Limbs>& rhs) noexcept;
+
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator-(const Number<Limbs>& lhs,
+              const Number<Limbs>& rhs) noexcept;
+
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator-(const Number<Limbs>& lhs,
+              double rhs) noexcept;
+
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator-(double lhs,
+              const Number<Limbs>& rhs) noexcept;
+
+    /**
+     * @brief - Computes the product of two values. The two's complement values
+     *          are multiplied limb by limb and corrected for the negative operands:
+     *          the exact product is then rounded to the nearest value, so that it
+     *          is known up to half the resolution of the fixed point values.
+     * @param lhs - the first operand.
+     * @param rhs - the second operand.
+     * @return - the product of both values.
+     */
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator*(const Number<Limbs>& lhs,
+              const Number<Limbs>& rhs) noexcept;
+
+    /**
+     * @brief - Computes the product of a value with a double. The kernels mostly
+     *          multiply by small integers (typically when computing the imaginary
+     *          part of a square) which is handled without converting the operand.
+     * @param lhs - the fixed point operand.
+     * @param rhs - the double precision operand.
+     * @return - the product of both values.
+     */
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator*(const Number<Limbs>& lhs,
+              double rhs) noexcept;
+
+    template <unsigned Limbs>
+    Number<Limbs>
+    operator*(double lhs,
+              const Number<Limbs>& rhs) noexcept;
+
+    template <unsigned Limbs>
+    bool
+    operator<(const Number<Limbs>& lhs,
+              const Number<Limbs>& rhs) noexcept;
+
+    template <unsigned Limbs>
+    bool
+    operator<(const Number<Limbs>& lhs,
+              double rhs) noexcept;
+
+  }
+}
+
+# include "FixedPoint.hxx"
+
+#endif    /* FIXED_POINT_HH */
@@ -0,0 +1,366 @@
+#ifndef    FIXED_POINT_HXX
+# define   FIXED_POINT_HXX
+
+# include "FixedPoint.hh"
+# include <cmath>
+
+namespace fractsim {
+  namespace fixed {
+
+    template <unsigned Limbs>
+    template <typename U>
+    inline
+    Number<Limbs>::Number(const U& value) noexcept:
+      limbs()
+    {
+      // Each double only holds 53 bits of the input: the remainder of the
+      // conversion is converted again until all the limbs are filled.
+      U remainder = value;
+
+      for (unsigned id = 0u ; id <= Limbs ; ++id) {
+        double part = static_cast<double>(remainder);
+        if (part == 0.0) {
+          break;
+        }
+
+        *this += fromDouble(part);
+        remainder = remainder - static_cast<U>(part);
+      }
+    }
+
+    template <unsigned Limbs>
+    template <typename U>
+    inline
+    Number<Limbs>::operator U() const noexcept {
+      using Accumulator = std::conditional_t<(sizeof(U) < sizeof(double)), double, U>;
+
+      Number magnitude = isNegative() ? -*this : *this;
+
+      // Scaling by a power of two is exact: the only rounding errors come
+      // from the accumulation of the limbs.
+      const Accumulator radix = static_cast<Accumulator>(18446744073709551616.0);
+      const Accumulator scale = static_cast<Accumulator>(std::ldexp(1.0, -static_cast<int>(getFractionalBits())));
+
+      Accumulator out = static_cast<Accumulator>(0);
+      for (unsigned id = Limbs ; id > 0u ; --id) {
+        out = out * radix + static_cast<Accumulator>(magnitude.limbs[id - 1u]);
+      }
+
+      out = out * scale;
+
+      return static_cast<U>(isNegative() ? -out : out);
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>&
+    Number<Limbs>::operator+=(const Number& rhs) noexcept {
+      Product carry = 0u;
+
+      for (unsigned id = 0u ; id < Limbs ; ++id) {
+        Product sum = static_cast<Product>(limbs[id]) + rhs.limbs[id] + carry;
+
+        limbs[id] = static_cast<std::uint64_t>(sum);
+        carry = sum >> 64u;
+      }
+
+      return *this;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>&
+    Number<Limbs>::operator-=(const Number& rhs) noexcept {
+      std::uint64_t borrow = 0u;
+
+      for (unsigned id = 0u ; id < Limbs ; ++id) {
+        // In case the subtraction wraps around, the high part of the result
+        // is filled with ones.
+        Product diff = static_cast<Product>(limbs[id]) - rhs.limbs[id] - borrow;
+
+        limbs[id] = static_cast<std::uint64_t>(diff);
+        borrow = static_cast<std::uint64_t>(diff >> 64u) & 1u;
+      }
+
+      return *this;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>&
+    Number<Limbs>::operator*=(const Number& rhs) noexcept {
+      *this = *this * rhs;
+      return *this;
+    }
+
+    template <unsigned Limbs>
+    inline
+    bool
+    Number<Limbs>::isNegative() const noexcept {
+      return static_cast<std::int64_t>(limbs[Limbs - 1u]) < 0;
+    }
+
+    template <unsigned Limbs>
+    inline
+    unsigned
+    Number<Limbs>::getFractionalBits() noexcept {
+      return 64u * Limbs - 16u;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    Number<Limbs>::fromDouble(double value) noexcept {
+      Number out;
+      for (unsigned id = 0u ; id < Limbs ; ++id) {
+        out.limbs[id] = 0u;
+      }
+
+      if (value == 0.0 || !std::isfinite(value)) {
+        return out;
+      }
+
+      // Retrieve the mantissa as an integer along with the position of its
+      // least significant bit in the fixed point representation.
+      int exp = 0;
+      double m = std::frexp(std::abs(value), &exp);
+
+      std::uint64_t mantissa = static_cast<std::uint64_t>(std::ldexp(m, 53));
+      int shift = exp - 53 + static_cast<int>(getFractionalBits());
+
+      if (shift < 0) {
+        if (shift <= -64) {
+          return out;
+        }
+
+        mantissa >>= -shift;
+        shift = 0;
+      }
+
+      unsigned limb = static_cast<unsigned>(shift) / 64u;
+      unsigned bit = static_cast<unsigned>(shift) % 64u;
+
+      if (limb < Limbs) {
+        out.limbs[limb] = mantissa << bit;
+      }
+      if (bit > 0u && limb + 1u < Limbs) {
+        out.limbs[limb + 1u] = mantissa >> (64u - bit);
+      }
+
+      return value < 0.0 ? -out : out;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator-(const Number<Limbs>& value) noexcept {
+      // Two's complement: invert all the bits and add one.
+      Number<Limbs> out;
+      Product carry = 1u;
+
+      for (unsigned id = 0u ; id < Limbs ; ++id) {
+        Product sum = static_cast<Product>(~value.limbs[id]) + carry;
+
+        out.limbs[id] = static_cast<std::uint64_t>(sum);
+        carry = sum >> 64u;
+      }
+
+      return out;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator+(const Number<Limbs>& lhs,
+              const Number<Limbs>& rhs) noexcept
+    {
+      Number<Limbs> out(lhs);
+      out += rhs;
+
+      return out;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator+(const Number<Limbs>& lhs,
+              double rhs) noexcept
+    {
+      return lhs + Number<Limbs>::fromDouble(rhs);
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator+(double lhs,
+              const Number<Limbs>& rhs) noexcept
+    {
+      return rhs + lhs;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator-(const Number<Limbs>& lhs,
+              const Number<Limbs>& rhs) noexcept
+    {
+      Number<Limbs> out(lhs);
+      out -= rhs;
+
+      return out;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator-(const Number<Limbs>& lhs,
+              double rhs) noexcept
+    {
+      return lhs - Number<Limbs>::fromDouble(rhs);
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator-(double lhs,
+              const Number<Limbs>& rhs) noexcept
+    {
+      return Number<Limbs>::fromDouble(lhs) - rhs;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator*(const Number<Limbs>& lhs,
+              const Number<Limbs>& rhs) noexcept
+    {
+      // Schoolbook multiplication of the limbs seen as unsigned integers: each
+      // partial product along with the carries fits in a 128-bit integer.
+      std::uint64_t p[2u * Limbs] = {};
+
+      for (unsigned i = 0u ; i < Limbs ; ++i) {
+        Product carry = 0u;
+
+        for (unsigned j = 0u ; j < Limbs ; ++j) {
+          Product t = static_cast<Product>(lhs.limbs[i]) * rhs.limbs[j] + p[i + j] + carry;
+
+          p[i + j] = static_cast<std::uint64_t>(t);
+          carry = t >> 64u;
+        }
+
+        p[i + Limbs] = static_cast<std::uint64_t>(carry);
+      }
+
+      // A negative operand is seen as its value plus `2^(64 * Limbs)`: the
+      // other operand is subtracted from the upper half to account for it.
+      auto correct = [&p](const Number<Limbs>& value) {
+        std::uint64_t borrow = 0u;
+
+        for (unsigned id = 0u ; id < Limbs ; ++id) {
+          Product diff = static_cast<Product>(p[Limbs + id]) - value.limbs[id] - borrow;
+
+          p[Limbs + id] = static_cast<std::uint64_t>(diff);
+          borrow = static_cast<std::uint64_t>(diff >> 64u) & 1u;
+        }
+      };
+
+      if (lhs.isNegative()) {
+        correct(rhs);
+      }
+      if (rhs.isNegative()) {
+        correct(lhs);
+      }
+
+      // The product has twice as many fractional bits as the operands: only
+      // the upper part is kept, rounded to the nearest value.
+      const unsigned first = Number<Limbs>::getFractionalBits() / 64u;
+      const unsigned shift = Number<Limbs>::getFractionalBits() % 64u;
+
+      Product carry = static_cast<Product>(p[first]) + (std::uint64_t(1u) << (shift - 1u));
+      p[first] = static_cast<std::uint64_t>(carry);
+      carry >>= 64u;
+
+      for (unsigned id = first + 1u ; id < 2u * Limbs ; ++id) {
+        carry += p[id];
+        p[id] = static_cast<std::uint64_t>(carry);
+        carry >>= 64u;
+      }
+
+      Number<Limbs> out;
+      for (unsigned id = 0u ; id < Limbs ; ++id) {
+        out.limbs[id] = (p[first + id] >> shift) | (p[first + id + 1u] << (64u - shift));
+      }
+
+      return out;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator*(const Number<Limbs>& lhs,
+              double rhs) noexcept
+    {
+      if (std::abs(rhs) >= 4294967296.0 || std::trunc(rhs) != rhs) {
+        return lhs * Number<Limbs>::fromDouble(rhs);
+      }
+
+      // The two's complement representation can directly be multiplied by an
+      // integer, the sign of the factor being applied afterwards.
+      const std::uint64_t factor = static_cast<std::uint64_t>(std::abs(rhs));
+
+      Number<Limbs> out;
+      Product carry = 0u;
+
+      for (unsigned id = 0u ; id < Limbs ; ++id) {
+        Product t = static_cast<Product>(lhs.limbs[id]) * factor + carry;
+
+        out.limbs[id] = static_cast<std::uint64_t>(t);
+        carry = t >> 64u;
+      }
+
+      return rhs < 0.0 ? -out : out;
+    }
+
+    template <unsigned Limbs>
+    inline
+    Number<Limbs>
+    operator*(double lhs,
+              const Number<Limbs>& rhs) noexcept
+    {
+      return rhs * lhs;
+    }
+
+    template <unsigned Limbs>
+    inline
+    bool
+    operator<(const Number<Limbs>& lhs,
+              const Number<Limbs>& rhs) noexcept
+    {
+      // The sign is held by the most significant limb: the other ones are
+      // compared as unsigned values.
+      if (lhs.limbs[Limbs - 1u] != rhs.limbs[Limbs - 1u]) {
+        return static_cast<std::int64_t>(lhs.limbs[Limbs - 1u]) < static_cast<std::int64_t>(rhs.limbs[Limbs - 1u]);
+      }
+
+      for (unsigned id = Limbs - 1u ; id > 0u ; --id) {
+        if (lhs.limbs[id - 1u] != rhs.limbs[id - 1u]) {
+          return lhs.limbs[id - 1u] < rhs.limbs[id - 1u];
+        }
+      }
+
+      return false;
+    }
+
+    template <unsigned Limbs>
+    inline
+    bool
+    operator<(const Number<Limbs>& lhs,
+              double rhs) noexcept
+    {
+      return lhs < Number<Limbs>::fromDouble(rhs);
+    }
+
+  }
+}
+
+#endif    /* FIXED_POINT_HXX */
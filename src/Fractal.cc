@@ -4,16 +4,18 @@
 namespace fractsim {
 
   Fractal::Fractal(const utils::Sizef& canvas,
-                   const utils::Boxf& area):
+                   const GMPBox& area):
     utils::CoreObject(std::string("fractal_proxy")),
 
     m_propsLocker(),
 
     m_canvas(),
     m_area(),
+    m_anchor(std::make_shared<GMPVector2>()),
 
-    m_zoomLevel(),
-    m_renderedArea(),
+    m_scale(),
+    m_renderedXMin(),
+    m_renderedYMin(),
     m_tilesCount(),
     m_tiles()
   {
@@ -24,7 +26,10 @@ namespace fractsim {
   }
 
   std::vector<RenderingTileShPtr>
-  Fractal::generateRenderingTiles(FractalOptionsShPtr opt) {
+  Fractal::generateRenderingTiles(FractalOptionsShPtr opt,
+                                  const tile::Strategy& strategy,
+                                  const kernels::Traversal& traversal)
+  {
     // In order to render the fractal, we need to perform some computations. In order
     // to speed things up we divide the workload into small tiles representing some
     // portion of the total area.
@@ -53,25 +58,34 @@ namespace fractsim {
 
     // Check whether some cache is available.
     if (m_tiles.empty()) {
-      return generateDefaultTiling(opt);
+      return generateDefaultTiling(opt, strategy, traversal);
     }
 
     // We already have some cache available. We we have to do is to determine the
     // size of a tile, and add some until all four corners of the new rendering area
-    // fit in the `m_renderedArea`.
+    // fit in the rendered area.
+    utils::Sizef dims = m_area.toSize(m_scale);
     utils::Sizef tileDims(
-      m_area.w() / getHorizontalTileCount(),
-      m_area.h() / getVerticalTileCount()
+      dims.w() / getHorizontalTileCount(),
+      dims.h() / getVerticalTileCount()
     );
 
     // We need to compute how many tiles we need to add along each direction.
     // This can be computed by determining the distance from the boundary of
     // the rendered area to the boundary of the requested area and dividing
     // this distance by the size of a tile.
-    float toLeft = m_renderedArea.getLeftBound() - m_area.getLeftBound();
-    float toRight = m_area.getRightBound() - m_renderedArea.getRightBound();
-    float toBottom = m_renderedArea.getBottomBound() - m_area.getBottomBound();
-    float toTop = m_area.getTopBound() - m_renderedArea.getTopBound();
+    // The bounds are expressed relatively to the anchor of the tiles so that
+    // they can still be distinguished at deep zoom levels.
+    double left = getLeftBound();
+    double bottom = getBottomBound();
+
+    double renderedRight = m_renderedXMin + m_tilesCount.x() * static_cast<double>(tileDims.w());
+    double renderedTop = m_renderedYMin + m_tilesCount.y() * static_cast<double>(tileDims.h());
+
+    float toLeft = static_cast<float>(m_renderedXMin - left);
+    float toRight = static_cast<float>(left + dims.w() - renderedRight);
+    float toBottom = static_cast<float>(m_renderedYMin - bottom);
+    float toTop = static_cast<float>(bottom + dims.h() - renderedTop);
 
     int tilesToTheLeft = toLeft < 0.0f ? 0u : static_cast<int>(std::ceil(toLeft / tileDims.w()));
     int tilesToTheRight = toRight < 0.0f ? 0u : static_cast<int>(std::ceil(toRight / tileDims.w()));
@@ -94,12 +108,8 @@ namespace fractsim {
 
     // Compute the expected rendered area: this is basically the current rendering area
     // with all the tiles that need to be added.
-    utils::Boxf expectedRendered(
-      m_renderedArea.x() + (tilesToTheRight - tilesToTheLeft) * tileDims.w() / 2.0f,
-      m_renderedArea.y() + (tilesToTheTop - tilesToTheBottom) * tileDims.h() / 2.0f,
-      xMax * tileDims.w(),
-      yMax * tileDims.h()
-    );
+    double xMin = m_renderedXMin - tilesToTheLeft * static_cast<double>(tileDims.w());
+    double yMin = m_renderedYMin - tilesToTheBottom * static_cast<double>(tileDims.h());
 
     for (int y = 0 ; y < yMax ; ++y) {
       for (int x = 0 ; x < xMax ; ++x) {
@@ -111,25 +121,34 @@ namespace fractsim {
         }
 
         // This is a new tile, add it to the tiling to render.
+        double tx = xMin + x * static_cast<double>(tileDims.w());
+        double ty = yMin + y * static_cast<double>(tileDims.h());
+
         tiles.push_back(
           std::make_shared<RenderingTile>(
-            utils::Boxf(
-              expectedRendered.getLeftBound() + 1.0f * x * tileDims.w() + tileDims.w() / 2.0f,
-              expectedRendered.getBottomBound() + 1.0f * y * tileDims.h() + tileDims.h() / 2.0f,
-              tileDims
-            ),
+            m_anchor,
+            tx,
+            ty,
+            tileDims,
             pixSize,
-            opt
+            m_scale,
+            opt,
+            strategy,
+            traversal,
+            selectPrecision(*opt, tx, ty, tileDims)
           )
         );
       }
     }
 
     // Update expected rendered area and tiles count.
-    m_renderedArea = expectedRendered;
+    m_renderedXMin = xMin;
+    m_renderedYMin = yMin;
     m_tilesCount.x() = xMax;
     m_tilesCount.y() = yMax;
 
+    logPrecisions(tiles);
+
     return tiles;
   }
 
@@ -168,13 +187,24 @@ namespace fractsim {
     std::vector<sdl::core::engine::Color> colors(iCanvasSize.area(), def);
 
     // Compute the sampling interval to render the output canvas.
-    utils::Sizef pixSize(
-      m_area.w() / m_canvas.w(),
-      m_area.h() / m_canvas.h()
-    );
+    utils::Sizef pixSize = getPixelSizePrivate();
+
+    // The tiles are looked up relatively to their bottom left corner: the
+    // offset of each tile to the rendering area is computed once from the
+    // anchor of the tiles so that the lookup stays accurate at deep zoom
+    // levels.
+    double xMin = getLeftBound();
+    double yMin = getBottomBound();
 
-    float xMin = m_area.getLeftBound();
-    float yMin = m_area.getBottomBound();
+    std::vector<double> xOffsets(m_tiles.size(), 0.0);
+    std::vector<double> yOffsets(m_tiles.size(), 0.0);
+
+    for (unsigned id = 0u ; id < m_tiles.size() ; ++id) {
+      getAnchorOffset(m_tiles[id]->getAnchor(), xOffsets[id], yOffsets[id]);
+
+      xOffsets[id] += m_tiles[id]->getXMin() - xMin;
+      yOffsets[id] += m_tiles[id]->getYMin() - yMin;
+    }
 
     // Populate the output canvas with data from the rendering tiles.
     for (int y = 0 ; y < iCanvasSize.h() ; ++y) {
@@ -185,19 +215,17 @@ namespace fractsim {
       unsigned offset = (iCanvasSize.h() - 1 - y) * iCanvasSize.w();
 
       for (int x = 0 ; x < iCanvasSize.w() ; ++x) {
-        // Compute the local coordinate of the point.
-        // Compute the point associated to this cell.
-        utils::Vector2f p(
-          xMin + x * pixSize.w(),
-          yMin + y * pixSize.h()
-        );
+        // Compute the coordinate of the point associated to this cell
+        // relatively to the rendering area.
+        double px = 1.0 * x * pixSize.w();
+        double py = 1.0 * y * pixSize.h();
 
         float totConf = 0.0f;
         unsigned count = 0u;
         bool in = true;
 
         for (unsigned id = 0u ; id < m_tiles.size() ; ++id) {
-          float confidence = m_tiles[id]->getConfidenceAt(p, in);
+          float confidence = m_tiles[id]->getConfidenceAt(px - xOffsets[id], py - yOffsets[id], in);
           if (in) {
             totConf += confidence;
             ++count;
@@ -226,30 +254,49 @@ namespace fractsim {
   }
 
   std::vector<RenderingTileShPtr>
-  Fractal::generateDefaultTiling(FractalOptionsShPtr opt) {
+  Fractal::generateDefaultTiling(FractalOptionsShPtr opt,
+                                 const tile::Strategy& strategy,
+                                 const kernels::Traversal& traversal)
+  {
     // We know that the `m_area` should be divided into a certain amount of tiles.
     // We also know the size of the canvas so we can estimate the pixel size.
     // Once this is done, we just divide the area into tiles and associate the right
     // part to each one.
+    utils::Sizef dims = m_area.toSize(m_scale);
     utils::Sizef tileDims(
-      m_area.w() / getHorizontalTileCount(),
-      m_area.h() / getVerticalTileCount()
+      dims.w() / getHorizontalTileCount(),
+      dims.h() / getVerticalTileCount()
     );
     utils::Sizef pixSize = getPixelSizePrivate();
 
+    // A new anchor is defined for this tiling: it is shared by all the tiles
+    // generated until the cache is reset.
+    m_anchor = std::make_shared<GMPVector2>(m_area.getPointAt(utils::Vector2f(-0.5f, -0.5f)));
+
+    double xMin = getLeftBound();
+    double yMin = getBottomBound();
+
     std::vector<RenderingTileShPtr> tiles;
 
     for (unsigned y = 0u ; y < getVerticalTileCount() ; ++y) {
       for (unsigned x = 0u ; x < getHorizontalTileCount() ; ++x) {
+        // Each tile uses the cheapest precision allowing to compute it
+        // accurately: this depends on its distance to the origin.
+        double tx = xMin + x * static_cast<double>(tileDims.w());
+        double ty = yMin + y * static_cast<double>(tileDims.h());
+
         tiles.push_back(
           std::make_shared<RenderingTile>(
-            utils::Boxf(
-              m_area.getLeftBound() + 1.0f * x * tileDims.w() + tileDims.w() / 2.0f,
-              m_area.getBottomBound() + 1.0f * y * tileDims.h() + tileDims.h() / 2.0f,
-              tileDims
-            ),
+            m_anchor,
+            tx,
+            ty,
+            tileDims,
             pixSize,
-            opt
+            m_scale,
+            opt,
+            strategy,
+            traversal,
+            selectPrecision(*opt, tx, ty, tileDims)
           )
         );
       }
@@ -257,10 +304,13 @@ namespace fractsim {
 
     // The rendered area corresponds to the entirety of the area. We can also assign
     // the dimensions of the tiling.
-    m_renderedArea = m_area;
+    m_renderedXMin = xMin;
+    m_renderedYMin = yMin;
     m_tilesCount.x() = getHorizontalTileCount();
     m_tilesCount.y() = getVerticalTileCount();
 
+    logPrecisions(tiles);
+
     return tiles;
   }
 
@@ -10,6 +10,8 @@
 # include <maths_utils/Box.hh>
 # include <sdl_engine/Brush.hh>
 # include <sdl_engine/Gradient.hh>
+# include "GMPBox.hh"
+# include "GMPVector2.hh"
 # include "RenderingTile.hh"
 # include "FractalOptions.hh"
 
@@ -30,7 +32,7 @@ namespace fractsim {
        *               is in real world coordinate.
        */
       Fractal(const utils::Sizef& canvas,
-              const utils::Boxf& area);
+              const GMPBox& area);
 
       /**
        * @brief - Destruction of the object.
@@ -40,12 +42,12 @@ namespace fractsim {
       /**
        * @brief - Used to retrieve the size of a pixel in real world coordinate. Uses the
        *          internal values to get the canvas size and the real world area that is
-       *          represented.
-       * @return - the output vector represents the size of a single pixel in real world
-       *           coordinate.
+       *          represented. The smallest dimension of the pixels is returned, with an
+       *          arbitrary precision so that it is not limited by the zoom level.
+       * @return - the size of a single pixel in real world coordinate.
        */
-      utils::Sizef
-      getPixelSize() const noexcept;
+      scalar::Arbitrary
+      getPixelSize() const;
 
       /**
        * @brief - Assign a new canvas size, which means that the brush generated by the
@@ -67,22 +69,31 @@ namespace fractsim {
        * @param zoom - `true` if the resize includes a zooming part, `false` otherwise.
        */
       void
-      realWorldResize(const utils::Boxf& area,
+      realWorldResize(const GMPBox& area,
                       bool zoom);
 
       /**
        * @brief - Used to register a new data tile to be used when producing images for
        *          the output canvas. This tile is not used right away, a new call to the
        *          `createBrush` method should be issued for that.
-       *          The tile is registered with the specified zoom level which indicates
-       *          the precision of the data. A different zoom level that what is defined
-       *          internally triggers a reset of the cache.
-       * @param zoom - the zoom level for the input data tile.
+       *          The tile is only registered if it was generated for the current zoom
+       *          level, which is described by its scale: tiles computed for a former
+       *          zoom level are discarded.
        * @param tile - the data tile to register.
        */
       void
-      registerDataTile(float zoom,
-                       RenderingTileShPtr tile);
+      registerDataTile(RenderingTileShPtr tile);
+
+      /**
+       * @brief - Used to retrieve the area of the input tile relatively to the bottom
+       *          left corner of the rendering area of this fractal. The area is given
+       *          as a fraction of the dimensions of the rendering area so that it can
+       *          be mapped to the canvas at any zoom level.
+       * @param tile - the tile for which the area should be computed.
+       * @return - the area of the tile relatively to the rendering area.
+       */
+      utils::Boxf
+      getRelativeArea(const RenderingTile& tile) const;
 
       /**
        * @brief - Used to generate a set of tiles allowing to produce a complete rendering
@@ -91,10 +102,14 @@ namespace fractsim {
        *          tiles already available.
        *          Uses the provided options to populate the tiles.
        * @param opt - the fractal options to assign to each tile.
+       * @param strategy - the strategy to use to fill the pixels of each tile.
+       * @param traversal - the order in which the pixels of each tile are packed.
        * @return - a list of tiles that should be rendered to create the missing data.
        */
       std::vector<RenderingTileShPtr>
-      generateRenderingTiles(FractalOptionsShPtr opt);
+      generateRenderingTiles(FractalOptionsShPtr opt,
+                             const tile::Strategy& strategy,
+                             const kernels::Traversal& traversal);
 
       /**
        * @brief - Create a new brush that can be used to create a texture representing this
@@ -108,16 +123,6 @@ namespace fractsim {
 
     private:
 
-      /**
-       * @brief - Used to retrieve a value allowing to compare two zoom levels. When the
-       *          distance between both is smaller than this threshold we consider them
-       *          to be equal.
-       * @return - a value that can be used as a threshold to compare zoom levels.
-       */
-      static
-      float
-      getZoomComparisonThreshold() noexcept;
-
       /**
        * @brief - Provide a value describing how many tiles should be used to
        *          divide the workload along the horizontal axis. This allows
@@ -138,9 +143,9 @@ namespace fractsim {
 
       /**
        * @brief - Similar to the `getPixelSize` method but does not attempt to acquire the
-       *          lock on the internal properties. This is meant for internal usage.
-       * @return - the output vector represents the size of a single pixel in real world
-       *           coordinate.
+       *          lock on the internal properties. This is meant for internal usage: the
+       *          dimensions of the pixels are expressed in units of `2^m_scale`.
+       * @return - the output vector represents the size of a single pixel.
        */
       utils::Sizef
       getPixelSizePrivate() const noexcept;
@@ -152,11 +157,74 @@ namespace fractsim {
        *          The goal of the method is to perform the definition of a tiling that can
        *          then be extended through the cache mechanism.
        * @param opt - the fractal options to associate to each produced tile.
+       * @param strategy - the strategy to use to fill the pixels of each tile.
+       * @param traversal - the order in which the pixels of each tile are packed.
        * @return - the list of tiles to render to obtain a good visualization of the rendering
        *           area associated to this object.
        */
       std::vector<RenderingTileShPtr>
-      generateDefaultTiling(FractalOptionsShPtr opt);
+      generateDefaultTiling(FractalOptionsShPtr opt,
+                            const tile::Strategy& strategy,
+                            const kernels::Traversal& traversal);
+
+      /**
+       * @brief - Used to retrieve the left bound of the rendering area relatively to the
+       *          anchor of the tiles. As the anchor is close to the rendering area, this
+       *          offset can be used to accurately position the tiles at deep zoom levels.
+       *          It is expressed in units of `2^m_scale`.
+       * @return - the left bound of the rendering area.
+       */
+      double
+      getLeftBound() const noexcept;
+
+      /**
+       * @brief - Similar to `getLeftBound` but for the bottom bound of the area.
+       * @return - the bottom bound of the rendering area.
+       */
+      double
+      getBottomBound() const noexcept;
+
+      /**
+       * @brief - Used to compute the offset of the input anchor relatively to the one
+       *          used by this fractal, in units of `2^m_scale`. This is typically null
+       *          unless the tile using the input anchor was generated for a previous
+       *          view.
+       * @param anchor - the anchor for which the offset should be computed.
+       * @param dx - output value receiving the offset along the `x` axis.
+       * @param dy - output value receiving the offset along the `y` axis.
+       */
+      void
+      getAnchorOffset(const GMPVector2ShPtr& anchor,
+                      double& dx,
+                      double& dy) const noexcept;
+
+      /**
+       * @brief - Used to select the precision to use to compute a tile with the input
+       *          options. The cheapest precision allowing to distinguish neighboring
+       *          pixels at the largest coordinate of the tile is selected, within the
+       *          limits of what the options support. This allows the tiles close to
+       *          the origin to use a smaller precision than the others.
+       * @param opt - the options used to compute the tile.
+       * @param xMin - the abscissa of the bottom left corner of the tile relatively
+       *               to the anchor, in units of `2^m_scale`.
+       * @param yMin - the ordinate of the bottom left corner of the tile relatively
+       *               to the anchor, in units of `2^m_scale`.
+       * @param dims - the dimensions of the tile, in units of `2^m_scale`.
+       * @return - the precision to use for the tile.
+       */
+      scalar::Precision
+      selectPrecision(const FractalOptions& opt,
+                      double xMin,
+                      double yMin,
+                      const utils::Sizef& dims) const noexcept;
+
+      /**
+       * @brief - Used to log the number of tiles computed with each precision among
+       *          the input list.
+       * @param tiles - the tiles to describe.
+       */
+      void
+      logPrecisions(const std::vector<RenderingTileShPtr>& tiles) const;
 
     private:
 
@@ -172,27 +240,45 @@ namespace fractsim {
 
       /**
        * @brief - The area assigned to this fractal. This allows to determine which part of
-       *          the internal cache corresponds to which position in the real world.
+       *          the internal cache corresponds to which position in the real world. It
+       *          is kept with arbitrary precision so that it can be compared accurately
+       *          to the anchor of the tiles.
+       */
+      GMPBox m_area;
+
+      /**
+       * @brief - The point relatively to which the tiles are positioned. It is assigned to
+       *          the bottom left corner of the area each time a new tiling is defined, so
+       *          that the offsets of the tiles remain small compared to their dimensions
+       *          and can be manipulated with limited precision.
+       */
+      GMPVector2ShPtr m_anchor;
+
+      /**
+       * @brief - The binary exponent of the dimensions of the area. The values manipulated
+       *          in double precision (the offsets and dimensions of the tiles, the size of
+       *          the pixels) are expressed in units of `2^m_scale`: they are thus of the
+       *          order of the dimensions of the area whatever the zoom level. It changes
+       *          with the zoom level, which invalidates the tiles of the cache.
        */
-      utils::Boxf m_area;
+      long m_scale;
 
       /**
-       * @brief - Holds the current zoom level associated to the data tiles. As long as some
-       *          tiles are coming up with the same zoom level they are accumulated. If the
-       *          zoom level is changed, the cache is reset.
+       * @brief - The left bound of the area that has currently been rendered. Note that this
+       *          is a projection computed when the tiling division is computed (through the
+       *          interface method `generateRenderingTiles`): depending on the completion of
+       *          the rendering it might not be actually the case that all tiles have been
+       *          rendered. It is expressed relatively to the anchor of the tiles.
        */
-      float m_zoomLevel;
+      double m_renderedXMin;
 
       /**
-       * @brief - The area that has currently been rendered. Note that this is a projection
-       *          computed when the tiling division is computed (through the interface method
-       *          `generateRenderingTiles`): depending on the completion of the rendering it
-       *          might not be actually the case that all tiles have been rendered.
+       * @brief - Similar to `m_renderedXMin` but holds the bottom bound of the area.
        */
-      utils::Boxf m_renderedArea;
+      double m_renderedYMin;
 
       /**
-       * @brief - This value holds the number of tiles contained in the `m_renderedArea` along
+       * @brief - This value holds the number of tiles contained in the rendered area along
        *          each axis. It helps to build the area assigned to new tile when needed.
        */
       utils::Vector2i m_tilesCount;
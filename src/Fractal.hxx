@@ -2,15 +2,20 @@
 # define   FRACTAL_HXX
 
 # include "Fractal.hh"
+# include <algorithm>
+# include <cmath>
+# include <map>
 
 namespace fractsim {
 
   inline
-  utils::Sizef
-  Fractal::getPixelSize() const noexcept {
+  scalar::Arbitrary
+  Fractal::getPixelSize() const {
     const std::lock_guard guard(m_propsLocker);
 
-    return getPixelSizePrivate();
+    utils::Sizef pixSize = getPixelSizePrivate();
+
+    return ldexp(scalar::Arbitrary(std::min(pixSize.w(), pixSize.h())), m_scale);
   }
 
   inline
@@ -33,14 +38,15 @@ namespace fractsim {
 
   inline
   void
-  Fractal::realWorldResize(const utils::Boxf& area,
+  Fractal::realWorldResize(const GMPBox& area,
                            bool zoom)
   {
-    // Check consistency.
-    if (!area.valid()) {
+    // Check consistency. The dimensions are not converted to a
+    // floating point value as they might not be representable.
+    if (mpf_sgn(area.w()) <= 0 || mpf_sgn(area.h()) <= 0) {
       error(
         std::string("Could not assign new rendering area to fractal"),
-        std::string("Invalid input size ") + area.toString()
+        std::string("Invalid input size ") + area.toBox().toString()
       );
     }
 
@@ -48,18 +54,21 @@ namespace fractsim {
     const std::lock_guard guard(m_propsLocker);
 
     m_area = area;
+
     // We want to perform a clean of the cache in case the zoom
-    // parameter indicates it.
-    if (zoom) {
+    // parameter indicates it. The tiles are also expressed with
+    // a certain scale: if it changes, they are no longer valid.
+    long scale = m_area.getScale();
+    if (zoom || scale != m_scale) {
       m_tiles.clear();
     }
+
+    m_scale = scale;
   }
 
   inline
   void
-  Fractal::registerDataTile(float zoom,
-                            RenderingTileShPtr tile)
-  {
+  Fractal::registerDataTile(RenderingTileShPtr tile) {
     // Prevent invalid tiles.
     if (tile == nullptr) {
       error(
@@ -71,22 +80,34 @@ namespace fractsim {
     // Protect from concurrent accesses.
     const std::lock_guard guard(m_propsLocker);
 
-    // Check whether the zoom level is still consistent with what we
-    // are keeping internally. If this is the case the tile can be
-    // appended to the cache, otherwise we need to reset it.
-    if (!utils::fuzzyEqual(m_zoomLevel, zoom, getZoomComparisonThreshold())) {
-      m_tiles.clear();
-
-      m_zoomLevel = zoom;
+    // Check whether the tile was computed for the current zoom
+    // level: if this is not the case it cannot be positioned in
+    // the rendering area and is discarded.
+    if (tile->getScale() != m_scale) {
+      return;
     }
 
     m_tiles.push_back(tile);
   }
 
   inline
-  float
-  Fractal::getZoomComparisonThreshold() noexcept {
-    return 0.000001f;
+  utils::Boxf
+  Fractal::getRelativeArea(const RenderingTile& tile) const {
+    // Protect from concurrent accesses.
+    const std::lock_guard guard(m_propsLocker);
+
+    double dx, dy;
+    getAnchorOffset(tile.getAnchor(), dx, dy);
+
+    utils::Boxf area = tile.getArea();
+    utils::Sizef dims = m_area.toSize(m_scale);
+
+    return utils::Boxf(
+      static_cast<float>((dx + area.x() - getLeftBound()) / dims.w()),
+      static_cast<float>((dy + area.y() - getBottomBound()) / dims.h()),
+      area.w() / dims.w(),
+      area.h() / dims.h()
+    );
   }
 
   inline
@@ -104,9 +125,94 @@ namespace fractsim {
   inline
   utils::Sizef
   Fractal::getPixelSizePrivate() const noexcept {
-    return utils::Sizef(m_area.w() / m_canvas.w(), m_area.h() / m_canvas.h());
+    utils::Sizef dims = m_area.toSize(m_scale);
+    return utils::Sizef(dims.w() / m_canvas.w(), dims.h() / m_canvas.h());
+  }
+
+  inline
+  double
+  Fractal::getLeftBound() const noexcept {
+    double dx, dy;
+    m_area.getCenter().getOffset(*m_anchor, m_scale, dx, dy);
+
+    return dx - GMPFloat::toDouble(m_area.w(), m_scale) / 2.0;
+  }
+
+  inline
+  double
+  Fractal::getBottomBound() const noexcept {
+    double dx, dy;
+    m_area.getCenter().getOffset(*m_anchor, m_scale, dx, dy);
+
+    return dy - GMPFloat::toDouble(m_area.h(), m_scale) / 2.0;
+  }
+
+  inline
+  void
+  Fractal::getAnchorOffset(const GMPVector2ShPtr& anchor,
+                           double& dx,
+                           double& dy) const noexcept
+  {
+    dx = 0.0;
+    dy = 0.0;
+
+    if (anchor != m_anchor) {
+      anchor->getOffset(*m_anchor, m_scale, dx, dy);
+    }
+  }
+
+  inline
+  scalar::Precision
+  Fractal::selectPrecision(const FractalOptions& opt,
+                           double xMin,
+                           double yMin,
+                           const utils::Sizef& dims) const noexcept
+  {
+    // The largest coordinate of the tile is reached on one of its corners:
+    // the magnitude of the coordinates does not require more than double
+    // precision to be evaluated.
+    int scale = static_cast<int>(m_scale);
+    double x = mpf_get_d(m_anchor->x()) + std::ldexp(xMin, scale);
+    double y = mpf_get_d(m_anchor->y()) + std::ldexp(yMin, scale);
+
+    double bounds[] = {
+      x,
+      x + std::ldexp(static_cast<double>(dims.w()), scale),
+      y,
+      y + std::ldexp(static_cast<double>(dims.h()), scale)
+    };
+
+    float extent = 0.0f;
+    for (unsigned id = 0u ; id < sizeof(bounds) / sizeof(bounds[0]) ; ++id) {
+      extent = std::max(extent, static_cast<float>(std::abs(bounds[id])));
+    }
+
+    utils::Sizef pixSize = getPixelSizePrivate();
+    scalar::Arbitrary pixel = ldexp(scalar::Arbitrary(std::min(pixSize.w(), pixSize.h())), m_scale);
+
+    return std::min(
+      scalar::select(extent, pixel, opt.getAccuracy()),
+      opt.getMaximumPrecision()
+    );
   }
 
+  inline
+  void
+  Fractal::logPrecisions(const std::vector<RenderingTileShPtr>& tiles) const {
+    std::map<scalar::Precision, unsigned> counts;
+    for (unsigned id = 0u ; id < tiles.size() ; ++id) {
+      ++counts[tiles[id]->getPrecision()];
+    }
+
+    std::string desc;
+    for (std::map<scalar::Precision, unsigned>::const_iterator it = counts.cbegin() ; it != counts.cend() ; ++it) {
+      desc += (desc.empty() ? "" : ", ") + std::to_string(it->second) + " " + scalar::toString(it->first);
+    }
+
+    verbose("Computing " + std::to_string(tiles.size()) + " tile(s) with precision " + desc);
+  }
+
+
 }
 
 #endif    /* FRACTAL_HXX */
@@ -3,7 +3,12 @@
 
 # include <memory>
 # include <core_utils/CoreObject.hh>
+# include <maths_utils/Size.hh>
 # include <sdl_engine/Gradient.hh>
+# include "GMPBox.hh"
+# include "PixelBlock.hh"
+# include "RenderingStatistics.hh"
+# include "ScalarPrecision.hh"
 
 namespace fractsim {
 
@@ -95,8 +100,131 @@ namespace fractsim {
       virtual float
       compute(const utils::Vector2f& p) const noexcept = 0;
 
+      /**
+       * @brief - Computes the confidence for each point of a block and saves it into
+       *          the output array. The point `(x, y)` of the block is located at
+       *          `(xMin + x * stepX, yMin + y * stepY)` and is saved at the index
+       *          `y * w + x` in the output array.
+       *          Unlike the `compute` method the output values are clamped into the
+       *          range `[0; 1]`.
+       *          The scalar type of the block defines the precision to use for the
+       *          computations: it should be one of the types of `scalar::Types`.
+       *          The actual computations are performed by `computeBlockPrivate` which
+       *          allows inheriting classes to process all the points at once instead
+       *          of relying on a call to `compute` for each one of them.
+       * @param block - the block of points to compute.
+       * @param out - output array receiving the confidence of each point. Should be
+       *              able to hold at least `w * h` values.
+       * @param stats - output statistics updated with the work performed to compute
+       *                the block.
+       */
+      template <typename Scalar>
+      void
+      computeBlock(const kernels::PixelBlock<Scalar>& block,
+                   float* out,
+                   RenderingStatistics& stats) const noexcept;
+
+      /**
+       * @brief - Similar to `computeBlock` but computes an arbitrary list of points.
+       *          The point `id` is `(xs[id], ys[id])` and its confidence is saved at
+       *          index `id` in the output array. Just like for `computeBlock` the
+       *          values are clamped into the range `[0; 1]`.
+       *          This is typically used to compute sparse sets of points where it
+       *          is not possible to use blocks efficiently.
+       * @param points - the list of points to compute.
+       * @param out - output array receiving the confidence of each point. Should be
+       *              able to hold at least `count` values.
+       * @param stats - output statistics updated with the work performed to compute
+       *                the points.
+       */
+      template <typename Scalar>
+      void
+      computePoints(const kernels::PointList<Scalar>& points,
+                    float* out,
+                    RenderingStatistics& stats) const noexcept;
+
+      /**
+       * @brief - Used to retrieve the largest precision that this fractal can make
+       *          use of. Computing the points with a higher precision than the one
+       *          returned here would not bring any additional details.
+       *          The default implementation only supports single precision.
+       * @return - the maximum precision supported by this fractal.
+       */
+      virtual scalar::Precision
+      getMaximumPrecision() const noexcept;
+
+      /**
+       * @brief - Used to notify the options that a new view is about to be rendered.
+       *          This allows inheriting classes to precompute some data shared by all
+       *          the points of the view before the tiles are computed. The default
+       *          implementation does nothing.
+       *          Note that tiles of a previous view might still be computed while this
+       *          method is called.
+       * @param area - the area of the view to render, with arbitrary precision.
+       * @param pixel - the size of a single pixel of the view in real world
+       *                coordinates, with arbitrary precision.
+       */
+      virtual void
+      prepareRendering(const GMPBox& area,
+                       const scalar::Arbitrary& pixel);
+
+      /**
+       * @brief - Used to determine whether two points belong to the same class, as
+       *          described by their (clamped) confidence. A region of the fractal
+       *          enclosed by points of a single class is assumed to only contain
+       *          points of this class so that it can be filled without computing
+       *          it. The default implementation does not define any class so that
+       *          all the points are computed: this suits the fractals where the
+       *          regions of a given value can enclose other values, such as the
+       *          bands of iterations of the Newton fractals which surround the ones
+       *          converging faster.
+       * @param lhs - the confidence of the first point.
+       * @param rhs - the confidence of the second point.
+       * @return - `true` if both points belong to the same class.
+       */
+      virtual bool
+      isSameClass(float lhs,
+                  float rhs) const noexcept;
+
     protected:
 
+      /**
+       * @brief - Interface method allowing inheriting classes to compute all the points
+       *          of a block at once. The default implementation calls `compute` for
+       *          each point of the block. Values do not need to be clamped as it is
+       *          handled by the `computeBlock` method.
+       *          The block is received through a pointer to the version matching its
+       *          precision: inheriting classes typically forward it to a templated
+       *          method with `std::visit`, and only need to handle the precisions
+       *          reported by `getMaximumPrecision`.
+       *          See `computeBlock` for more details about the layout of the block.
+       * @param block - the block of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics to update with the work performed. Note
+       *                that the number of pixels is handled by `computeBlock`.
+       */
+      virtual void
+      computeBlockPrivate(scalar::AnyOf<kernels::PixelBlock> block,
+                          float* out,
+                          RenderingStatistics& stats) const noexcept;
+
+      /**
+       * @brief - Interface method allowing inheriting classes to compute a list of
+       *          points at once. The default implementation calls `compute` for each
+       *          point. Values do not need to be clamped as it is handled by the
+       *          `computePoints` method.
+       *          Just like for `computeBlockPrivate` the points are received with
+       *          any of the supported precisions.
+       * @param points - the list of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics to update with the work performed. Note
+       *                that the number of pixels is handled by `computePoints`.
+       */
+      virtual void
+      computePointsPrivate(scalar::AnyOf<kernels::PointList> points,
+                           float* out,
+                           RenderingStatistics& stats) const noexcept;
+
       /**
        * @brief - Used to retrieve a default suitable accuracy to compute
        *          the associated fractal.
@@ -125,6 +253,34 @@ namespace fractsim {
       unsigned
       getDefaultPaletteWrapping() noexcept;
 
+      /**
+       * @brief - Used to compute the squared distance below which two terms of an
+       *          escape time series are considered identical when looking for its
+       *          periodic orbits. Two terms closer than a small fraction of a pixel
+       *          can't be told apart in the final image: the distance scales with
+       *          the pixels so that the orbits of distinct pixels are not merged at
+       *          deep zooms. It is also capped so that the slowly escaping points
+       *          are not mistaken for points of the fractal.
+       *          All the paths computing the series (blocks, lists of points and
+       *          isolated points) rely on this definition.
+       * @param step - the size of the pixels.
+       * @return - the squared distance used to detect periodic orbits.
+       */
+      static
+      double
+      getPeriodicityTolerance(double step) noexcept;
+
+      /**
+       * @brief - Similar to the above method for an isolated point, which does not
+       *          belong to a pixel: its size is taken as the resolution of the single
+       *          precision coordinates of the point.
+       * @param p - the point to compute.
+       * @return - the squared distance used to detect periodic orbits.
+       */
+      static
+      double
+      getPeriodicityTolerance(const utils::Vector2f& p) noexcept;
+
       /**
        * @brief - Used to retrieve the palette wrapping applied to this object.
        * @return - the current palette wrapping.
@@ -143,6 +299,39 @@ namespace fractsim {
       float
       performWrapping(float val) const noexcept;
 
+    private:
+
+      /**
+       * @brief - Used to retrieve the largest squared distance below which two terms
+       *          of a series are considered identical when looking for periodic orbits.
+       * @return - the largest periodicity tolerance.
+       */
+      static
+      float
+      getMaximumPeriodicityTolerance() noexcept;
+
+      /**
+       * @brief - Default implementation of `computeBlockPrivate` for any scalar type:
+       *          each point is converted to single precision and computed with the
+       *          `compute` method.
+       * @param block - the block of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       */
+      template <typename Scalar>
+      void
+      computeBlockDefault(const kernels::PixelBlock<Scalar>& block,
+                          float* out) const noexcept;
+
+      /**
+       * @brief - Similar to `computeBlockDefault` but for a list of points.
+       * @param points - the list of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       */
+      template <typename Scalar>
+      void
+      computePointsDefault(const kernels::PointList<Scalar>& points,
+                           float* out) const noexcept;
+
     private:
 
       /**
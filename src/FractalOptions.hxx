@@ -2,6 +2,10 @@
 # define   FRACTAL_OPTIONS_HXX
 
 # include "FractalOptions.hh"
+# include <algorithm>
+# include <cmath>
+# include <limits>
+# include <variant>
 
 namespace fractsim {
 
@@ -52,12 +56,114 @@ namespace fractsim {
     m_palette = palette;
   }
 
+  template <typename Scalar>
+  inline
+  void
+  FractalOptions::computeBlock(const kernels::PixelBlock<Scalar>& block,
+                               float* out,
+                               RenderingStatistics& stats) const noexcept
+  {
+    computeBlockPrivate(&block, out, stats);
+
+    unsigned count = block.w * block.h;
+    stats.pixels += count;
+
+    // Normalize the contribution with the maximum confidence.
+    for (unsigned id = 0u ; id < count ; ++id) {
+      out[id] = std::min(1.0f, std::max(0.0f, out[id]));
+    }
+  }
+
+  template <typename Scalar>
+  inline
+  void
+  FractalOptions::computePoints(const kernels::PointList<Scalar>& points,
+                                float* out,
+                                RenderingStatistics& stats) const noexcept
+  {
+    computePointsPrivate(&points, out, stats);
+    stats.pixels += points.count;
+
+    // Normalize the contribution with the maximum confidence.
+    for (unsigned id = 0u ; id < points.count ; ++id) {
+      out[id] = std::min(1.0f, std::max(0.0f, out[id]));
+    }
+  }
+
+  inline
+  scalar::Precision
+  FractalOptions::getMaximumPrecision() const noexcept {
+    return scalar::Precision::Single;
+  }
+
+  inline
+  void
+  FractalOptions::prepareRendering(const GMPBox& /*area*/,
+                                   const scalar::Arbitrary& /*pixel*/)
+  {}
+
+  inline
+  bool
+  FractalOptions::isSameClass(float /*lhs*/,
+                              float /*rhs*/) const noexcept
+  {
+    return false;
+  }
+
+  inline
+  void
+  FractalOptions::computeBlockPrivate(scalar::AnyOf<kernels::PixelBlock> block,
+                                      float* out,
+                                      RenderingStatistics& /*stats*/) const noexcept
+  {
+    std::visit(
+      [this, out](const auto* values) {
+        computeBlockDefault(*values, out);
+      },
+      block
+    );
+  }
+
+  inline
+  void
+  FractalOptions::computePointsPrivate(scalar::AnyOf<kernels::PointList> points,
+                                       float* out,
+                                       RenderingStatistics& /*stats*/) const noexcept
+  {
+    std::visit(
+      [this, out](const auto* values) {
+        computePointsDefault(*values, out);
+      },
+      points
+    );
+  }
+
   inline
   unsigned
   FractalOptions::getDefaultAccuracy() noexcept {
     return 128u;
   }
 
+  inline
+  double
+  FractalOptions::getPeriodicityTolerance(double step) noexcept {
+    double distance = 1.0e-3 * step;
+    return std::min(static_cast<double>(getMaximumPeriodicityTolerance()), distance * distance);
+  }
+
+  inline
+  double
+  FractalOptions::getPeriodicityTolerance(const utils::Vector2f& p) noexcept {
+    float magnitude = std::max({1.0f, std::abs(p.x()), std::abs(p.y())});
+    return getPeriodicityTolerance(static_cast<double>(std::numeric_limits<float>::epsilon() * magnitude));
+  }
+
+  inline
+  float
+  FractalOptions::getMaximumPeriodicityTolerance() noexcept {
+    return 1.0e-12f;
+  }
+
   inline
   sdl::core::engine::GradientShPtr
   FractalOptions::getDefaultPalette() noexcept {
@@ -110,6 +216,37 @@ namespace fractsim {
     return std::fmod(perc, wrap) / wrap;
   }
 
+  template <typename Scalar>
+  inline
+  void
+  FractalOptions::computeBlockDefault(const kernels::PixelBlock<Scalar>& block,
+                                      float* out) const noexcept
+  {
+    for (unsigned y = 0u ; y < block.h ; ++y) {
+      for (unsigned x = 0u ; x < block.w ; ++x) {
+        out[y * block.w + x] = compute(
+          utils::Vector2f(
+            static_cast<float>(block.xMin + x * block.stepX),
+            static_cast<float>(block.yMin + y * block.stepY)
+          )
+        );
+      }
+    }
+  }
+
+  template <typename Scalar>
+  inline
+  void
+  FractalOptions::computePointsDefault(const kernels::PointList<Scalar>& points,
+                                       float* out) const noexcept
+  {
+    for (unsigned id = 0u ; id < points.count ; ++id) {
+      out[id] = compute(
+        utils::Vector2f(static_cast<float>(points.xs[id]), static_cast<float>(points.ys[id]))
+      );
+    }
+  }
+
 }
 
 #endif    /* FRACTAL_OPTIONS_HXX */
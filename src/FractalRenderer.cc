@@ -1,5 +1,6 @@
 
 # include "FractalRenderer.hh"
+# include "KernelDispatch.hh"
 # include <sdl_engine/PaintEvent.hh>
 
 namespace fractsim {
@@ -19,6 +20,9 @@ namespace fractsim {
     m_scheduler(std::make_shared<utils::ThreadPool>(getWorkerThreadCount())),
     m_taskProgress(0u),
     m_taskTotal(1u),
+    m_statistics{},
+    m_strategy(tile::Strategy::PerPixel),
+    m_traversal(kernels::Traversal::Morton),
 
     m_tex(),
     m_tilesRendered(true),
@@ -31,6 +35,8 @@ namespace fractsim {
     setService(std::string("fractal_renderer"));
 
     build();
+
+    log("Using " + kernels::getVariantName() + " kernels");
   }
 
   void
@@ -70,9 +76,11 @@ namespace fractsim {
     scheduleRendering(true);
 
     // Notify listeners of the new area.
+    utils::Boxf area = m_renderingOpt->getRenderingArea().toBox();
+
     onRenderingAreaChanged.safeEmit(
-      std::string("onRenderingAreaChanged(") + m_renderingOpt->getRenderingArea().toString() + ")",
-      m_renderingOpt->getRenderingArea()
+      std::string("onRenderingAreaChanged(") + area.toString() + ")",
+      area
     );
   }
 
@@ -87,25 +95,24 @@ namespace fractsim {
     // motion into a real world coordinate frame.
     const std::lock_guard guard(m_propsLocker);
 
-    // Note: we need to invert the motion's direction for some reasons.
-    utils::Sizef pixSize = m_fractalData->getPixelSize();
-    utils::Vector2f realWorldMotion(
-      -motion.x() * pixSize.w(),
-      -motion.y() * pixSize.h()
+    // Note: we need to invert the motion's direction for some reasons. The
+    // motion is expressed as a fraction of the area so that it does not
+    // depend on the zoom level.
+    utils::Sizef canvas = m_renderingOpt->getCanvasSize();
+    utils::Vector2f relativeMotion(
+      -motion.x() / canvas.w(),
+      -motion.y() / canvas.h()
     );
 
     // Compute the new rendering area by offseting the old one with the motion.
-    utils::Boxf area = m_renderingOpt->getRenderingArea();
-    utils::Boxf newArea(
-      area.x() + realWorldMotion.x(),
-      area.y() + realWorldMotion.y(),
-      area.toSize()
-    );
+    // The offset is applied with the precision of the area so that scrolling
+    // does not make the view drift at deep zoom levels.
+    utils::Boxf area = m_renderingOpt->getRenderingArea().toBox();
+    GMPBox newArea = m_renderingOpt->translate(relativeMotion);
 
-    verbose("Moving from " + area.toString() + " to " + newArea.toString() + " (motion: " + motion.toString() + ", real: " + realWorldMotion.toString() + ")");
+    verbose("Moving from " + area.toString() + " to " + newArea.toBox().toString() + " (motion: " + motion.toString() + ", relative: " + relativeMotion.toString() + ")");
 
     // Update the rendering area.
-    m_renderingOpt->setRenderingArea(newArea, false);
     m_fractalData->realWorldResize(newArea, false);
 
     // Schedule a rendering.
@@ -113,8 +120,8 @@ namespace fractsim {
 
     // Trigger new signals to notify listeners.
     onRenderingAreaChanged.safeEmit(
-      std::string("onRenderingAreaChanged(") + newArea.toString() + ")",
-      newArea
+      std::string("onRenderingAreaChanged(") + newArea.toBox().toString() + ")",
+      newArea.toBox()
     );
 
     // Notify the caller that we changed the area.
@@ -149,9 +156,9 @@ namespace fractsim {
 
     float factor = motion.y() > 0 ? getDefaultZoomInFactor() : getDefaultZoomOutFactor();
 
-    utils::Vector2f conv = convertGlobalToRealWorld(e.getMousePosition());
+    GMPVector2 conv = convertGlobalToRealWorld(e.getMousePosition());
 
-    utils::Boxf newArea = m_renderingOpt->zoom(conv, factor);
+    GMPBox newArea = m_renderingOpt->zoom(conv, factor);
     m_fractalData->realWorldResize(newArea, true);
 
     // Schedule the rendering.
@@ -163,8 +170,8 @@ namespace fractsim {
       m_renderingOpt->getZoom()
     );
     onRenderingAreaChanged.safeEmit(
-      std::string("onRenderingAreaChanged(") + newArea.toString() + ")",
-      newArea
+      std::string("onRenderingAreaChanged(") + newArea.toBox().toString() + ")",
+      newArea.toBox()
     );
 
     return toReturn;
@@ -236,8 +243,11 @@ namespace fractsim {
       m_scheduler->cancelJobs();
     }
 
+    // Let the options prepare the computations for this view.
+    m_fractalOptions->prepareRendering(m_renderingOpt->getRenderingArea(), m_fractalData->getPixelSize());
+
     // Generate the launch schedule.
-    std::vector<RenderingTileShPtr> tiles = m_fractalData->generateRenderingTiles(m_fractalOptions);
+    std::vector<RenderingTileShPtr> tiles = m_fractalData->generateRenderingTiles(m_fractalOptions, m_strategy, m_traversal);
 
     // Convert to required pointer type.
     std::vector<utils::AsynchronousJobShPtr> tilesAsJobs(tiles.begin(), tiles.end());
@@ -255,6 +265,7 @@ namespace fractsim {
     // Notify listeners that the progression is now `0`.
     m_taskProgress = 0u;
     m_taskTotal = tiles.size();
+    m_statistics = RenderingStatistics{};
 
     onTileCompleted.safeEmit(
       std::string("onTileCompleted(0.0)"),
@@ -281,7 +292,7 @@ namespace fractsim {
         continue;
       }
 
-      utils::Boxf local = convertFractalAreaToLocal(tile->getArea());
+      utils::Boxf local = convertFractalAreaToLocal(m_fractalData->getRelativeArea(*tile));
 
       // Expand the bounding box in order to prevent weird artifacts when the area is not
       // exactly matching the previous one.
@@ -292,7 +303,9 @@ namespace fractsim {
       }
 
       // Also register this tile to the local fractal proxy.
-      m_fractalData->registerDataTile(m_renderingOpt->getMeanZoom(), tile);
+      m_fractalData->registerDataTile(tile);
+
+      m_statistics.merge(tile->getStatistics());
     }
 
     postEvent(e);
@@ -305,6 +318,10 @@ namespace fractsim {
 
     float perc = 1.0f * m_taskProgress / m_taskTotal;
 
+    if (m_taskProgress >= m_taskTotal) {
+      log("Rendered " + std::to_string(m_taskTotal) + " tile(s): " + m_statistics.toString());
+    }
+
     onTileCompleted.safeEmit(
       std::string("onTileCompleted(") + std::to_string(perc) + ")",
       perc
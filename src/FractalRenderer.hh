@@ -9,6 +9,7 @@
 # include "FractalOptions.hh"
 # include "RenderingOptions.hh"
 # include "Fractal.hh"
+# include "RenderingStatistics.hh"
 
 namespace fractsim {
 
@@ -149,6 +150,24 @@ namespace fractsim {
       sdl::core::engine::RawKey
       getDefaultResetKey() noexcept;
 
+      /**
+       * @brief - Used to retrieve the default key to use to switch to the next
+       *          strategy to fill the tiles of the fractal.
+       * @return - the key to use to change the tiles' strategy.
+       */
+      static
+      sdl::core::engine::RawKey
+      getDefaultStrategyKey() noexcept;
+
+      /**
+       * @brief - Used to retrieve the default key to use to switch to the next
+       *          order in which the pixels of the tiles are packed by the kernels.
+       * @return - the key to use to change the tiles' traversal.
+       */
+      static
+      sdl::core::engine::RawKey
+      getDefaultTraversalKey() noexcept;
+
       /**
        * @brief - Used to retrieve a default value describing how much the repaint
        *          events' areas should be expanded. This process allows to cover for
@@ -208,7 +227,8 @@ namespace fractsim {
        *          frame into an area expressed in local coordinate frame. This is used
        *          to make the association between the tiles and the corresponding area
        *          displayed.
-       * @param area - an area assumed to be expressed in fractal's coordinate frame.
+       * @param area - an area expressed relatively to the bottom left corner of the
+       *               rendering area, as a fraction of its dimensions.
        * @return - a box representing the area in local coordinate frame where the input
        *           area is displayed.
        */
@@ -249,10 +269,11 @@ namespace fractsim {
        * @brief - Used to convert the input position expressed in global coordinate frame
        *          into a position expressed in real world coordinate.
        *          Note that this method assumes that the locker is already acquired.
+       *          The position is computed with the precision of the rendering area.
        * @param global - the global coordinate frame position to convert.
        * @return - the corresponding position in real world coordinate frame.
        */
-      utils::Vector2f
+      GMPVector2
       convertGlobalToRealWorld(const utils::Vector2f& global);
 
       /**
@@ -317,6 +338,28 @@ namespace fractsim {
        */
       unsigned m_taskTotal;
 
+      /**
+       * @brief - Accumulates the statistics of the tiles computed so far in the current
+       *          rendering operation. These are reported once all the tiles have been
+       *          processed.
+       */
+      RenderingStatistics m_statistics;
+
+      /**
+       * @brief - The strategy used to fill the pixels of the tiles generated for the
+       *          next renderings. It can be changed through the `getDefaultStrategyKey`
+       *          key, which triggers a complete rendering of the fractal.
+       */
+      tile::Strategy m_strategy;
+
+      /**
+       * @brief - The order in which the pixels of the tiles generated for the next
+       *          renderings are packed by the kernels. It can be changed through the
+       *          `getDefaultTraversalKey` key: the results are the same whatever
+       *          the traversal so this is mostly useful to compare them.
+       */
+      kernels::Traversal m_traversal;
+
       /**
        * @brief - The index returned by the engine for the texture representing the fractal
        *          on screen. It is rendered from the tiles' data computed internally and is
@@ -41,7 +41,7 @@ namespace fractsim {
 
       // Reset the options to the initial viewing window.
       if (m_renderingOpt != nullptr) {
-        utils::Boxf area = m_renderingOpt->reset();
+        GMPBox area = m_renderingOpt->reset();
         m_fractalData->realWorldResize(area, false);
 
         // Schedule a rendering.
@@ -49,12 +49,71 @@ namespace fractsim {
 
         // Notify listeners.
         onRenderingAreaChanged.safeEmit(
-          std::string("onRenderingAreaChanged(") + area.toString() + ")",
-          area
+          std::string("onRenderingAreaChanged(") + area.toBox().toString() + ")",
+          area.toBox()
         );
       }
     }
 
+    // Check whether the key corresponds to the strategy key.
+    if (e.getRawKey() == getDefaultStrategyKey()) {
+      // Protect from concurrent accesses.
+      const std::lock_guard guard(m_propsLocker);
+
+      switch (m_strategy) {
+        case tile::Strategy::PerPixel:
+          m_strategy = tile::Strategy::Subdivision;
+          break;
+        case tile::Strategy::Subdivision:
+          m_strategy = tile::Strategy::BoundaryTracing;
+          break;
+        case tile::Strategy::BoundaryTracing:
+        default:
+          m_strategy = tile::Strategy::PerPixel;
+          break;
+      }
+      verbose("Switched tiles' strategy to " + tile::toString(m_strategy));
+
+      // The tiles already computed should be rendered again with the new
+      // strategy so we need to clear the cache.
+      if (m_renderingOpt != nullptr) {
+        m_fractalData->realWorldResize(m_renderingOpt->getRenderingArea(), true);
+
+        scheduleRendering(true);
+      }
+    }
+
+    // Check whether the key corresponds to the traversal key.
+    if (e.getRawKey() == getDefaultTraversalKey()) {
+      // Protect from concurrent accesses.
+      const std::lock_guard guard(m_propsLocker);
+
+      switch (m_traversal) {
+        case kernels::Traversal::Rows:
+          m_traversal = kernels::Traversal::Blocks;
+          break;
+        case kernels::Traversal::Blocks:
+          m_traversal = kernels::Traversal::Morton;
+          break;
+        case kernels::Traversal::Morton:
+          m_traversal = kernels::Traversal::Hilbert;
+          break;
+        case kernels::Traversal::Hilbert:
+        default:
+          m_traversal = kernels::Traversal::Rows;
+          break;
+      }
+      verbose("Switched tiles' traversal to " + tile::toString(m_traversal));
+
+      // The statistics of the next rendering describe the coherence of the
+      // packets produced by the new traversal.
+      if (m_renderingOpt != nullptr) {
+        m_fractalData->realWorldResize(m_renderingOpt->getRenderingArea(), true);
+
+        scheduleRendering(true);
+      }
+    }
+
     // Check for arrow keys.
     bool move = false;
     utils::Vector2f motion;
@@ -84,7 +143,7 @@ namespace fractsim {
       {
         const std::lock_guard guard(m_propsLocker);
 
-        center = m_renderingOpt->getRenderingArea().getCenter();
+        center = m_renderingOpt->getRenderingArea().toBox().getCenter();
         newCenter = center + motion;
       }
 
@@ -103,8 +162,9 @@ namespace fractsim {
     // Protect from concurrent accesses.
     const std::lock_guard guard(m_propsLocker);
 
-    // Convert the position to internal coordinates.
-    utils::Vector2f conv = convertGlobalToRealWorld(e.getMousePosition());
+    // Convert the position to internal coordinates: single precision is
+    // enough for display purposes.
+    utils::Vector2f conv = convertGlobalToRealWorld(e.getMousePosition()).toVector();
 
     // Notify external listeners.
     onCoordChanged.safeEmit(
@@ -141,6 +201,18 @@ namespace fractsim {
     return sdl::core::engine::RawKey::R;
   }
 
+  inline
+  sdl::core::engine::RawKey
+  FractalRenderer::getDefaultStrategyKey() noexcept {
+    return sdl::core::engine::RawKey::M;
+  }
+
+  inline
+  sdl::core::engine::RawKey
+  FractalRenderer::getDefaultTraversalKey() noexcept {
+    return sdl::core::engine::RawKey::T;
+  }
+
   inline
   float
   FractalRenderer::getExpansionThreshold() noexcept {
@@ -156,26 +228,20 @@ namespace fractsim {
   inline
   utils::Boxf
   FractalRenderer::convertFractalAreaToLocal(const utils::Boxf& area) const {
-    // The `area` represents a real world coordinate of the area. We need to
-    // use the rendering options if any to determine the screen area which
+    // The `area` is expressed as a fraction of the rendering area. We need
+    // to use the rendering options if any to determine the screen area which
     // corresponds to the same area.
     if (m_renderingOpt == nullptr) {
       return utils::Boxf();
     }
 
-    utils::Boxf total = m_renderingOpt->getRenderingArea();
     utils::Sizef canvas = m_renderingOpt->getCanvasSize();
 
-    float dToLeft = (area.x() - total.getLeftBound()) / total.w();
-    float dToBottom = (area.y() - total.getBottomBound()) / total.h();
-
-    utils::Vector2f areaToResize(canvas.w() / total.w(), canvas.h() / total.h());
-
     return utils::Boxf(
-      -canvas.w() / 2.0f + dToLeft * canvas.w(),
-      -canvas.h() / 2.0f + dToBottom * canvas.h(),
-      area.w() * areaToResize.x(),
-      area.h() * areaToResize.y()
+      -canvas.w() / 2.0f + area.x() * canvas.w(),
+      -canvas.h() / 2.0f + area.y() * canvas.h(),
+      area.w() * canvas.w(),
+      area.h() * canvas.h()
     );
   }
 
@@ -238,12 +304,12 @@ namespace fractsim {
   }
 
   inline
-  utils::Vector2f
+  GMPVector2
   FractalRenderer::convertGlobalToRealWorld(const utils::Vector2f& global) {
     // Check if a rendering window is assigned.
     if (m_renderingOpt == nullptr) {
       // Return default coordinates.
-      return utils::Vector2f();
+      return GMPVector2();
     }
 
     // Map the position to local coordinate frame.
@@ -255,7 +321,7 @@ namespace fractsim {
     utils::Vector2f windowPerc(pos.x() / thisArea.w(), pos.y() / thisArea.h());
 
     // Convert using the dedicated handler.
-    utils::Vector2f conv = m_renderingOpt->getPointAt(windowPerc);
+    GMPVector2 conv = m_renderingOpt->getPointAt(windowPerc);
 
     // This is the corresponding real world position.
     return conv;
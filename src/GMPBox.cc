@@ -1,6 +1,117 @@
 
 # include "GMPBox.hh"
+# include <algorithm>
+# include <cmath>
+# include "GMPFloat.hh"
 
 namespace fractsim {
 
+  GMPVector2
+  GMPBox::getPointAt(const utils::Vector2f& p) const {
+    mpf_t px, py;
+    mpf_init2(px, getPrecision());
+    mpf_init2(py, getPrecision());
+
+    mpf_set_d(px, p.x());
+    mpf_mul(px, px, m_w);
+    mpf_add(px, px, m_x);
+
+    mpf_set_d(py, p.y());
+    mpf_mul(py, py, m_h);
+    mpf_add(py, py, m_y);
+
+    GMPVector2 out(px, py);
+
+    mpf_clear(px);
+    mpf_clear(py);
+
+    return out;
+  }
+
+  void
+  GMPBox::translate(const utils::Vector2f& motion) {
+    mpf_t tmp;
+    mpf_init2(tmp, getPrecision());
+
+    mpf_set_d(tmp, motion.x());
+    mpf_mul(tmp, tmp, m_w);
+    mpf_add(m_x, m_x, tmp);
+
+    mpf_set_d(tmp, motion.y());
+    mpf_mul(tmp, tmp, m_h);
+    mpf_add(m_y, m_y, tmp);
+
+    mpf_clear(tmp);
+  }
+
+  void
+  GMPBox::zoom(const GMPVector2& center,
+               float factor)
+  {
+    // Powers of two (which include the default zoom factors) are applied by
+    // shifting the exponent of the values: the dimensions are then scaled
+    // exactly and zooming in and out again restores them bit for bit.
+    int exponent = 0;
+    bool dyadic = (std::frexp(factor, &exponent) == 0.5f);
+    --exponent;
+
+    mpf_t f;
+    mpf_init2(f, getPrecision());
+    mpf_set_d(f, factor);
+
+    auto divide = [dyadic, exponent, &f](mpf_ptr value) {
+      if (!dyadic) {
+        mpf_div(value, value, f);
+      }
+      else if (exponent >= 0) {
+        mpf_div_2exp(value, value, static_cast<mp_bitcnt_t>(exponent));
+      }
+      else {
+        mpf_mul_2exp(value, value, static_cast<mp_bitcnt_t>(-exponent));
+      }
+    };
+
+    // The dimensions are updated first so that the precision can be
+    // adjusted before the center is moved.
+    divide(m_w);
+    divide(m_h);
+
+    adjustPrecision();
+
+    // The distance from the center of the box to the fixed point is
+    // reduced by the same factor as the dimensions. The subtraction
+    // and the addition are rounded to the precision of the box, which
+    // keeps a margin well below the size of the pixels.
+    mpf_sub(m_x, m_x, center.x());
+    divide(m_x);
+    mpf_add(m_x, m_x, center.x());
+
+    mpf_sub(m_y, m_y, center.y());
+    divide(m_y);
+    mpf_add(m_y, m_y, center.y());
+
+    mpf_clear(f);
+  }
+
+  void
+  GMPBox::adjustPrecision() {
+    // The bits of the dimensions are shifted by the gap between the
+    // exponent of the center and the one of the dimensions when they
+    // are added to each other.
+    long center = std::max(GMPFloat::getExponent(m_x), GMPFloat::getExponent(m_y));
+    long dims = std::min(GMPFloat::getExponent(m_w), GMPFloat::getExponent(m_h));
+
+    unsigned precision = static_cast<unsigned>(std::max(center - dims, 0l)) + getPrecisionMargin();
+    if (precision <= getPrecision()) {
+      return;
+    }
+
+    // Increasing the precision preserves the values.
+    mpf_set_prec(m_x, precision);
+    mpf_set_prec(m_y, precision);
+
+    mpf_set_prec(m_w, precision);
+    mpf_set_prec(m_h, precision);
+  }
+
 }
@@ -4,6 +4,9 @@
 # include <gmp.h>
 # include <memory>
 # include <maths_utils/Box.hh>
+# include <maths_utils/Size.hh>
+# include <maths_utils/Vector2.hh>
+# include "GMPVector2.hh"
 
 namespace fractsim {
 
@@ -22,31 +25,172 @@ namespace fractsim {
        */
       GMPBox(const utils::Boxf& box);
 
+      /**
+       * @brief - Create a copy of the input box with the same precision.
+       * @param rhs - the box to copy.
+       */
+      GMPBox(const GMPBox& rhs);
+
       /**
        * @brief - Desctruction of the object.
        */
       ~GMPBox();
 
+      /**
+       * @brief - Assign the values of the input box to this object. The precision
+       *          of this box is updated to match the one of `rhs`.
+       * @param rhs - the box to copy.
+       * @return - a reference to this object.
+       */
+      GMPBox&
+      operator=(const GMPBox& rhs);
+
       /**
        * @brief - Assign the internal description of this object with the values
-       *          from the input box.
-       *          Note that this method assumes that the internal gmp floats are
-       *          already assigned.
+       *          from the input box. The internal gmp floats are reused so that
+       *          no allocation is performed.
        * @param box - the object to use to assign internal values.
        */
       void
       setFromBox(const utils::Boxf& box);
 
+      /**
+       * @brief - Used to retrieve the coordinate of the center of this box along
+       *          the `x` axis. The value is returned as a pointer to the internal
+       *          number so that it can be used directly with the gmp functions.
+       * @return - a pointer to the abscissa of the center of the box.
+       */
+      mpf_srcptr
+      x() const noexcept;
+
+      /**
+       * @brief - Similar to `x` but for the ordinate of the center.
+       * @return - a pointer to the ordinate of the center of the box.
+       */
+      mpf_srcptr
+      y() const noexcept;
+
+      /**
+       * @brief - Similar to `x` but for the width of the box.
+       * @return - a pointer to the width of the box.
+       */
+      mpf_srcptr
+      w() const noexcept;
+
+      /**
+       * @brief - Similar to `x` but for the height of the box.
+       * @return - a pointer to the height of the box.
+       */
+      mpf_srcptr
+      h() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the precision of this box in bits.
+       * @return - the number of bits of the mantissa of the values of the box.
+       */
+      unsigned
+      getPrecision() const noexcept;
+
+      /**
+       * @brief - Returns the center of this box with the same precision.
+       * @return - the center of this box.
+       */
+      GMPVector2
+      getCenter() const;
+
+      /**
+       * @brief - Returns the point corresponding to the input percentage of this
+       *          box: the input range for each coordinate is `[-0.5; 0.5]` where
+       *          `-0.5` corresponds to the left (or bottom) bound of the box.
+       * @param p - the point in percentage to convert.
+       * @return - the corresponding point, with the precision of this box.
+       */
+      GMPVector2
+      getPointAt(const utils::Vector2f& p) const;
+
+      /**
+       * @brief - Converts this box to single precision. The position and the size
+       *          of the box are rounded (the size even vanishes at deep zoom levels)
+       *          which makes this only suited for display purposes.
+       * @return - an approximation of this box.
+       */
+      utils::Boxf
+      toBox() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the binary exponent of the largest dimension of the
+       *          box. Expressed in units of `2^scale`, the dimensions of the box are
+       *          close to `1` whatever the zoom level.
+       * @return - the scale of this box.
+       */
+      long
+      getScale() const noexcept;
+
+      /**
+       * @brief - Returns the dimensions of this box in single precision, expressed in
+       *          units of `2^scale`. Unlike the position, the dimensions do not lose
+       *          any relevant information as long as the scale is close to the one
+       *          of the box.
+       * @param scale - the binary exponent of the unit of the dimensions.
+       * @return - the dimensions of this box.
+       */
+      utils::Sizef
+      toSize(long scale) const noexcept;
+
+      /**
+       * @brief - Moves this box by the input offset. The offset is expressed as a
+       *          fraction of the dimensions of the box (similarly to `getPointAt`)
+       *          so that it does not depend on the zoom level.
+       * @param motion - the offset to apply to the center of the box.
+       */
+      void
+      translate(const utils::Vector2f& motion);
+
+      /**
+       * @brief - Scales this box by the input factor while keeping the `center` at
+       *          the same position. The precision of the box is increased when the
+       *          box gets small compared to its coordinates so that the center can
+       *          always be positioned accurately. Factors which are powers of two
+       *          scale the dimensions exactly.
+       * @param center - the point to fix when performing the zoom.
+       * @param factor - the ratio between the current size and the new size of
+       *                 the box.
+       */
+      void
+      zoom(const GMPVector2& center,
+           float factor);
+
     private:
 
       /**
-       * @brief - Reset or create the internal values to default numbers.
+       * @brief - Used to retrieve the number of bits kept in addition to the ones
+       *          needed to distinguish the dimensions of the box from its center.
+       *          This accounts for the subdivision of the box into pixels and the
+       *          successive translations.
+       * @return - the number of additional bits.
+       */
+      static
+      unsigned
+      getPrecisionMargin() noexcept;
+
+      /**
+       * @brief - Create the internal values with the input precision. This should
+       *          only be called once, before any other use of the gmp floats.
+       * @param precision - the precision of the internal values in bits.
+       */
+      void
+      reset(unsigned precision);
+
+      /**
+       * @brief - Used to increase the precision of the internal values so that the
+       *          dimensions of the box can be added to its center without loss. The
+       *          precision is never decreased.
        */
       void
-      reset();
+      adjustPrecision();
 
       /**
-       * @brief - Reset the values of the internal properties.
+       * @brief - Release the internal values. They should not be used afterwards.
        */
       void
       clear();
@@ -2,6 +2,8 @@
 # define   GMP_BOX_HXX
 
 # include "GMPBox.hh"
+# include <algorithm>
+# include "GMPFloat.hh"
 
 namespace fractsim {
 
@@ -13,7 +15,7 @@ namespace fractsim {
     m_w(),
     m_h()
   {
-    reset();
+    reset(mpf_get_default_prec());
     setFromBox(utils::Boxf());
   }
 
@@ -25,37 +27,140 @@ namespace fractsim {
     m_w(),
     m_h()
   {
-    reset();
+    reset(mpf_get_default_prec());
     setFromBox(box);
   }
 
+  inline
+  GMPBox::GMPBox(const GMPBox& rhs):
+    m_x(),
+    m_y(),
+
+    m_w(),
+    m_h()
+  {
+    reset(mpf_get_prec(rhs.m_x));
+
+    mpf_set(m_x, rhs.m_x);
+    mpf_set(m_y, rhs.m_y);
+
+    mpf_set(m_w, rhs.m_w);
+    mpf_set(m_h, rhs.m_h);
+  }
+
   inline
   GMPBox::~GMPBox() {
     // Clear the internal values.
     clear();
   }
 
+  inline
+  GMPBox&
+  GMPBox::operator=(const GMPBox& rhs) {
+    if (this == &rhs) {
+      return *this;
+    }
+
+    mpf_set_prec(m_x, rhs.getPrecision());
+    mpf_set_prec(m_y, rhs.getPrecision());
+
+    mpf_set_prec(m_w, rhs.getPrecision());
+    mpf_set_prec(m_h, rhs.getPrecision());
+
+    mpf_set(m_x, rhs.m_x);
+    mpf_set(m_y, rhs.m_y);
+
+    mpf_set(m_w, rhs.m_w);
+    mpf_set(m_h, rhs.m_h);
+
+    return *this;
+  }
+
   inline
   void
   GMPBox::setFromBox(const utils::Boxf& box) {
-    clear();
-    reset();
-
     mpf_set_d(m_x, box.x());
-    mpf_set_d(m_x, box.y());
+    mpf_set_d(m_y, box.y());
 
     mpf_set_d(m_w, box.w());
     mpf_set_d(m_h, box.h());
   }
 
+  inline
+  mpf_srcptr
+  GMPBox::x() const noexcept {
+    return m_x;
+  }
+
+  inline
+  mpf_srcptr
+  GMPBox::y() const noexcept {
+    return m_y;
+  }
+
+  inline
+  mpf_srcptr
+  GMPBox::w() const noexcept {
+    return m_w;
+  }
+
+  inline
+  mpf_srcptr
+  GMPBox::h() const noexcept {
+    return m_h;
+  }
+
+  inline
+  unsigned
+  GMPBox::getPrecision() const noexcept {
+    return static_cast<unsigned>(mpf_get_prec(m_x));
+  }
+
+  inline
+  GMPVector2
+  GMPBox::getCenter() const {
+    return GMPVector2(m_x, m_y);
+  }
+
+  inline
+  utils::Boxf
+  GMPBox::toBox() const noexcept {
+    return utils::Boxf(
+      static_cast<float>(mpf_get_d(m_x)),
+      static_cast<float>(mpf_get_d(m_y)),
+      toSize(0l)
+    );
+  }
+
+  inline
+  long
+  GMPBox::getScale() const noexcept {
+    return std::max(GMPFloat::getExponent(m_w), GMPFloat::getExponent(m_h));
+  }
+
+  inline
+  utils::Sizef
+  GMPBox::toSize(long scale) const noexcept {
+    return utils::Sizef(
+      static_cast<float>(GMPFloat::toDouble(m_w, scale)),
+      static_cast<float>(GMPFloat::toDouble(m_h, scale))
+    );
+  }
+
+  inline
+  unsigned
+  GMPBox::getPrecisionMargin() noexcept {
+    return 64u;
+  }
+
   inline
   void
-  GMPBox::reset() {
-    mpf_init(m_x);
-    mpf_init(m_y);
+  GMPBox::reset(unsigned precision) {
+    mpf_init2(m_x, precision);
+    mpf_init2(m_y, precision);
 
-    mpf_init(m_w);
-    mpf_init(m_h);
+    mpf_init2(m_w, precision);
+    mpf_init2(m_h, precision);
   }
 
   inline
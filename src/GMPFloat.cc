@@ -0,0 +1,132 @@
+
+# include "GMPFloat.hh"
+# include <algorithm>
+# include <cfloat>
+
+namespace fractsim {
+
+  namespace {
+
+    /**
+     * @brief - Used to compute the precision needed to hold the exact sum of the
+     *          input values: in addition to the bits of the operands, the gap
+     *          between their exponents should be accounted for.
+     * @param lhs - the first operand of the sum.
+     * @param rhs - the second operand of the sum.
+     * @return - the precision of the result in bits.
+     */
+    unsigned
+    getSumPrecision(const GMPFloat& lhs,
+                    const GMPFloat& rhs) noexcept
+    {
+      if (mpf_sgn(lhs.get()) == 0) {
+        return rhs.getPrecision();
+      }
+      if (mpf_sgn(rhs.get()) == 0) {
+        return lhs.getPrecision();
+      }
+
+      // The bits of the operand with the smallest exponent are shifted by
+      // the gap between the exponents, and one more bit may be needed for
+      // the carry.
+      long el = GMPFloat::getExponent(lhs.get());
+      long er = GMPFloat::getExponent(rhs.get());
+
+      long bits = std::max(
+        std::max(el, er) - std::min(el - lhs.getPrecision(), er - rhs.getPrecision()),
+        static_cast<long>(std::max(lhs.getPrecision(), rhs.getPrecision()))
+      );
+
+      return static_cast<unsigned>(bits) + 1u;
+    }
+
+  }
+
+  GMPFloat
+  operator-(const GMPFloat& value) {
+    GMPFloat out(value);
+    mpf_neg(out.get(), value.get());
+
+    return out;
+  }
+
+  GMPFloat
+  operator+(const GMPFloat& lhs,
+            const GMPFloat& rhs)
+  {
+    GMPFloat out;
+
+    mpf_set_prec(out.get(), getSumPrecision(lhs, rhs));
+    mpf_add(out.get(), lhs.get(), rhs.get());
+
+    return out;
+  }
+
+  GMPFloat
+  operator-(const GMPFloat& lhs,
+            const GMPFloat& rhs)
+  {
+    GMPFloat out;
+
+    mpf_set_prec(out.get(), getSumPrecision(lhs, rhs));
+    mpf_sub(out.get(), lhs.get(), rhs.get());
+
+    return out;
+  }
+
+  GMPFloat
+  operator*(const GMPFloat& lhs,
+            const GMPFloat& rhs)
+  {
+    GMPFloat out;
+
+    mpf_set_prec(out.get(), lhs.getPrecision() + rhs.getPrecision());
+    mpf_mul(out.get(), lhs.get(), rhs.get());
+
+    return out;
+  }
+
+  GMPFloat
+  operator*(const GMPFloat& lhs,
+            double rhs)
+  {
+    // A double only holds a few bits compared to the default precision
+    // so the product is computed with a dedicated precision.
+    mpf_t value;
+    mpf_init2(value, DBL_MANT_DIG);
+    mpf_set_d(value, rhs);
+
+    GMPFloat out;
+
+    mpf_set_prec(out.get(), lhs.getPrecision() + DBL_MANT_DIG);
+    mpf_mul(out.get(), lhs.get(), value);
+
+    mpf_clear(value);
+
+    return out;
+  }
+
+  GMPFloat
+  operator*(double lhs,
+            const GMPFloat& rhs)
+  {
+    return rhs * lhs;
+  }
+
+  GMPFloat
+  ldexp(const GMPFloat& value,
+        long exponent)
+  {
+    GMPFloat out(value);
+
+    if (exponent >= 0l) {
+      mpf_mul_2exp(out.get(), value.get(), static_cast<mp_bitcnt_t>(exponent));
+    }
+    else {
+      mpf_div_2exp(out.get(), value.get(), static_cast<mp_bitcnt_t>(-exponent));
+    }
+
+    return out;
+  }
+
+}
@@ -0,0 +1,183 @@
+#ifndef    GMP_FLOAT_HH
+# define   GMP_FLOAT_HH
+
+# include <gmp.h>
+# include "FixedPoint.hh"
+
+namespace fractsim {
+
+  /**
+   * @brief - A floating point value with arbitrary precision. This is a thin
+   *          wrapper around a gmp float which can be copied and used with the
+   *          usual arithmetic operators, so that it can describe the pixels to
+   *          compute just like any other scalar type.
+   *          Each operation allocates a new value: this is meant to describe
+   *          coordinates and should never be used in the inner loops of the
+   *          kernels, which should work directly on preallocated gmp floats.
+   *          The precision of the result of an operation is chosen so that no
+   *          bit of the operands is lost, which allows to add a small offset to
+   *          a large coordinate without rounding.
+   */
+  class GMPFloat {
+    public:
+
+      /**
+       * @brief - Create a `null` value with the default precision.
+       */
+      GMPFloat();
+
+      /**
+       * @brief - Create a value from a number of any arithmetic type. The value
+       *          is converted without loss for all the floating point types up to
+       *          the quadruple precision.
+       * @param value - the value to convert.
+       */
+      template <typename U>
+      explicit
+      GMPFloat(const U& value);
+
+      /**
+       * @brief - Create a value from a fixed point number. The precision is set
+       *          to the number of bits of the input so that it is converted exactly.
+       * @param value - the value to convert.
+       */
+      template <unsigned Limbs>
+      explicit
+      GMPFloat(const fixed::Number<Limbs>& value);
+
+      /**
+       * @brief - Create a value from the input gmp float, with the same precision.
+       * @param value - the value to copy.
+       */
+      explicit
+      GMPFloat(mpf_srcptr value);
+
+      /**
+       * @brief - Create a copy of the input value with the same precision.
+       * @param rhs - the value to copy.
+       */
+      GMPFloat(const GMPFloat& rhs);
+
+      /**
+       * @brief - Desctruction of the object.
+       */
+      ~GMPFloat();
+
+      /**
+       * @brief - Assign the input value to this object. The precision of this
+       *          value is updated to match the one of `rhs`.
+       * @param rhs - the value to copy.
+       * @return - a reference to this object.
+       */
+      GMPFloat&
+      operator=(const GMPFloat& rhs);
+
+      /**
+       * @brief - Converts this value to another floating point type. The value is
+       *          rounded to the precision of the output type.
+       * @return - the converted value.
+       */
+      template <typename U>
+      explicit
+      operator U() const;
+
+      /**
+       * @brief - Used to retrieve the internal number so that it can be used with
+       *          the gmp functions.
+       * @return - a pointer to the internal number.
+       */
+      mpf_srcptr
+      get() const noexcept;
+
+      mpf_ptr
+      get() noexcept;
+
+      /**
+       * @brief - Used to retrieve the precision of this value in bits.
+       * @return - the number of bits of the mantissa of this value.
+       */
+      unsigned
+      getPrecision() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the precision of the values created from a
+       *          native type: this is enough to hold a quadruple precision value.
+       * @return - the default precision in bits.
+       */
+      static
+      unsigned
+      getDefaultPrecision() noexcept;
+
+      /**
+       * @brief - Used to retrieve the exponent of the input value, i.e. the `e`
+       *          such that `2^(e - 1) <= |value| < 2^e`. A null value is assigned
+       *          an exponent of `0`.
+       * @param value - the value for which the exponent should be computed.
+       * @return - the exponent of the value.
+       */
+      static
+      long
+      getExponent(mpf_srcptr value) noexcept;
+
+      /**
+       * @brief - Used to convert the input value to double precision once divided
+       *          by `2^scale`. This allows to handle values out of the range of a
+       *          double, as long as they are expressed relatively to a scale close
+       *          to their magnitude.
+       * @param value - the value to convert.
+       * @param scale - the binary exponent of the unit in which the value should be
+       *                expressed.
+       * @return - the value in units of `2^scale`.
+       */
+      static
+      double
+      toDouble(mpf_srcptr value,
+               long scale) noexcept;
+
+    private:
+
+      /**
+       * @brief - The internal number.
+       */
+      mpf_t m_value;
+  };
+
+  GMPFloat
+  operator-(const GMPFloat& value);
+
+  GMPFloat
+  operator+(const GMPFloat& lhs,
+            const GMPFloat& rhs);
+
+  GMPFloat
+  operator-(const GMPFloat& lhs,
+            const GMPFloat& rhs);
+
+  GMPFloat
+  operator*(const GMPFloat& lhs,
+            const GMPFloat& rhs);
+
+  GMPFloat
+  operator*(const GMPFloat& lhs,
+            double rhs);
+
+  GMPFloat
+  operator*(double lhs,
+            const GMPFloat& rhs);
+
+  /**
+   * @brief - Multiplies the input value by `2^exponent`. The result is exact and
+   *          keeps the precision of the input value.
+   * @param value - the value to scale.
+   * @param exponent - the power of two to apply.
+   * @return - the scaled value.
+   */
+  GMPFloat
+  ldexp(const GMPFloat& value,
+        long exponent);
+
+}
+
+# include "GMPFloat.hxx"
+
+#endif    /* GMP_FLOAT_HH */
@@ -0,0 +1,189 @@
+#ifndef    GMP_FLOAT_HXX
+# define   GMP_FLOAT_HXX
+
+# include "GMPFloat.hh"
+# include <algorithm>
+# include <cmath>
+
+namespace fractsim {
+
+  inline
+  GMPFloat::GMPFloat():
+    m_value()
+  {
+    mpf_init2(m_value, getDefaultPrecision());
+  }
+
+  template <typename U>
+  inline
+  GMPFloat::GMPFloat(const U& value):
+    m_value()
+  {
+    mpf_init2(m_value, getDefaultPrecision());
+
+    // GMP can only be fed with double precision values: three of them
+    // are enough to hold the mantissa of the widest supported type as
+    // each one holds the rounding error of the previous ones.
+    double hi = static_cast<double>(value);
+    U remainder = value - static_cast<U>(hi);
+    double mid = static_cast<double>(remainder);
+    double lo = static_cast<double>(remainder - static_cast<U>(mid));
+
+    mpf_set_d(m_value, hi);
+
+    if (mid != 0.0) {
+      mpf_t part;
+      mpf_init2(part, getDefaultPrecision());
+
+      mpf_set_d(part, mid);
+      mpf_add(m_value, m_value, part);
+
+      mpf_set_d(part, lo);
+      mpf_add(m_value, m_value, part);
+
+      mpf_clear(part);
+    }
+  }
+
+  template <unsigned Limbs>
+  inline
+  GMPFloat::GMPFloat(const fixed::Number<Limbs>& value):
+    m_value()
+  {
+    mpf_init2(m_value, 64u * Limbs);
+
+    // Accumulate the limbs of the magnitude from the most significant one
+    // and scale the result by the resolution of the fixed point value.
+    const fixed::Number<Limbs> magnitude = value.isNegative() ? -value : value;
+
+    for (unsigned id = Limbs ; id > 0u ; --id) {
+      mpf_mul_2exp(m_value, m_value, 64u);
+      mpf_add_ui(m_value, m_value, static_cast<unsigned long>(magnitude.limbs[id - 1u]));
+    }
+
+    mpf_div_2exp(m_value, m_value, fixed::Number<Limbs>::getFractionalBits());
+
+    if (value.isNegative()) {
+      mpf_neg(m_value, m_value);
+    }
+  }
+
+  inline
+  GMPFloat::GMPFloat(mpf_srcptr value):
+    m_value()
+  {
+    mpf_init2(m_value, mpf_get_prec(value));
+    mpf_set(m_value, value);
+  }
+
+  inline
+  GMPFloat::GMPFloat(const GMPFloat& rhs):
+    m_value()
+  {
+    mpf_init2(m_value, rhs.getPrecision());
+    mpf_set(m_value, rhs.m_value);
+  }
+
+  inline
+  GMPFloat::~GMPFloat() {
+    mpf_clear(m_value);
+  }
+
+  inline
+  GMPFloat&
+  GMPFloat::operator=(const GMPFloat& rhs) {
+    if (this != &rhs) {
+      mpf_set_prec(m_value, rhs.getPrecision());
+      mpf_set(m_value, rhs.m_value);
+    }
+
+    return *this;
+  }
+
+  template <typename U>
+  inline
+  GMPFloat::operator U() const {
+    // Similarly to the construction, the value is split into several
+    // double precision values so that no bit is lost for wide types.
+    mpf_t remainder, part;
+    mpf_init2(remainder, getPrecision());
+    mpf_init2(part, getDefaultPrecision());
+
+    mpf_set(remainder, m_value);
+
+    U out = static_cast<U>(0);
+
+    for (unsigned id = 0u ; id < 3u ; ++id) {
+      double d = mpf_get_d(remainder);
+      out += static_cast<U>(d);
+
+      mpf_set_d(part, d);
+      mpf_sub(remainder, remainder, part);
+    }
+
+    mpf_clear(remainder);
+    mpf_clear(part);
+
+    return out;
+  }
+
+  inline
+  mpf_srcptr
+  GMPFloat::get() const noexcept {
+    return m_value;
+  }
+
+  inline
+  mpf_ptr
+  GMPFloat::get() noexcept {
+    return m_value;
+  }
+
+  inline
+  unsigned
+  GMPFloat::getPrecision() const noexcept {
+    return static_cast<unsigned>(mpf_get_prec(m_value));
+  }
+
+  inline
+  unsigned
+  GMPFloat::getDefaultPrecision() noexcept {
+    return 128u;
+  }
+
+  inline
+  long
+  GMPFloat::getExponent(mpf_srcptr value) noexcept {
+    if (mpf_sgn(value) == 0) {
+      return 0l;
+    }
+
+    long exp = 0l;
+    mpf_get_d_2exp(&exp, value);
+
+    return exp;
+  }
+
+  inline
+  double
+  GMPFloat::toDouble(mpf_srcptr value,
+                     long scale) noexcept
+  {
+    if (mpf_sgn(value) == 0) {
+      return 0.0;
+    }
+
+    // The mantissa is extracted separately so that the exponent of the value
+    // does not need to fit in a double. The shift is clamped to a range where
+    // `ldexp` already saturates.
+    long exp = 0l;
+    double mantissa = mpf_get_d_2exp(&exp, value);
+
+    long shift = std::clamp(exp - scale, -4096l, 4096l);
+
+    return std::ldexp(mantissa, static_cast<int>(shift));
+  }
+
+}
+
+#endif    /* GMP_FLOAT_HXX */
@@ -1,6 +1,26 @@
 
 # include "GMPVector2.hh"
+# include <algorithm>
+# include "GMPFloat.hh"
 
 namespace fractsim {
 
+  void
+  GMPVector2::getOffset(const GMPVector2& origin,
+                        long scale,
+                        double& dx,
+                        double& dy) const noexcept
+  {
+    mpf_t tmp;
+    mpf_init2(tmp, std::max(getPrecision(), origin.getPrecision()));
+
+    mpf_sub(tmp, m_x, origin.m_x);
+    dx = GMPFloat::toDouble(tmp, scale);
+
+    mpf_sub(tmp, m_y, origin.m_y);
+    dy = GMPFloat::toDouble(tmp, scale);
+
+    mpf_clear(tmp);
+  }
+
 }
@@ -22,31 +22,104 @@ namespace fractsim {
        */
       GMPVector2(const utils::Vector2f& vec);
 
+      /**
+       * @brief - Create a vector from the input gmp floats. The precision of the
+       *          vector is large enough to hold both coordinates without loss.
+       * @param x - the `x` coordinate of the vector.
+       * @param y - the `y` coordinate of the vector.
+       */
+      GMPVector2(mpf_srcptr x,
+                 mpf_srcptr y);
+
+      /**
+       * @brief - Create a copy of the input vector with the same precision.
+       * @param rhs - the vector to copy.
+       */
+      GMPVector2(const GMPVector2& rhs);
+
       /**
        * @brief - Desctruction of the object.
        */
       ~GMPVector2();
 
+      /**
+       * @brief - Assign the values of the input vector to this object. The precision
+       *          of this vector is updated to match the one of `rhs`.
+       * @param rhs - the vector to copy.
+       * @return - a reference to this object.
+       */
+      GMPVector2&
+      operator=(const GMPVector2& rhs);
+
       /**
        * @brief - Assign the internal description of this object with the values
-       *          from the input vector.
-       *          Note that this method assumes that the internal gmp floats are
-       *          already assigned.
+       *          from the input vector. The internal gmp floats are reused so that
+       *          no allocation is performed.
        * @param vec - the object to use to assign internal values.
        */
       void
       setFromVector(const utils::Vector2f& vec);
 
+      /**
+       * @brief - Used to retrieve the `x` coordinate of this vector. The value is
+       *          returned as a pointer to the internal number so that it can be
+       *          used directly with the gmp functions.
+       * @return - a pointer to the `x` coordinate of this vector.
+       */
+      mpf_srcptr
+      x() const noexcept;
+
+      /**
+       * @brief - Similar to `x` but for the `y` coordinate.
+       * @return - a pointer to the `y` coordinate of this vector.
+       */
+      mpf_srcptr
+      y() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the precision of this vector in bits.
+       * @return - the number of bits of the mantissa of the coordinates.
+       */
+      unsigned
+      getPrecision() const noexcept;
+
+      /**
+       * @brief - Converts this vector to single precision. The coordinates are
+       *          rounded which makes this only suited for display purposes.
+       * @return - an approximation of this vector.
+       */
+      utils::Vector2f
+      toVector() const noexcept;
+
+      /**
+       * @brief - Computes the offset of this vector relatively to the input origin.
+       *          The subtraction is performed with the precision of the vectors so
+       *          that the offset is accurate even when both are very close, and it
+       *          is expressed in units of `2^scale` so that it can be represented
+       *          in double precision whatever its magnitude.
+       * @param origin - the origin to which the offset is computed.
+       * @param scale - the binary exponent of the unit of the offset.
+       * @param dx - output value receiving the offset along the `x` axis.
+       * @param dy - output value receiving the offset along the `y` axis.
+       */
+      void
+      getOffset(const GMPVector2& origin,
+                long scale,
+                double& dx,
+                double& dy) const noexcept;
+
     private:
 
       /**
-       * @brief - Reset or create the internal values to default numbers.
+       * @brief - Create the internal values with the input precision. This should
+       *          only be called once, before any other use of the gmp floats.
+       * @param precision - the precision of the internal values in bits.
        */
       void
-      reset();
+      reset(unsigned precision);
 
       /**
-       * @brief - Reset the values of the internal properties.
+       * @brief - Release the internal values. They should not be used afterwards.
        */
       void
       clear();
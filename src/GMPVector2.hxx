@@ -2,6 +2,7 @@
 # define   GMP_VECTOR2_HXX
 
 # include "GMPVector2.hh"
+# include <algorithm>
 
 namespace fractsim {
 
@@ -10,7 +11,7 @@ namespace fractsim {
     m_x(),
     m_y()
   {
-    reset();
+    reset(mpf_get_default_prec());
     setFromVector(utils::Vector2f());
   }
 
@@ -19,30 +20,93 @@ namespace fractsim {
     m_x(),
     m_y()
   {
-    reset();
+    reset(mpf_get_default_prec());
     setFromVector(vec);
   }
 
+  inline
+  GMPVector2::GMPVector2(mpf_srcptr x,
+                         mpf_srcptr y):
+    m_x(),
+    m_y()
+  {
+    reset(std::max(mpf_get_prec(x), mpf_get_prec(y)));
+
+    mpf_set(m_x, x);
+    mpf_set(m_y, y);
+  }
+
+  inline
+  GMPVector2::GMPVector2(const GMPVector2& rhs):
+    m_x(),
+    m_y()
+  {
+    reset(mpf_get_prec(rhs.m_x));
+
+    mpf_set(m_x, rhs.m_x);
+    mpf_set(m_y, rhs.m_y);
+  }
+
   inline
   GMPVector2::~GMPVector2() {
     clear();
   }
 
+  inline
+  GMPVector2&
+  GMPVector2::operator=(const GMPVector2& rhs) {
+    if (this == &rhs) {
+      return *this;
+    }
+
+    mpf_set_prec(m_x, mpf_get_prec(rhs.m_x));
+    mpf_set_prec(m_y, mpf_get_prec(rhs.m_x));
+
+    mpf_set(m_x, rhs.m_x);
+    mpf_set(m_y, rhs.m_y);
+
+    return *this;
+  }
+
   inline
   void
   GMPVector2::setFromVector(const utils::Vector2f& vec) {
-    clear();
-    reset();
-
     mpf_set_d(m_x, vec.x());
     mpf_set_d(m_y, vec.y());
   }
 
+  inline
+  mpf_srcptr
+  GMPVector2::x() const noexcept {
+    return m_x;
+  }
+
+  inline
+  mpf_srcptr
+  GMPVector2::y() const noexcept {
+    return m_y;
+  }
+
+  inline
+  unsigned
+  GMPVector2::getPrecision() const noexcept {
+    return static_cast<unsigned>(mpf_get_prec(m_x));
+  }
+
+  inline
+  utils::Vector2f
+  GMPVector2::toVector() const noexcept {
+    return utils::Vector2f(
+      static_cast<float>(mpf_get_d(m_x)),
+      static_cast<float>(mpf_get_d(m_y))
+    );
+  }
+
   inline
   void
-  GMPVector2::reset() {
-    mpf_init(m_x);
-    mpf_init(m_y);
+  GMPVector2::reset(unsigned precision) {
+    mpf_init2(m_x, precision);
+    mpf_init2(m_y, precision);
   }
 
   inline
@@ -3,6 +3,8 @@
 
 # include <memory>
 # include "FractalOptions.hh"
+# include "EscapeTimeKernel.hh"
+# include "ArbitraryKernel.hh"
 # include <maths_utils/Vector2.hh>
 
 namespace fractsim {
@@ -48,6 +50,97 @@ namespace fractsim {
       void
       setConstant(const utils::Vector2f& constant) noexcept;
 
+      bool
+      getPeriodicityCheck() const noexcept;
+
+      /**
+       * @brief - Used to enable or disable the detection of periodic orbits. When
+       *          enabled, the series computed for each point is checked for cycles
+       *          and the point is considered part of the set as soon as one term is
+       *          repeated, instead of iterating up to the accuracy.
+       * @param enabled - `true` to enable the detection of periodic orbits.
+       */
+      void
+      setPeriodicityCheck(bool enabled) noexcept;
+
+      bool
+      getLaneRefill() const noexcept;
+
+      /**
+       * @brief - Used to select how the kernels schedule the pixels on the lanes of
+       *          the vector units. When enabled, a lane whose pixel is done picks up
+       *          the next pending pixel instead of idling until all the pixels of
+       *          its packet are done. This mostly helps for large accuracies where
+       *          neighbouring pixels need very different numbers of terms, while
+       *          the bookkeeping slightly slows down the cheapest renderings.
+       * @param enabled - `true` to refill the lanes as soon as they are done.
+       */
+      void
+      setLaneRefill(bool enabled) noexcept;
+
+      bool
+      getChunkedBailout() const noexcept;
+
+      /**
+       * @brief - Used to select how often the kernels check whether the series of
+       *          the pixels of a packet ended. When enabled, the iterations are run
+       *          in chunks and the status of the lanes is only checked at the end of
+       *          each chunk, which is rolled back if a lane stopped in between. This
+       *          saves most of the checks on long series.
+       * @param enabled - `true` to check the lanes after chunks of iterations.
+       */
+      void
+      setChunkedBailout(bool enabled) noexcept;
+
+      /**
+       * @brief - Specialization of the base class to indicate that the Julia sets can
+       *          be computed with any of the precisions supported by the kernels.
+       * @return - the maximum precision supported by the Julia sets.
+       */
+      scalar::Precision
+      getMaximumPrecision() const noexcept override;
+
+      /**
+       * @brief - Specialization of the base class for the escape-time series: the
+       *          smoothed values of the escaping points vary continuously within
+       *          the regions they form, so only the points of the Julia set (with
+       *          the maximum confidence) are considered to belong to a class.
+       * @param lhs - the confidence of the first point.
+       * @param rhs - the confidence of the second point.
+       * @return - `true` if both points belong to the Julia set.
+       */
+      bool
+      isSameClass(float lhs,
+                  float rhs) const noexcept override;
+
+    protected:
+
+      /**
+       * @brief - Specialization of the base class to process a whole block of points
+       *          at once through the escape-time kernels: the block is forwarded to
+       *          `processBlock` whatever its precision.
+       * @param block - the block of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      void
+      computeBlockPrivate(scalar::AnyOf<kernels::PixelBlock> block,
+                          float* out,
+                          RenderingStatistics& stats) const noexcept override;
+
+      /**
+       * @brief - Specialization of the base class to process a list of points at
+       *          once through the escape-time kernels. Just like for the blocks, the
+       *          points are forwarded to `processPoints`.
+       * @param points - the list of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      void
+      computePointsPrivate(scalar::AnyOf<kernels::PointList> points,
+                           float* out,
+                           RenderingStatistics& stats) const noexcept override;
+
     private:
 
       /**
@@ -81,6 +174,53 @@ namespace fractsim {
       float
       getDefaultExponent() noexcept;
 
+      /**
+       * @brief - Used to convert the number of terms computed for a point and the
+       *          squared modulus of the last term into a smoothed and wrapped value
+       *          suitable to be used in the palette.
+       * @param terms - the number of terms computed for the point.
+       * @param len - the squared modulus of the last term of the series.
+       * @return - the confidence associated to the point.
+       */
+      float
+      smooth(unsigned terms,
+             float len) const noexcept;
+
+      /**
+       * @brief - Used to gather the parameters to provide to the kernels in order
+       *          to reproduce the computations of the `compute` method.
+       * @param step - the size of the pixels to compute, used to adapt the
+       *               tolerance of the periodicity detection.
+       * @return - the parameters of the series.
+       */
+      kernels::EscapeTimeParams
+      getKernelParams(double step) const noexcept;
+
+      /**
+       * @brief - Computes a block of points with the kernel instantiated for the
+       *          input scalar type.
+       * @param block - the block of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Scalar>
+      void
+      processBlock(const kernels::PixelBlock<Scalar>& block,
+                   float* out,
+                   RenderingStatistics& stats) const noexcept;
+
+      /**
+       * @brief - Similar to `processBlock` but computes a list of points.
+       * @param points - the list of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Scalar>
+      void
+      processPoints(const kernels::PointList<Scalar>& points,
+                    float* out,
+                    RenderingStatistics& stats) const noexcept;
+
     private:
 
       /**
@@ -90,6 +230,24 @@ namespace fractsim {
        *          any set.
        */
       utils::Vector2f m_constant;
+
+      /**
+       * @brief - Whether the orbit of each point should be checked for cycles so that
+       *          the points of the set can be detected before reaching the accuracy.
+       */
+      bool m_periodicity;
+
+      /**
+       * @brief - Whether the lanes of the vector units should be refilled with a new
+       *          pixel as soon as their pixel is done.
+       */
+      bool m_refill;
+
+      /**
+       * @brief - Whether the kernels should iterate in chunks before checking the
+       *          status of the lanes.
+       */
+      bool m_chunks;
   };
 
   using JuliaRenderingOptionsShPtr = std::shared_ptr<JuliaRenderingOptions>;
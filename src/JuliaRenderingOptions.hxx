@@ -2,7 +2,9 @@
 # define   JULIA_RENDERING_OPTIONS_HXX
 
 # include "JuliaRenderingOptions.hh"
+# include <algorithm>
 # include <complex>
+# include <vector>
 
 namespace fractsim {
 
@@ -12,7 +14,10 @@ namespace fractsim {
                    getDefaultPaletteWrapping(),
                    getDefaultPalette()),
 
-    m_constant(constant)
+    m_constant(constant),
+    m_periodicity(true),
+    m_refill(true),
+    m_chunks(true)
   {}
 
   inline
@@ -34,6 +39,13 @@ namespace fractsim {
     utils::Vector2f cur = p;
     utils::Vector2f c = getConstant();
 
+    // The reference term used to detect periodic orbits is refreshed each
+    // time the number of terms reaches a power of two (Brent's method).
+    bool periodicity = getPeriodicityCheck();
+    double tolerance = getPeriodicityTolerance(p);
+    utils::Vector2f ref = cur;
+    unsigned checkpoint = 1u;
+
     while ((len < thresh && terms < acc) || terms - conv < over) {
       tmp = cur.x() * cur.x() - cur.y() * cur.y() + c.x();
       cur.y() = 2.0f * cur.x() * cur.y() + c.y();
@@ -44,8 +56,84 @@ namespace fractsim {
         conv = terms;
       }
       ++terms;
+
+      if (periodicity && len < thresh) {
+        if (static_cast<double>((cur - ref).lengthSquared()) < tolerance) {
+          return smooth(std::max(acc, over), len);
+        }
+
+        if (terms == checkpoint) {
+          ref = cur;
+          checkpoint *= 2u;
+        }
+      }
     }
 
+    return smooth(terms, len);
+  }
+
+  inline
+  scalar::Precision
+  JuliaRenderingOptions::getMaximumPrecision() const noexcept {
+    return scalar::Precision::Arbitrary;
+  }
+
+  inline
+  bool
+  JuliaRenderingOptions::isSameClass(float lhs,
+                                     float rhs) const noexcept
+  {
+    // The points of the set reach the accuracy, which is above any wrapped
+    // value once clamped.
+    return lhs >= 1.0f && rhs >= 1.0f;
+  }
+
+  inline
+  void
+  JuliaRenderingOptions::computeBlockPrivate(scalar::AnyOf<kernels::PixelBlock> block,
+                                             float* out,
+                                             RenderingStatistics& stats) const noexcept
+  {
+    std::visit(
+      [this, out, &stats](const auto* values) {
+        processBlock(*values, out, stats);
+      },
+      block
+    );
+  }
+
+  inline
+  void
+  JuliaRenderingOptions::computePointsPrivate(scalar::AnyOf<kernels::PointList> points,
+                                              float* out,
+                                              RenderingStatistics& stats) const noexcept
+  {
+    std::visit(
+      [this, out, &stats](const auto* values) {
+        processPoints(*values, out, stats);
+      },
+      points
+    );
+  }
+
+  inline
+  kernels::EscapeTimeParams
+  JuliaRenderingOptions::getKernelParams(double step) const noexcept {
+    return kernels::EscapeTimeParams{
+      getAccuracy(),
+      getSmoothingOvershoot(),
+      getDivergenceThreshold(),
+      getPeriodicityCheck() ? getPeriodicityTolerance(step) : 0.0,
+      getLaneRefill(),
+      getChunkedBailout()
+    };
+  }
+
+  inline
+  float
+  JuliaRenderingOptions::smooth(unsigned terms,
+                                float len) const noexcept
+  {
     // Smooth the iterations count with some mathematical magic.
     // Resources: http://www.fractalforums.com/programming/julia-smooth-colouring-how-to-do/
     // Note that some information was found here to complement what is explained in the post:
@@ -53,7 +141,7 @@ namespace fractsim {
     // But it didn't work out and we resorted to use the same algorithm as used in the Mandelbrot
     // case.
     float sTerms = 1.0f * terms;
-    if (terms < acc) {
+    if (terms < getAccuracy()) {
       // Compute the smoothed iteration count.
       sTerms = terms + 1.0f - std::log(std::log(std::sqrt(len))) / std::log(getDefaultExponent());
 
@@ -64,6 +152,44 @@ namespace fractsim {
     return sTerms;
   }
 
+  template <typename Scalar>
+  inline
+  void
+  JuliaRenderingOptions::processBlock(const kernels::PixelBlock<Scalar>& block,
+                                      float* out,
+                                      RenderingStatistics& stats) const noexcept
+  {
+    std::vector<unsigned> terms(block.w * block.h, 0u);
+    utils::Vector2f c = getConstant();
+    double step = std::min(static_cast<double>(block.stepX), static_cast<double>(block.stepY));
+
+    // The output array is used to hold the squared modulus produced by the
+    // kernel: they are then converted in place to smoothed values.
+    kernels::julia(block, c.x(), c.y(), getKernelParams(step), terms.data(), out, stats);
+
+    for (unsigned id = 0u ; id < terms.size() ; ++id) {
+      out[id] = smooth(terms[id], out[id]);
+    }
+  }
+
+  template <typename Scalar>
+  inline
+  void
+  JuliaRenderingOptions::processPoints(const kernels::PointList<Scalar>& points,
+                                       float* out,
+                                       RenderingStatistics& stats) const noexcept
+  {
+    std::vector<unsigned> terms(points.count, 0u);
+    utils::Vector2f c = getConstant();
+    double step = std::min(static_cast<double>(points.stepX), static_cast<double>(points.stepY));
+
+    kernels::julia(points, c.x(), c.y(), getKernelParams(step), terms.data(), out, stats);
+
+    for (unsigned id = 0u ; id < points.count ; ++id) {
+      out[id] = smooth(terms[id], out[id]);
+    }
+  }
+
   inline
   utils::Vector2f
   JuliaRenderingOptions::getConstant() const noexcept {
@@ -76,6 +202,42 @@ namespace fractsim {
     m_constant = constant;
   }
 
+  inline
+  bool
+  JuliaRenderingOptions::getPeriodicityCheck() const noexcept {
+    return m_periodicity;
+  }
+
+  inline
+  void
+  JuliaRenderingOptions::setPeriodicityCheck(bool enabled) noexcept {
+    m_periodicity = enabled;
+  }
+
+  inline
+  bool
+  JuliaRenderingOptions::getLaneRefill() const noexcept {
+    return m_refill;
+  }
+
+  inline
+  void
+  JuliaRenderingOptions::setLaneRefill(bool enabled) noexcept {
+    m_refill = enabled;
+  }
+
+  inline
+  bool
+  JuliaRenderingOptions::getChunkedBailout() const noexcept {
+    return m_chunks;
+  }
+
+  inline
+  void
+  JuliaRenderingOptions::setChunkedBailout(bool enabled) noexcept {
+    m_chunks = enabled;
+  }
+
   inline
   float
   JuliaRenderingOptions::getDivergenceThreshold() noexcept {
@@ -0,0 +1,343 @@
+
+# include "KernelDispatch.hh"
+# include <cstdlib>
+# include "EscapeTimeKernel.hh"
+# include "NewtonKernel.hh"
+# include "PerturbationKernel.hh"
+# include "ScalarPrecision.hh"
+
+# ifdef FRACTSIM_KERNELS_DISPATCH
+
+// Declares the kernels of a variant: they follow the public interface of the
+// kernels, but in the namespace of the variant.
+#  define FRACTSIM_KERNELS_DECLARE(variant)                                                               \
+  namespace fractsim {                                                                                    \
+    namespace kernels::variant {                                                                          \
+      bool supportsExponent(float) noexcept;                                                              \
+      bool supportsPolarExponent(float) noexcept;                                                         \
+      void multibrot(const PixelBlock<float>&, float, const EscapeTimeParams&,                            \
+                     unsigned*, float*, RenderingStatistics&) noexcept;                                   \
+      void multibrot(const PointList<float>&, float, const EscapeTimeParams&,                             \
+                     unsigned*, float*, RenderingStatistics&) noexcept;                                   \
+      template <typename Scalar>                                                                          \
+      void mandelbrot(const PixelBlock<Scalar>&, unsigned, const EscapeTimeParams&,                       \
+                      unsigned*, float*, RenderingStatistics&) noexcept;                                  \
+      template <typename Scalar>                                                                          \
+      void mandelbrot(const PointList<Scalar>&, unsigned, const EscapeTimeParams&,                        \
+                      unsigned*, float*, RenderingStatistics&) noexcept;                                  \
+      template <typename Scalar>                                                                          \
+      void julia(const PixelBlock<Scalar>&, float, float, const EscapeTimeParams&,                        \
+                 unsigned*, float*, RenderingStatistics&) noexcept;                                       \
+      template <typename Scalar>                                                                          \
+      void julia(const PointList<Scalar>&, float, float, const EscapeTimeParams&,                         \
+                 unsigned*, float*, RenderingStatistics&) noexcept;                                       \
+      void newton(const PixelBlock<float>&, const NewtonPolynom&, const NewtonParams&,                    \
+                  unsigned*, float*, float*, RenderingStatistics&) noexcept;                              \
+      void newton(const PointList<float>&, const NewtonPolynom&, const NewtonParams&,                     \
+                  unsigned*, float*, float*, RenderingStatistics&) noexcept;                              \
+      void perturbation(const DeltaList&, const ReferenceData&, const SeriesData&,                        \
+                        const PerturbationParams&, unsigned*, float*, int*, RenderingStatistics&) noexcept; \
+    }                                                                                                     \
+  }
+
+FRACTSIM_KERNELS_DECLARE(sse4_2)
+FRACTSIM_KERNELS_DECLARE(avx2)
+FRACTSIM_KERNELS_DECLARE(avx512)
+
+namespace fractsim {
+  namespace kernels {
+    namespace {
+
+      /**
+       * @brief - The instruction sets for which the kernels are built. Each one
+       *          matches one of the micro-architecture levels of x86-64.
+       */
+      enum class Variant {
+        Sse42,
+        Avx2,
+        Avx512
+      };
+
+      /**
+       * @brief - Used to determine the variant of the kernels to use on the host:
+       *          this is the one forced through the environment if the host can
+       *          run it, and the best one supported by the host otherwise. Note
+       *          that the lowest variant is used as a fallback even if the host
+       *          does not support it, as there's no alternative.
+       * @return - the variant of the kernels to use.
+       */
+      Variant
+      detect() noexcept {
+        __builtin_cpu_init();
+
+        const bool avx512 = __builtin_cpu_supports("x86-64-v4");
+        const bool avx2 = avx512 || __builtin_cpu_supports("x86-64-v3");
+
+        const char* forced = std::getenv("FRACTSIM_KERNELS");
+        if (forced != nullptr) {
+          const std::string name(forced);
+
+          if (name == "sse4.2") {
+            return Variant::Sse42;
+          }
+          if (name == "avx2" && avx2) {
+            return Variant::Avx2;
+          }
+          if (name == "avx512" && avx512) {
+            return Variant::Avx512;
+          }
+        }
+
+        if (avx512) {
+          return Variant::Avx512;
+        }
+        if (avx2) {
+          return Variant::Avx2;
+        }
+
+        return Variant::Sse42;
+      }
+
+      /**
+       * @brief - Used to retrieve the variant of the kernels used by the program.
+       *          It is determined once and for all the first time it is needed.
+       * @return - the variant of the kernels to use.
+       */
+      Variant
+      getVariant() noexcept {
+        static const Variant variant = detect();
+        return variant;
+      }
+
+      /**
+       * @brief - Selects the version of a kernel matching the variant to use.
+       * @param sse42 - the version of the kernel built for SSE 4.2.
+       * @param avx2 - the version of the kernel built for AVX2.
+       * @param avx512 - the version of the kernel built for AVX-512.
+       * @return - the version of the kernel to call.
+       */
+      template <typename Kernel>
+      inline
+      Kernel
+      select(Kernel sse42,
+             Kernel avx2,
+             Kernel avx512) noexcept
+      {
+        switch (getVariant()) {
+          case Variant::Avx512:
+            return avx512;
+          case Variant::Avx2:
+            return avx2;
+          case Variant::Sse42:
+          default:
+            return sse42;
+        }
+      }
+
+    }
+
+    std::string
+    getVariantName() {
+      switch (getVariant()) {
+        case Variant::Avx512:
+          return "avx512";
+        case Variant::Avx2:
+          return "avx2";
+        case Variant::Sse42:
+        default:
+          return "sse4.2";
+      }
+    }
+
+  }
+
+  namespace kernels::inline FRACTSIM_KERNELS_VARIANT {
+
+    bool
+    supportsExponent(float exponent) noexcept {
+      using Kernel = bool (*)(float) noexcept;
+      return select<Kernel>(sse4_2::supportsExponent, avx2::supportsExponent, avx512::supportsExponent)(exponent);
+    }
+
+    bool
+    supportsPolarExponent(float exponent) noexcept {
+      using Kernel = bool (*)(float) noexcept;
+      return select<Kernel>(sse4_2::supportsPolarExponent, avx2::supportsPolarExponent, avx512::supportsPolarExponent)(exponent);
+    }
+
+    void
+    multibrot(const PixelBlock<float>& block,
+              float exponent,
+              const EscapeTimeParams& params,
+              unsigned* terms,
+              float* lens,
+              RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const PixelBlock<float>&, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::multibrot, avx2::multibrot, avx512::multibrot)(block, exponent, params, terms, lens, stats);
+    }
+
+    void
+    multibrot(const PointList<float>& points,
+              float exponent,
+              const EscapeTimeParams& params,
+              unsigned* terms,
+              float* lens,
+              RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const PointList<float>&, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::multibrot, avx2::multibrot, avx512::multibrot)(points, exponent, params, terms, lens, stats);
+    }
+
+    template <typename Scalar>
+    void
+    mandelbrot(const PixelBlock<Scalar>& block,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const PixelBlock<Scalar>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::mandelbrot, avx2::mandelbrot, avx512::mandelbrot)(block, exponent, params, terms, lens, stats);
+    }
+
+    template <typename Scalar>
+    void
+    mandelbrot(const PointList<Scalar>& points,
+               unsigned exponent,
+               const EscapeTimeParams& params,
+               unsigned* terms,
+               float* lens,
+               RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const PointList<Scalar>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::mandelbrot, avx2::mandelbrot, avx512::mandelbrot)(points, exponent, params, terms, lens, stats);
+    }
+
+    template <typename Scalar>
+    void
+    julia(const PixelBlock<Scalar>& block,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const PixelBlock<Scalar>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::julia, avx2::julia, avx512::julia)(block, cx, cy, params, terms, lens, stats);
+    }
+
+    template <typename Scalar>
+    void
+    julia(const PointList<Scalar>& points,
+          float cx,
+          float cy,
+          const EscapeTimeParams& params,
+          unsigned* terms,
+          float* lens,
+          RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const PointList<Scalar>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::julia, avx2::julia, avx512::julia)(points, cx, cy, params, terms, lens, stats);
+    }
+
+    void
+    newton(const PixelBlock<float>& block,
+           const NewtonPolynom& poly,
+           const NewtonParams& params,
+           unsigned* terms,
+           float* xs,
+           float* ys,
+           RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const PixelBlock<float>&, const NewtonPolynom&, const NewtonParams&, unsigned*, float*, float*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::newton, avx2::newton, avx512::newton)(block, poly, params, terms, xs, ys, stats);
+    }
+
+    void
+    newton(const PointList<float>& points,
+           const NewtonPolynom& poly,
+           const NewtonParams& params,
+           unsigned* terms,
+           float* xs,
+           float* ys,
+           RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const PointList<float>&, const NewtonPolynom&, const NewtonParams&, unsigned*, float*, float*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::newton, avx2::newton, avx512::newton)(points, poly, params, terms, xs, ys, stats);
+    }
+
+    void
+    perturbation(const DeltaList& deltas,
+                 const ReferenceData& reference,
+                 const SeriesData& series,
+                 const PerturbationParams& params,
+                 unsigned* terms,
+                 float* lens,
+                 int* glitches,
+                 RenderingStatistics& stats) noexcept
+    {
+      using Kernel = void (*)(const DeltaList&, const ReferenceData&, const SeriesData&, const PerturbationParams&, unsigned*, float*, int*, RenderingStatistics&) noexcept;
+      select<Kernel>(sse4_2::perturbation, avx2::perturbation, avx512::perturbation)(deltas, reference, series, params, terms, lens, glitches, stats);
+    }
+
+    template void mandelbrot<float>(const PixelBlock<float>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<double>(const PixelBlock<double>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<long double>(const PixelBlock<long double>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<scalar::DoubleDouble>(const PixelBlock<scalar::DoubleDouble>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# ifdef __SIZEOF_FLOAT128__
+    template void mandelbrot<scalar::Quad>(const PixelBlock<scalar::Quad>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# endif
+    template void mandelbrot<scalar::Fixed128>(const PixelBlock<scalar::Fixed128>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<scalar::Fixed192>(const PixelBlock<scalar::Fixed192>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+
+    template void mandelbrot<float>(const PointList<float>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<double>(const PointList<double>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<long double>(const PointList<long double>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<scalar::DoubleDouble>(const PointList<scalar::DoubleDouble>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# ifdef __SIZEOF_FLOAT128__
+    template void mandelbrot<scalar::Quad>(const PointList<scalar::Quad>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# endif
+    template void mandelbrot<scalar::Fixed128>(const PointList<scalar::Fixed128>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void mandelbrot<scalar::Fixed192>(const PointList<scalar::Fixed192>&, unsigned, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+
+    template void julia<float>(const PixelBlock<float>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<double>(const PixelBlock<double>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<long double>(const PixelBlock<long double>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<scalar::DoubleDouble>(const PixelBlock<scalar::DoubleDouble>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# ifdef __SIZEOF_FLOAT128__
+    template void julia<scalar::Quad>(const PixelBlock<scalar::Quad>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# endif
+    template void julia<scalar::Fixed128>(const PixelBlock<scalar::Fixed128>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<scalar::Fixed192>(const PixelBlock<scalar::Fixed192>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+
+    template void julia<float>(const PointList<float>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<double>(const PointList<double>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<long double>(const PointList<long double>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<scalar::DoubleDouble>(const PointList<scalar::DoubleDouble>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# ifdef __SIZEOF_FLOAT128__
+    template void julia<scalar::Quad>(const PointList<scalar::Quad>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+# endif
+    template void julia<scalar::Fixed128>(const PointList<scalar::Fixed128>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+    template void julia<scalar::Fixed192>(const PointList<scalar::Fixed192>&, float, float, const EscapeTimeParams&, unsigned*, float*, RenderingStatistics&) noexcept;
+
+  }
+}
+
+# else
+
+namespace fractsim {
+  namespace kernels {
+
+    std::string
+    getVariantName() {
+      // The kernels are built for a single instruction set and called directly.
+      return "native";
+    }
+
+  }
+}
+
+# endif
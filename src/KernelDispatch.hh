@@ -0,0 +1,43 @@
+#ifndef    KERNEL_DISPATCH_HH
+# define   KERNEL_DISPATCH_HH
+
+/**
+ * @brief - Describes how the kernels are selected for the instruction sets of the
+ *          host. The kernels can be built several times, once for each targeted
+ *          instruction set: each build defines its kernels in a dedicated inline
+ *          namespace of `kernels` named after the variant, which is provided with
+ *          the `FRACTSIM_KERNELS_VARIANT` macro.
+ *          The rest of the application is built with the `dispatch` variant: its
+ *          kernels forward each call to the best variant supported by the host,
+ *          which is selected the first time a kernel is used.
+ *          When the kernels are built for a single instruction set the variant is
+ *          `native` and the kernels are called directly.
+ */
+
+# include <string>
+
+# ifndef FRACTSIM_KERNELS_VARIANT
+#  define FRACTSIM_KERNELS_VARIANT native
+# endif
+
+namespace fractsim {
+  namespace kernels {
+
+    /**
+     * @brief - Used to retrieve the name of the variant of the kernels used to
+     *          compute the pixels. The variants built for several instruction sets
+     *          are `sse4.2`, `avx2` and `avx512`: by default the best one supported
+     *          by the host is used. It can be forced through the `FRACTSIM_KERNELS`
+     *          environment variable, which is mostly useful for testing: a variant
+     *          which is not supported by the host is ignored.
+     *          When the kernels are built for a single instruction set the name is
+     *          `native`.
+     * @return - the name of the variant of the kernels.
+     */
+    std::string
+    getVariantName();
+
+  }
+}
+
+#endif    /* KERNEL_DISPATCH_HH */
@@ -2,7 +2,14 @@
 # define   MANDELBROT_RENDERING_OPTIONS_HH
 
 # include <memory>
+# include <mutex>
+# include <vector>
 # include "FractalOptions.hh"
+# include "EscapeTimeKernel.hh"
+# include "ArbitraryKernel.hh"
+# include "PerturbationKernel.hh"
+# include "ReferenceOrbit.hh"
+# include "SeriesApproximation.hh"
 
 namespace fractsim {
 
@@ -51,6 +58,121 @@ namespace fractsim {
       void
       setExponent(float exponent) noexcept;
 
+      bool
+      getPeriodicityCheck() const noexcept;
+
+      /**
+       * @brief - Used to enable or disable the detection of periodic orbits. When
+       *          enabled, the series computed for each point is checked for cycles
+       *          and the point is considered part of the set as soon as one term is
+       *          repeated. This allows to avoid iterating the points of the set up
+       *          to the accuracy, which dominates the computation time for large
+       *          accuracies.
+       * @param enabled - `true` to enable the detection of periodic orbits.
+       */
+      void
+      setPeriodicityCheck(bool enabled) noexcept;
+
+      bool
+      getLaneRefill() const noexcept;
+
+      /**
+       * @brief - Used to select how the kernels schedule the pixels on the lanes of
+       *          the vector units. When enabled, a lane whose pixel is done picks up
+       *          the next pending pixel instead of idling until all the pixels of
+       *          its packet are done. This mostly helps for large accuracies where
+       *          neighbouring pixels need very different numbers of terms, while
+       *          the bookkeeping slightly slows down the cheapest renderings.
+       * @param enabled - `true` to refill the lanes as soon as they are done.
+       */
+      void
+      setLaneRefill(bool enabled) noexcept;
+
+      bool
+      getChunkedBailout() const noexcept;
+
+      /**
+       * @brief - Used to select how often the kernels check whether the series of
+       *          the pixels of a packet ended. When enabled, the iterations are run
+       *          in chunks and the status of the lanes is only checked at the end of
+       *          each chunk, which is rolled back if a lane stopped in between. This
+       *          saves most of the checks on long series.
+       * @param enabled - `true` to check the lanes after chunks of iterations.
+       */
+      void
+      setChunkedBailout(bool enabled) noexcept;
+
+      /**
+       * @brief - Specialization of the base class to handle deep zooms. When the
+       *          pixels of the view are too small to be accurately computed with
+       *          double precision values, the orbit of the center of the view is
+       *          computed with arbitrary precision and the pixels are computed
+       *          relatively to it through perturbation.
+       *          The reference orbit is kept as long as it is still suited for
+       *          the view, which typically allows to scroll the view without
+       *          computing it again.
+       *          A series approximating the first terms of the pixels of the view
+       *          is also computed so that they can be skipped.
+       *          Note that this is only available for the quadratic series.
+       * @param area - the area of the view to render. The reference orbit is
+       *               centered on the area with its full precision.
+       * @param pixel - the size of a single pixel of the view in real world
+       *                coordinates.
+       */
+      void
+      prepareRendering(const GMPBox& area,
+                       const scalar::Arbitrary& pixel) override;
+
+      /**
+       * @brief - Specialization of the base class to indicate that the Mandelbrot set
+       *          can be computed with any of the precisions supported by the kernels.
+       *          This only holds for the exponents supported by the `mandelbrot`
+       *          kernel: the other ones are computed with at most the extended
+       *          precision.
+       * @return - the maximum precision supported by the Mandelbrot set.
+       */
+      scalar::Precision
+      getMaximumPrecision() const noexcept override;
+
+      /**
+       * @brief - Specialization of the base class for the escape-time series: the
+       *          smoothed values of the escaping points vary continuously within
+       *          the regions they form, so only the points of the Mandelbrot set (with
+       *          the maximum confidence) are considered to belong to a class.
+       * @param lhs - the confidence of the first point.
+       * @param rhs - the confidence of the second point.
+       * @return - `true` if both points belong to the Mandelbrot set.
+       */
+      bool
+      isSameClass(float lhs,
+                  float rhs) const noexcept override;
+
+    protected:
+
+      /**
+       * @brief - Specialization of the base class to process a whole block of points
+       *          at once. Every precision is forwarded to `processBlock`.
+       * @param block - the block of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      void
+      computeBlockPrivate(scalar::AnyOf<kernels::PixelBlock> block,
+                          float* out,
+                          RenderingStatistics& stats) const noexcept override;
+
+      /**
+       * @brief - Specialization of the base class to process a list of points at
+       *          once. Every precision is forwarded to `processPoints`.
+       * @param points - the list of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      void
+      computePointsPrivate(scalar::AnyOf<kernels::PointList> points,
+                           float* out,
+                           RenderingStatistics& stats) const noexcept override;
+
     private:
 
       /**
@@ -75,6 +197,176 @@ namespace fractsim {
       unsigned
       getSmoothingOvershoot() noexcept;
 
+      /**
+       * @brief - Used to retrieve the squared ratio between the modulus of a term of
+       *          the series of a pixel and the modulus of the term of the reference
+       *          below which the pixel is considered glitched.
+       * @return - the tolerance used to detect glitches.
+       */
+      static
+      float
+      getGlitchTolerance() noexcept;
+
+      /**
+       * @brief - Used to retrieve the maximum number of additional reference orbits
+       *          that can be computed to fix the glitched pixels of a block. Pixels
+       *          which are still glitched after that keep their approximate value.
+       * @return - the maximum number of additional references for a block.
+       */
+      static
+      unsigned
+      getMaximumReferenceCount() noexcept;
+
+      /**
+       * @brief - Used to retrieve the factor by which the dimensions of the view are
+       *          enlarged to define the area for which the series approximation is
+       *          validated. As the tiles do not exactly match the view, this allows
+       *          to still use the series for the tiles slightly outside of it.
+       * @return - the factor to apply to the dimensions of the view.
+       */
+      static
+      float
+      getSeriesAreaMargin() noexcept;
+
+      /**
+       * @brief - Used to determine the number of bits needed to compute a reference
+       *          orbit so that pixels of the input size can be distinguished from
+       *          each other.
+       * @param extent - the magnitude of the coordinates of the pixels.
+       * @param size - the size of a pixel.
+       * @return - the number of bits to use to compute the reference orbit.
+       */
+      static
+      unsigned
+      getReferencePrecision(float extent,
+                            const scalar::Arbitrary& size) noexcept;
+
+      /**
+       * @brief - Used to determine whether the input point lies inside the main
+       *          cardioid or the period-2 bulb of the quadratic Mandelbrot set.
+       *          Such points are known to belong to the set which means that we
+       *          don't need to iterate the series to compute them.
+       * @param x - the real part of the point to check.
+       * @param y - the imaginary part of the point to check.
+       * @return - `true` if the point is inside one of these regions.
+       */
+      template <typename Value>
+      static
+      bool
+      isInsideMainBulbs(const Value& x,
+                        const Value& y) noexcept;
+
+      /**
+       * @brief - Used to convert the number of terms computed for a point and the
+       *          squared modulus of the last term into a smoothed and wrapped value
+       *          suitable to be used in the palette.
+       * @param terms - the number of terms computed for the point.
+       * @param len - the squared modulus of the last term of the series.
+       * @return - the confidence associated to the point.
+       */
+      float
+      smooth(unsigned terms,
+             float len) const noexcept;
+
+      /**
+       * @brief - Used to gather the parameters to provide to the kernels in order
+       *          to reproduce the computations of the `compute` method.
+       * @param step - the size of the pixels to compute, used to adapt the
+       *               tolerance of the periodicity detection.
+       * @return - the parameters of the series.
+       */
+      kernels::EscapeTimeParams
+      getKernelParams(double step) const noexcept;
+
+      /**
+       * @brief - Used to gather the parameters to provide to the perturbation kernel
+       *          in order to reproduce the computations of the `compute` method.
+       * @return - the parameters of the series.
+       */
+      kernels::PerturbationParams
+      getPerturbationParams() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the reference orbit to use to compute the points
+       *          of the current view. In case the points should not be computed with
+       *          perturbation a `null` value is returned.
+       * @param series - output value receiving the series approximation to use with
+       *                 the reference orbit.
+       * @return - the reference orbit or `null` if none should be used.
+       */
+      ReferenceOrbitShPtr
+      getReference(SeriesApproximationShPtr& series) const noexcept;
+
+      /**
+       * @brief - Computes the input points through perturbation. The points which are
+       *          glitched with the input reference are computed again with additional
+       *          references chosen among them, until no glitched points remain or the
+       *          maximum number of references is reached.
+       *          The series approximation allows to skip the first terms of all the
+       *          points, as long as they all lie in the area where it is valid.
+       * @param reference - the reference orbit of the view.
+       * @param series - the series approximation associated to the reference.
+       * @param dxs - the offset of the points to the reference along the `x` axis.
+       * @param dys - the offset of the points to the reference along the `y` axis.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      void
+      computePerturbation(const ReferenceOrbit& reference,
+                          const SeriesApproximation& series,
+                          const std::vector<double>& dxs,
+                          const std::vector<double>& dys,
+                          float* out,
+                          RenderingStatistics& stats) const noexcept;
+
+      /**
+       * @brief - Computes a single point and updates the input statistics with the
+       *          work performed. The series is computed with the input scalar type,
+       *          or with `long double` in case it is not supported by the standard
+       *          library. The powers rely on `std::pow`: this is only used for the
+       *          exponents not supported by the kernels, the other ones being always
+       *          computed by the kernels so that all the paths agree.
+       * @param x - the real part of the point to compute.
+       * @param y - the imaginary part of the point to compute.
+       * @param tolerance - the squared distance used to detect periodic orbits, a
+       *                    null value disables the detection.
+       * @param stats - output statistics updated with the work performed.
+       * @return - a value indicating the level of confidence that this point is
+       *           part of the fractal.
+       */
+      template <typename Scalar>
+      float
+      computePoint(const Scalar& x,
+                   const Scalar& y,
+                   double tolerance,
+                   RenderingStatistics& stats) const noexcept;
+
+      /**
+       * @brief - Computes a block of points with the input scalar type. Depending on
+       *          the view and the exponent, the points are computed through pertur-
+       *          bation, with the escape-time kernels or individually.
+       * @param block - the block of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Scalar>
+      void
+      processBlock(const kernels::PixelBlock<Scalar>& block,
+                   float* out,
+                   RenderingStatistics& stats) const noexcept;
+
+      /**
+       * @brief - Similar to `processBlock` but computes a list of points.
+       * @param points - the list of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Scalar>
+      void
+      processPoints(const kernels::PointList<Scalar>& points,
+                    float* out,
+                    RenderingStatistics& stats) const noexcept;
+
     private:
 
       /**
@@ -83,6 +375,45 @@ namespace fractsim {
        *          to more bulbs.
        */
       float m_exponent;
+
+      /**
+       * @brief - Whether the orbit of each point should be checked for cycles so that
+       *          the points of the set can be detected before reaching the accuracy.
+       */
+      bool m_periodicity;
+
+      /**
+       * @brief - Whether the lanes of the vector units should be refilled with a new
+       *          pixel as soon as their pixel is done.
+       */
+      bool m_refill;
+
+      /**
+       * @brief - Whether the kernels should iterate in chunks before checking the
+       *          status of the lanes.
+       */
+      bool m_chunks;
+
+      /**
+       * @brief - A mutex protecting the reference orbit from concurrent accesses.
+       */
+      mutable std::mutex m_propsLocker;
+
+      /**
+       * @brief - The reference orbit used to compute the points of the current view
+       *          through perturbation. This value is `null` when the view does not
+       *          need it. As tiles of a previous view might still be computed when
+       *          a new view is prepared, each computation keeps its own copy of the
+       *          pointer.
+       */
+      ReferenceOrbitShPtr m_reference;
+
+      /**
+       * @brief - The series approximating the first terms of the pixels of the view
+       *          relatively to the reference orbit. This value is defined whenever
+       *          the reference orbit is defined.
+       */
+      SeriesApproximationShPtr m_series;
   };
 
   using MandelbrotRenderingOptionsShPtr = std::shared_ptr<MandelbrotRenderingOptions>;
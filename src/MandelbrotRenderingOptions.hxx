@@ -2,7 +2,12 @@
 # define   MANDELBROT_RENDERING_OPTIONS_HXX
 
 # include "MandelbrotRenderingOptions.hh"
+# include <algorithm>
+# include <cmath>
 # include <complex>
+# include <limits>
+# include <type_traits>
+# include <vector>
 
 namespace fractsim {
 
@@ -12,7 +17,14 @@ namespace fractsim {
                    getDefaultPaletteWrapping(),
                    getDefaultPalette()),
 
-    m_exponent(exponent)
+    m_exponent(exponent),
+    m_periodicity(true),
+    m_refill(true),
+    m_chunks(true),
+
+    m_propsLocker(),
+    m_reference(nullptr),
+    m_series(nullptr)
   {}
 
   inline
@@ -24,6 +36,383 @@ namespace fractsim {
   inline
   float
   MandelbrotRenderingOptions::compute(const utils::Vector2f& p) const noexcept {
+    RenderingStatistics stats{};
+    double tolerance = getPeriodicityCheck() ? getPeriodicityTolerance(p) : 0.0;
+
+    if (!kernels::supportsExponent(getExponent())) {
+      return computePoint(p.x(), p.y(), tolerance, stats);
+    }
+
+    // The integer exponents are computed with the kernel used for the blocks:
+    // the powers are obtained by repeated multiplications, which do not round
+    // the terms in the same way as `std::pow`.
+    const float x = p.x();
+    const float y = p.y();
+
+    unsigned terms = 0u;
+    float len = 0.0f;
+
+    kernels::mandelbrot(
+      kernels::PointList<float>{&x, &y, 1u, 0.0f, 0.0f},
+      static_cast<unsigned>(getExponent()),
+      kernels::EscapeTimeParams{
+        getAccuracy(),
+        getSmoothingOvershoot(),
+        getDivergenceThreshold(),
+        tolerance,
+        getLaneRefill(),
+        getChunkedBailout()
+      },
+      &terms,
+      &len,
+      stats
+    );
+
+    return smooth(terms, len);
+  }
+
+  inline
+  void
+  MandelbrotRenderingOptions::prepareRendering(const GMPBox& area,
+                                               const scalar::Arbitrary& pixel)
+  {
+    const std::lock_guard guard(m_propsLocker);
+
+    // Perturbation is only needed when the pixels are too small compared to
+    // their coordinates to be computed with the vectorized kernels. Single
+    // precision is enough to determine the magnitude of the coordinates.
+    utils::Boxf bounds = area.toBox();
+    double w = mpf_get_d(area.w());
+    double h = mpf_get_d(area.h());
+
+    float extent = std::max(
+      std::abs(bounds.x()) + static_cast<float>(w / 2.0),
+      std::abs(bounds.y()) + static_cast<float>(h / 2.0)
+    );
+
+    // A degenerate pixel size can't be used to size the reference orbit: the
+    // pixels are then computed directly. This is also the case when the
+    // offsets to the reference can't be represented in double precision.
+    long minExponent = std::numeric_limits<double>::min_exponent + 64l;
+
+    if (getExponent() != 2.0f ||
+        scalar::getResolutionBits(extent, pixel) >= scalar::getMaximumResolutionBits() ||
+        GMPFloat::getExponent(pixel.get()) < minExponent ||
+        scalar::select(extent, pixel, getAccuracy()) <= scalar::Precision::Double)
+    {
+      m_reference.reset();
+      m_series.reset();
+      return;
+    }
+
+    kernels::PerturbationParams params = getPerturbationParams();
+    unsigned precision = getReferencePrecision(extent, pixel);
+
+    GMPVector2 center = area.getCenter();
+
+    // Keep the existing reference if it is still suited for this view: this is
+    // typically the case when the view is only scrolled.
+    double dx = 0.0, dy = 0.0;
+    bool valid = false;
+
+    if (m_reference != nullptr &&
+        m_reference->getPrecision() == precision &&
+        m_reference->getParams().accuracy == params.accuracy)
+    {
+      m_reference->getOffset(scalar::Arbitrary(center.x()), scalar::Arbitrary(center.y()), dx, dy);
+      valid = (std::abs(dx) < w / 2.0 && std::abs(dy) < h / 2.0);
+    }
+
+    if (!valid) {
+      m_reference = std::make_shared<ReferenceOrbit>(
+        center,
+        precision,
+        params
+      );
+
+      dx = 0.0;
+      dy = 0.0;
+
+      debug(
+        "Computed reference orbit at " + center.toVector().toString() +
+        " with " + std::to_string(precision) + " bit(s), " +
+        std::to_string(m_reference->getData().length) + " term(s)"
+      );
+    }
+
+    // The series depends on the area to render so it is always computed again.
+    double hw = getSeriesAreaMargin() * w / 2.0;
+    double hh = getSeriesAreaMargin() * h / 2.0;
+
+    m_series = std::make_shared<SeriesApproximation>(
+      *m_reference,
+      dx - hw,
+      dx + hw,
+      dy - hh,
+      dy + hh,
+      static_cast<double>(pixel)
+    );
+
+    debug("Series approximation skips " + std::to_string(m_series->getSkippedTerms()) + " term(s)");
+  }
+
+  inline
+  scalar::Precision
+  MandelbrotRenderingOptions::getMaximumPrecision() const noexcept {
+    // The exponents not handled by the kernels are computed by `computePoint`
+    // which relies on the standard library: it cannot do better than the
+    // extended precision.
+    if (!kernels::supportsExponent(getExponent())) {
+      return scalar::Precision::Extended;
+    }
+
+    return scalar::Precision::Arbitrary;
+  }
+
+  inline
+  bool
+  MandelbrotRenderingOptions::isSameClass(float lhs,
+                                          float rhs) const noexcept
+  {
+    // Interior points are computed up to the accuracy: their confidence is
+    // clamped to exactly `1` while the wrapped values are strictly smaller.
+    return lhs >= 1.0f && rhs >= 1.0f;
+  }
+
+  inline
+  void
+  MandelbrotRenderingOptions::computeBlockPrivate(scalar::AnyOf<kernels::PixelBlock> block,
+                                                  float* out,
+                                                  RenderingStatistics& stats) const noexcept
+  {
+    std::visit(
+      [this, out, &stats](const auto* values) {
+        processBlock(*values, out, stats);
+      },
+      block
+    );
+  }
+
+  inline
+  void
+  MandelbrotRenderingOptions::computePointsPrivate(scalar::AnyOf<kernels::PointList> points,
+                                                   float* out,
+                                                   RenderingStatistics& stats) const noexcept
+  {
+    std::visit(
+      [this, out, &stats](const auto* values) {
+        processPoints(*values, out, stats);
+      },
+      points
+    );
+  }
+
+  template <typename Value>
+  inline
+  bool
+  MandelbrotRenderingOptions::isInsideMainBulbs(const Value& x,
+                                                const Value& y) noexcept
+  {
+    // See here for the details of the formulas:
+    // https://en.wikipedia.org/wiki/Plotting_algorithms_for_the_Mandelbrot_set#Cardioid_/_bulb_checking
+    Value y2 = y * y;
+
+    Value xq = x - 0.25f;
+    Value q = xq * xq + y2;
+    if (q * (q + xq) < 0.25f * y2) {
+      return true;
+    }
+
+    Value xb = x + 1.0f;
+    return xb * xb + y2 < 0.0625f;
+  }
+
+  inline
+  float
+  MandelbrotRenderingOptions::smooth(unsigned terms,
+                                     float len) const noexcept
+  {
+    // Smooth the iterations count with some mathematical magic.
+    // More resources can be found here: http://linas.org/art-gallery/escape/smooth.html
+    float sTerms = 1.0f * terms;
+    if (terms < getAccuracy()) {
+      // Compute the smoothed iteration count.
+      sTerms = terms + 1.0f - std::log(std::log(std::sqrt(len))) / std::log(getExponent());
+
+      // Apply palette wrapping.
+      sTerms = performWrapping(sTerms);
+    }
+
+    return sTerms;
+  }
+
+  inline
+  kernels::EscapeTimeParams
+  MandelbrotRenderingOptions::getKernelParams(double step) const noexcept {
+    return kernels::EscapeTimeParams{
+      getAccuracy(),
+      getSmoothingOvershoot(),
+      getDivergenceThreshold(),
+      getPeriodicityCheck() ? getPeriodicityTolerance(step) : 0.0,
+      getLaneRefill(),
+      getChunkedBailout()
+    };
+  }
+
+  inline
+  kernels::PerturbationParams
+  MandelbrotRenderingOptions::getPerturbationParams() const noexcept {
+    return kernels::PerturbationParams{
+      getAccuracy(),
+      getSmoothingOvershoot(),
+      getDivergenceThreshold(),
+      getGlitchTolerance()
+    };
+  }
+
+  inline
+  ReferenceOrbitShPtr
+  MandelbrotRenderingOptions::getReference(SeriesApproximationShPtr& series) const noexcept {
+    const std::lock_guard guard(m_propsLocker);
+
+    // The reference might be outdated in case the series was modified since
+    // the view was prepared.
+    if (m_reference == nullptr ||
+        getExponent() != 2.0f ||
+        m_reference->getParams().accuracy != getAccuracy())
+    {
+      return nullptr;
+    }
+
+    series = m_series;
+    return m_reference;
+  }
+
+  inline
+  void
+  MandelbrotRenderingOptions::computePerturbation(const ReferenceOrbit& reference,
+                                                  const SeriesApproximation& series,
+                                                  const std::vector<double>& dxs,
+                                                  const std::vector<double>& dys,
+                                                  float* out,
+                                                  RenderingStatistics& stats) const noexcept
+  {
+    unsigned count = dxs.size();
+    std::vector<unsigned> terms(count, 0u);
+    std::vector<int> glitches(count, 0);
+
+    // The series can only be used if all the points lie in the area where it
+    // was validated: otherwise we start from the first term.
+    const kernels::SeriesData none{0u, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    bool inside = true;
+
+    for (unsigned id = 0u ; id < count && inside ; ++id) {
+      inside = series.contains(dxs[id], dys[id]);
+    }
+
+    // The output array is used to hold the squared modulus produced by the
+    // kernel: they are then converted in place to smoothed values.
+    kernels::perturbation(
+      kernels::DeltaList{dxs.data(), dys.data(), count},
+      reference.getData(),
+      inside ? series.getData() : none,
+      reference.getParams(),
+      terms.data(),
+      out,
+      glitches.data(),
+      stats
+    );
+
+    std::vector<unsigned> pending;
+    for (unsigned id = 0u ; id < count ; ++id) {
+      if (glitches[id] != 0) {
+        pending.push_back(id);
+      }
+    }
+
+    unsigned references = 0u;
+
+    while (!pending.empty() && references < getMaximumReferenceCount()) {
+      // Use the glitched point closest to the center of the glitched points
+      // as the new reference: its own series is always computed accurately
+      // so each new reference fixes at least one point.
+      double cx = 0.0, cy = 0.0;
+      for (unsigned id = 0u ; id < pending.size() ; ++id) {
+        cx += dxs[pending[id]];
+        cy += dys[pending[id]];
+      }
+      cx /= pending.size();
+      cy /= pending.size();
+
+      unsigned best = pending.front();
+      double bestDist = std::numeric_limits<double>::max();
+      for (unsigned id = 0u ; id < pending.size() ; ++id) {
+        double ddx = dxs[pending[id]] - cx;
+        double ddy = dys[pending[id]] - cy;
+        double dist = ddx * ddx + ddy * ddy;
+
+        if (dist < bestDist) {
+          best = pending[id];
+          bestDist = dist;
+        }
+      }
+
+      ReferenceOrbit secondary(reference, dxs[best], dys[best]);
+      ++references;
+
+      unsigned remaining = pending.size();
+      std::vector<double> sdxs(remaining, 0.0);
+      std::vector<double> sdys(remaining, 0.0);
+      std::vector<unsigned> sTerms(remaining, 0u);
+      std::vector<float> sLens(remaining, 0.0f);
+      std::vector<int> sGlitches(remaining, 0);
+
+      for (unsigned id = 0u ; id < remaining ; ++id) {
+        sdxs[id] = dxs[pending[id]] - dxs[best];
+        sdys[id] = dys[pending[id]] - dys[best];
+      }
+
+      kernels::perturbation(
+        kernels::DeltaList{sdxs.data(), sdys.data(), remaining},
+        secondary.getData(),
+        none,
+        secondary.getParams(),
+        sTerms.data(),
+        sLens.data(),
+        sGlitches.data(),
+        stats
+      );
+
+      std::vector<unsigned> glitched;
+      for (unsigned id = 0u ; id < remaining ; ++id) {
+        terms[pending[id]] = sTerms[id];
+        out[pending[id]] = sLens[id];
+
+        if (sGlitches[id] != 0) {
+          glitched.push_back(pending[id]);
+        }
+      }
+
+      pending.swap(glitched);
+    }
+
+    stats.references += references;
+
+    for (unsigned id = 0u ; id < count ; ++id) {
+      out[id] = smooth(terms[id], out[id]);
+    }
+  }
+
+  template <typename Scalar>
+  inline
+  float
+  MandelbrotRenderingOptions::computePoint(const Scalar& x,
+                                           const Scalar& y,
+                                           double tolerance,
+                                           RenderingStatistics& stats) const noexcept
+  {
+    using Value = scalar::Standard<Scalar>;
+
     // Compute terms of the series until it diverges.
     unsigned acc = getAccuracy();
     unsigned over = getSmoothingOvershoot();
@@ -32,31 +421,205 @@ namespace fractsim {
     float len = 0.0f;
     unsigned terms = 0u, conv = 0u;
 
-    std::complex<float> cur(0.0f, 0.0f);
-    std::complex<float> c(p.x(), p.y());
+    // The points belonging to the set would iterate until the accuracy is
+    // reached (or at least the overshoot).
+    unsigned interior = std::max(acc, over);
+
+    // Points inside the main components of the set would iterate until the
+    // accuracy is reached: we can directly provide the result.
+    if (n == 2.0f && isInsideMainBulbs(static_cast<Value>(x), static_cast<Value>(y))) {
+      stats.saved += interior;
+      return smooth(interior, len);
+    }
+
+    std::complex<Value> cur(0.0f, 0.0f);
+    std::complex<Value> c(static_cast<Value>(x), static_cast<Value>(y));
+
+    // The reference term used to detect periodic orbits is refreshed each
+    // time the number of terms reaches a power of two (Brent's method).
+    bool periodicity = tolerance > 0.0;
+    std::complex<Value> ref = cur;
+    unsigned checkpoint = 1u;
 
     while ((len < thresh && terms < acc) || terms - conv < over) {
-      cur = std::pow(cur, n) + c;
+      cur = std::pow(cur, static_cast<Value>(n)) + c;
 
-      len = norm(cur);
+      len = static_cast<float>(std::norm(cur));
       if (len >= thresh && conv == 0u) {
         conv = terms;
       }
       ++terms;
+
+      if (periodicity && len < thresh) {
+        if (static_cast<double>(std::norm(cur - ref)) < tolerance) {
+          stats.iterations += terms;
+          stats.saved += interior - terms;
+
+          return smooth(interior, len);
+        }
+
+        if (terms == checkpoint) {
+          ref = cur;
+          checkpoint *= 2u;
+        }
+      }
     }
 
-    // Smooth the iterations count with some mathematical magic.
-    // More resources can be found here: http://linas.org/art-gallery/escape/smooth.html
-    float sTerms = 1.0f * terms;
-    if (terms < acc) {
-      // Compute the smoothed iteration count.
-      sTerms = terms + 1.0f - std::log(std::log(std::sqrt(len))) / std::log(n);
+    stats.iterations += terms;
 
-      // Apply palette wrapping.
-      sTerms = performWrapping(sTerms);
+    return smooth(terms, len);
+  }
+
+  template <typename Scalar>
+  inline
+  void
+  MandelbrotRenderingOptions::processBlock(const kernels::PixelBlock<Scalar>& block,
+                                           float* out,
+                                           RenderingStatistics& stats) const noexcept
+  {
+    unsigned count = block.w * block.h;
+
+    // Deep zooms are handled through perturbation: the offsets of the points
+    // are computed in double precision from the origin of the block, which is
+    // itself computed with the precision of the reference.
+    SeriesApproximationShPtr series;
+    ReferenceOrbitShPtr reference = getReference(series);
+    if (reference != nullptr) {
+      double dx, dy;
+      reference->getOffset(scalar::Arbitrary(block.xMin), scalar::Arbitrary(block.yMin), dx, dy);
+
+      double stepX = static_cast<double>(block.stepX);
+      double stepY = static_cast<double>(block.stepY);
+
+      std::vector<double> dxs(count, 0.0);
+      std::vector<double> dys(count, 0.0);
+
+      for (unsigned y = 0u ; y < block.h ; ++y) {
+        for (unsigned x = 0u ; x < block.w ; ++x) {
+          dxs[y * block.w + x] = dx + x * stepX;
+          dys[y * block.w + x] = dy + y * stepY;
+        }
+      }
+
+      computePerturbation(*reference, *series, dxs, dys, out, stats);
+
+      return;
     }
 
-    return sTerms;
+    double step = std::min(static_cast<double>(block.stepX), static_cast<double>(block.stepY));
+    kernels::EscapeTimeParams params = getKernelParams(step);
+
+    // The vectorized kernel only handles small integer exponents: the other
+    // ones are computed from the polar form of the terms in single precision
+    // and individually for the other scalar types.
+    if (!kernels::supportsExponent(getExponent())) {
+      if constexpr (std::is_same_v<Scalar, float>) {
+        if (kernels::supportsPolarExponent(getExponent())) {
+          std::vector<unsigned> terms(count, 0u);
+
+          kernels::multibrot(block, getExponent(), params, terms.data(), out, stats);
+
+          for (unsigned id = 0u ; id < count ; ++id) {
+            out[id] = smooth(terms[id], out[id]);
+          }
+
+          return;
+        }
+      }
+
+      for (unsigned y = 0u ; y < block.h ; ++y) {
+        for (unsigned x = 0u ; x < block.w ; ++x) {
+          out[y * block.w + x] = computePoint(
+            static_cast<Scalar>(block.xMin + x * block.stepX),
+            static_cast<Scalar>(block.yMin + y * block.stepY),
+            params.periodicity,
+            stats
+          );
+        }
+      }
+
+      return;
+    }
+
+    std::vector<unsigned> terms(count, 0u);
+
+    // The output array is used to hold the squared modulus produced by the
+    // kernel: they are then converted in place to smoothed values.
+    kernels::mandelbrot(
+      block,
+      static_cast<unsigned>(getExponent()),
+      params,
+      terms.data(),
+      out,
+      stats
+    );
+
+    for (unsigned id = 0u ; id < count ; ++id) {
+      out[id] = smooth(terms[id], out[id]);
+    }
+  }
+
+  template <typename Scalar>
+  inline
+  void
+  MandelbrotRenderingOptions::processPoints(const kernels::PointList<Scalar>& points,
+                                            float* out,
+                                            RenderingStatistics& stats) const noexcept
+  {
+    SeriesApproximationShPtr series;
+    ReferenceOrbitShPtr reference = getReference(series);
+    if (reference != nullptr) {
+      std::vector<double> dxs(points.count, 0.0);
+      std::vector<double> dys(points.count, 0.0);
+
+      for (unsigned id = 0u ; id < points.count ; ++id) {
+        reference->getOffset(scalar::Arbitrary(points.xs[id]), scalar::Arbitrary(points.ys[id]), dxs[id], dys[id]);
+      }
+
+      computePerturbation(*reference, *series, dxs, dys, out, stats);
+
+      return;
+    }
+
+    double step = std::min(static_cast<double>(points.stepX), static_cast<double>(points.stepY));
+    kernels::EscapeTimeParams params = getKernelParams(step);
+
+    if (!kernels::supportsExponent(getExponent())) {
+      if constexpr (std::is_same_v<Scalar, float>) {
+        if (kernels::supportsPolarExponent(getExponent())) {
+          std::vector<unsigned> terms(points.count, 0u);
+
+          kernels::multibrot(points, getExponent(), params, terms.data(), out, stats);
+
+          for (unsigned id = 0u ; id < points.count ; ++id) {
+            out[id] = smooth(terms[id], out[id]);
+          }
+
+          return;
+        }
+      }
+
+      for (unsigned id = 0u ; id < points.count ; ++id) {
+        out[id] = computePoint(points.xs[id], points.ys[id], params.periodicity, stats);
+      }
+
+      return;
+    }
+
+    std::vector<unsigned> terms(points.count, 0u);
+
+    kernels::mandelbrot(
+      points,
+      static_cast<unsigned>(getExponent()),
+      params,
+      terms.data(),
+      out,
+      stats
+    );
+
+    for (unsigned id = 0u ; id < points.count ; ++id) {
+      out[id] = smooth(terms[id], out[id]);
+    }
   }
 
   inline
@@ -71,6 +634,42 @@ namespace fractsim {
     m_exponent = exponent;
   }
 
+  inline
+  bool
+  MandelbrotRenderingOptions::getPeriodicityCheck() const noexcept {
+    return m_periodicity;
+  }
+
+  inline
+  void
+  MandelbrotRenderingOptions::setPeriodicityCheck(bool enabled) noexcept {
+    m_periodicity = enabled;
+  }
+
+  inline
+  bool
+  MandelbrotRenderingOptions::getLaneRefill() const noexcept {
+    return m_refill;
+  }
+
+  inline
+  void
+  MandelbrotRenderingOptions::setLaneRefill(bool enabled) noexcept {
+    m_refill = enabled;
+  }
+
+  inline
+  bool
+  MandelbrotRenderingOptions::getChunkedBailout() const noexcept {
+    return m_chunks;
+  }
+
+  inline
+  void
+  MandelbrotRenderingOptions::setChunkedBailout(bool enabled) noexcept {
+    m_chunks = enabled;
+  }
+
   inline
   float
   MandelbrotRenderingOptions::getDivergenceThreshold() noexcept {
@@ -83,6 +682,34 @@ namespace fractsim {
     return 3u;
   }
 
+  inline
+  float
+  MandelbrotRenderingOptions::getGlitchTolerance() noexcept {
+    return 1.0e-6f;
+  }
+
+  inline
+  unsigned
+  MandelbrotRenderingOptions::getMaximumReferenceCount() noexcept {
+    return 16u;
+  }
+
+  inline
+  float
+  MandelbrotRenderingOptions::getSeriesAreaMargin() noexcept {
+    return 2.0f;
+  }
+
+  inline
+  unsigned
+  MandelbrotRenderingOptions::getReferencePrecision(float extent,
+                                                    const scalar::Arbitrary& size) noexcept
+  {
+    // The reference needs enough bits to represent the coordinates up to the
+    // size of a pixel, plus some margin for the accumulated rounding errors.
+    return 64u + scalar::getResolutionBits(extent, size);
+  }
+
 }
 
 #endif    /* MANDELBROT_RENDERING_OPTIONS_HXX */
@@ -0,0 +1,232 @@
+
+# include "NewtonKernel.hh"
+# include "SimdPacket.hh"
+# include "SimdTraversal.hh"
+
+namespace fractsim {
+  namespace kernels::inline FRACTSIM_KERNELS_VARIANT {
+
+    namespace {
+
+      /**
+       * @brief - Evaluates the polynom and its derivative for a packet of complex
+       *          numbers with a single Horner pass: starting from the coefficient
+       *          of highest degree, the derivative accumulates the values of the
+       *          polynom while it is being built.
+       *          When `Degree` is not null it should be the degree of the polynom
+       *          and the loop is fully unrolled. Otherwise the degree is read from
+       *          the polynom at runtime.
+       * @param poly - the polynom to evaluate.
+       * @param zr - the real part of the numbers at which the polynom is evaluated.
+       * @param zi - the imaginary part of the numbers.
+       * @param vr - output value receiving the real part of the polynom.
+       * @param vi - output value receiving the imaginary part of the polynom.
+       * @param dr - output value receiving the real part of the derivative.
+       * @param di - output value receiving the imaginary part of the derivative.
+       */
+      template <unsigned Degree>
+      inline
+      void
+      horner(const NewtonPolynom& poly,
+             const simd::Floats& zr,
+             const simd::Floats& zi,
+             simd::Floats& vr,
+             simd::Floats& vi,
+             simd::Floats& dr,
+             simd::Floats& di) noexcept
+      {
+        const unsigned degree = (Degree > 0u ? Degree : poly.degree);
+
+        vr = simd::Floats{} + poly.real[degree];
+        vi = simd::Floats{} + poly.imag[degree];
+        dr = simd::Floats{};
+        di = simd::Floats{};
+
+# pragma GCC unroll 8
+        for (unsigned deg = degree ; deg > 0u ; --deg) {
+          simd::Floats tmp = dr * zr - di * zi + vr;
+          di = dr * zi + di * zr + vi;
+          dr = tmp;
+
+          tmp = vr * zr - vi * zi + poly.real[deg - 1u];
+          vi = vr * zi + vi * zr + poly.imag[deg - 1u];
+          vr = tmp;
+        }
+      }
+
+      /**
+       * @brief - Processes all the pixels of the input for the Newton series of the
+       *          input polynom. The `Degree` is forwarded to the evaluation of the
+       *          polynom, see `horner` for more details.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param poly - the polynom for which the series should be iterated.
+       * @param params - the parameters of the series.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param xs - output array receiving the real part of the last term.
+       * @param ys - output array receiving the imaginary part of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <unsigned Degree, typename Input>
+      void
+      newton(const Input& input,
+             const NewtonPolynom& poly,
+             const NewtonParams& params,
+             unsigned* terms,
+             float* xs,
+             float* ys,
+             RenderingStatistics& stats) noexcept
+      {
+        simd::forEachPacket(
+          input,
+          [&](simd::Floats zr,
+              simd::Floats zi,
+              const simd::Mask& valid,
+              const simd::Counters& slots)
+          {
+            simd::Counters t = simd::Counters{};
+            simd::Counters close = simd::Counters{};
+            simd::Mask optimum = simd::Mask{};
+
+            simd::Mask active = valid & (t < params.accuracy) & (close <= params.convergence);
+            unsigned steps = 0u;
+
+            while (simd::any(active)) {
+              ++steps;
+
+              simd::Floats vr, vi, dr, di;
+              horner<Degree>(poly, zr, zi, vr, vi, dr, di);
+
+              simd::Floats dLen = dr * dr + di * di;
+              optimum = active ? (dLen < params.nullThreshold) : optimum;
+
+              // Compute `p / p'` for the lanes which can still be updated.
+              simd::Mask update = active & ~optimum;
+
+              simd::Floats qr = (vr * dr + vi * di) / dLen;
+              simd::Floats qi = (vi * dr - vr * di) / dLen;
+
+              // For large degrees the products overflow far from the origin:
+              // for these lanes the derivative is scaled down before dividing.
+              // Note that an infinite value yields `NaN` when multiplied by 0.
+              simd::Mask overflow = update & (
+                (dLen * 0.0f != 0.0f) | (qr * 0.0f != 0.0f) | (qi * 0.0f != 0.0f)
+              );
+
+              if (simd::any(overflow)) {
+                simd::Floats ar = (dr < 0.0f ? -dr : dr);
+                simd::Floats ai = (di < 0.0f ? -di : di);
+                simd::Floats m = (ar < ai ? ai : ar);
+
+                simd::Floats sr = dr / m, si = di / m;
+                simd::Floats den = (sr * sr + si * si) * m;
+
+                qr = overflow ? (vr * sr + vi * si) / den : qr;
+                qi = overflow ? (vi * sr - vr * si) / den : qi;
+              }
+
+              zr = update ? zr - qr : zr;
+              zi = update ? zi - qi : zi;
+
+              simd::Mask near = (qr * qr + qi * qi) <= params.threshold;
+              close = update ? (near ? close + 1u : simd::Counters{}) : close;
+
+              t -= reinterpret_cast<simd::Counters>(active);
+
+              active = valid & (t < params.accuracy) & ~optimum & (close <= params.convergence);
+            }
+
+            const unsigned long long computed = simd::sum(t);
+
+            stats.iterations += computed;
+            stats.busy += computed;
+            stats.lanes += simd::Width * steps;
+            simd::accumulateSpread(t, valid, stats);
+
+            simd::scatter(t, terms, slots, valid);
+            simd::scatter(zr, xs, slots, valid);
+            simd::scatter(zi, ys, slots, valid);
+          }
+        );
+      }
+
+      /**
+       * @brief - Selects the version of the Newton kernel specialized for the degree
+       *          of the input polynom and uses it to process the input pixels. The
+       *          polynoms with a degree larger than `8` use the generic version.
+       * @param input - the pixels to process, either a block or a list of points.
+       * @param poly - the polynom for which the series should be iterated.
+       * @param params - the parameters of the series.
+       * @param terms - output array receiving the number of terms for each pixel.
+       * @param xs - output array receiving the real part of the last term.
+       * @param ys - output array receiving the imaginary part of the last term.
+       * @param stats - output statistics updated with the work performed.
+       */
+      template <typename Input>
+      void
+      newtonSeries(const Input& input,
+                   const NewtonPolynom& poly,
+                   const NewtonParams& params,
+                   unsigned* terms,
+                   float* xs,
+                   float* ys,
+                   RenderingStatistics& stats) noexcept
+      {
+        switch (poly.degree) {
+          case 1u:
+            newton<1u>(input, poly, params, terms, xs, ys, stats);
+            break;
+          case 2u:
+            newton<2u>(input, poly, params, terms, xs, ys, stats);
+            break;
+          case 3u:
+            newton<3u>(input, poly, params, terms, xs, ys, stats);
+            break;
+          case 4u:
+            newton<4u>(input, poly, params, terms, xs, ys, stats);
+            break;
+          case 5u:
+            newton<5u>(input, poly, params, terms, xs, ys, stats);
+            break;
+          case 6u:
+            newton<6u>(input, poly, params, terms, xs, ys, stats);
+            break;
+          case 7u:
+            newton<7u>(input, poly, params, terms, xs, ys, stats);
+            break;
+          case 8u:
+            newton<8u>(input, poly, params, terms, xs, ys, stats);
+            break;
+          default:
+            newton<0u>(input, poly, params, terms, xs, ys, stats);
+            break;
+        }
+      }
+
+    }
+
+    void
+    newton(const PixelBlock<float>& block,
+           const NewtonPolynom& poly,
+           const NewtonParams& params,
+           unsigned* terms,
+           float* xs,
+           float* ys,
+           RenderingStatistics& stats) noexcept
+    {
+      newtonSeries(block, poly, params, terms, xs, ys, stats);
+    }
+
+    void
+    newton(const PointList<float>& points,
+           const NewtonPolynom& poly,
+           const NewtonParams& params,
+           unsigned* terms,
+           float* xs,
+           float* ys,
+           RenderingStatistics& stats) noexcept
+    {
+      newtonSeries(points, poly, params, terms, xs, ys, stats);
+    }
+
+  }
+}
@@ -0,0 +1,94 @@
+#ifndef    NEWTON_KERNEL_HH
+# define   NEWTON_KERNEL_HH
+
+# include "PixelBlock.hh"
+# include "KernelDispatch.hh"
+# include "RenderingStatistics.hh"
+
+namespace fractsim {
+  namespace kernels {
+
+    /**
+     * @brief - Convenience structure regrouping the values controlling the iterations
+     *          of the Newton series. These are the same values as the ones used by the
+     *          scalar computations of the Newton options.
+     */
+    struct NewtonParams {
+      unsigned accuracy;
+      unsigned convergence;
+      float threshold;
+      float nullThreshold;
+    };
+
+    /**
+     * @brief - Dense description of a polynom with integer degrees. The arrays of
+     *          coefficients are indexed by the degree of the term they apply to and
+     *          contain `degree + 1` elements: missing terms are represented with a
+     *          `0` coefficient. The derivative is computed along with the polynom
+     *          so it does not need to be provided.
+     */
+    struct NewtonPolynom {
+      unsigned degree;
+
+      const float* real;
+      const float* imag;
+    };
+
+  }
+
+  namespace kernels::inline FRACTSIM_KERNELS_VARIANT {
+
+    /**
+     * @brief - Iterates the Newton series `z(n+1) = z(n) - p(z(n)) / p'(z(n))` for
+     *          each pixel of a block. The polynom and its derivative are evaluated
+     *          for a whole packet of pixels at once, and each lane is disabled as
+     *          soon as it converged, reached a null value of the derivative or the
+     *          accuracy.
+     *          The termination condition is identical to the one of the scalar path.
+     * @param block - the block of pixels to process.
+     * @param poly - the polynom for which the series should be iterated.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel.
+     * @param xs - output array receiving the real part of the last term of the series
+     *             for each pixel.
+     * @param ys - output array receiving the imaginary part of the last term of the
+     *             series for each pixel.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    newton(const PixelBlock<float>& block,
+           const NewtonPolynom& poly,
+           const NewtonParams& params,
+           unsigned* terms,
+           float* xs,
+           float* ys,
+           RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Similar to the above method but processes an arbitrary list of
+     *          pixels instead of a block.
+     * @param points - the list of pixels to process.
+     * @param poly - the polynom for which the series should be iterated.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel.
+     * @param xs - output array receiving the real part of the last term of the series
+     *             for each pixel.
+     * @param ys - output array receiving the imaginary part of the last term of the
+     *             series for each pixel.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    newton(const PointList<float>& points,
+           const NewtonPolynom& poly,
+           const NewtonParams& params,
+           unsigned* terms,
+           float* xs,
+           float* ys,
+           RenderingStatistics& stats) noexcept;
+
+  }
+}
+
+#endif    /* NEWTON_KERNEL_HH */
@@ -2,6 +2,7 @@
 # include "NewtonOptions.hh"
 # include <sstream>
 # include <iomanip>
+# include <algorithm>
 # include <sdl_graphic/GridLayout.hh>
 # include <sdl_graphic/LabelWidget.hh>
 # include <sdl_graphic/TextBox.hh>
@@ -19,7 +20,7 @@ namespace fractsim {
                  parent),
 
     m_propsLocker(),
-    m_maxDegree(maxDegree)
+    m_maxDegree(std::max(maxDegree, getTermsCount() - 1u))
   {
     build();
   }
@@ -42,19 +43,26 @@ namespace fractsim {
     bool converted = false;
     std::vector<NewtonRenderingOptions::Coefficient> coeffs;
 
-    for (unsigned deg = 0u ; deg <= m_maxDegree ; ++deg) {
+    for (unsigned term = 0u ; term < getTermsCount() ; ++term) {
+      sdl::graphic::TextBox* degTB = getChildAs<sdl::graphic::TextBox>(
+        getDegreeValueName(term)
+      );
       sdl::graphic::TextBox* realTB = getChildAs<sdl::graphic::TextBox>(
-        getCoefficientRealPartValueName(deg)
+        getCoefficientRealPartValueName(term)
       );
       sdl::graphic::TextBox* imgTB = getChildAs<sdl::graphic::TextBox>(
-        getCoefficientImgPartValueName(deg)
+        getCoefficientImgPartValueName(term)
       );
 
+      std::string degText = degTB->getValue();
       std::string realText = realTB->getValue();
       std::string imgText = imgTB->getValue();
 
-      float realC = utils::convert(realText, getDefaultRealPartCoefficient(deg), converted);
-      float imgC = utils::convert(imgText, getDefaultImgPartCoefficient(deg), converted);
+      unsigned deg = utils::convert(degText, getDefaultDegree(term), converted);
+      float realC = utils::convert(realText, getDefaultRealPartCoefficient(term), converted);
+      float imgC = utils::convert(imgText, getDefaultImgPartCoefficient(term), converted);
+
+      deg = std::min(deg, m_maxDegree);
 
       coeffs.push_back(NewtonRenderingOptions::Coefficient{1.0f * deg, utils::Vector2f(realC, imgC)});
     }
@@ -73,14 +81,14 @@ namespace fractsim {
   void
   NewtonOptions::build() {
     // Assign a linear layout which will allow positionning items and icons.
-    // Note that we need 3 labels for each coefficient of the polynom and 3
-    // more for the constant. We also need to set the accuracy of the process
-    // which means another 2 elements.
+    // Note that we need 4 elements for each term of the polynom (a label, the
+    // degree and both parts of the coefficient). We also need to set the
+    // accuracy of the process which means another 2 elements.
     sdl::graphic::GridLayoutShPtr layout = std::make_shared<sdl::graphic::GridLayout>(
       "newton_options_layout",
       this,
       1u,
-      2u + (1u + m_maxDegree) * 3u // Don't forget the constant.
+      2u + getTermsCount() * 4u
     );
 
     // And assign the layout to this widget.
@@ -91,42 +99,38 @@ namespace fractsim {
     sdl::graphic::LabelWidget* accuracyLabel = createLabel("accuracy_label", "Accuracy:", this);
     sdl::graphic::TextBox* accuracyValue = createTextBox("accuracy_value", this);
 
-    sdl::graphic::LabelWidget* constantLabel = createLabel("constant_label", "Constant:", this);
-    sdl::graphic::TextBox* realPartConstant = createTextBox(getCoefficientRealPartValueName(0u), this);
-    sdl::graphic::TextBox* imgPartConstant = createTextBox(getCoefficientImgPartValueName(0u), this);
+    for (unsigned term = 0u ; term < getTermsCount() ; ++term) {
+      std::string termStr = std::to_string(term + 1u);
 
-    for (unsigned deg = 0u ; deg < m_maxDegree ; ++deg) {
-      std::string degStr = std::to_string(deg + 1u);
-
-      sdl::graphic::LabelWidget* labelDeg = createLabel(
-        "deg_" + degStr + "_label",
-        "Degree " + degStr + ":",
+      sdl::graphic::LabelWidget* labelTerm = createLabel(
+        "term_" + termStr + "_label",
+        "Term " + termStr + ":",
         this
       );
 
-      sdl::graphic::TextBox* realPartDeg = createTextBox(
-        getCoefficientRealPartValueName(deg + 1u),
+      sdl::graphic::TextBox* degTerm = createTextBox(
+        getDegreeValueName(term),
+        this
+      );
+      sdl::graphic::TextBox* realPartTerm = createTextBox(
+        getCoefficientRealPartValueName(term),
         this
       );
-      sdl::graphic::TextBox* imgPartDeg = createTextBox(
-        getCoefficientImgPartValueName(deg + 1u),
+      sdl::graphic::TextBox* imgPartTerm = createTextBox(
+        getCoefficientImgPartValueName(term),
         this
       );
 
-      // Each degree is added sequentially after the accuracy
-      // elements and the constant elements.
-      layout->addItem(labelDeg,    0, 5u + 3u * deg + 0u, 1, 1);
-      layout->addItem(realPartDeg, 0, 5u + 3u * deg + 1u, 1, 1);
-      layout->addItem(imgPartDeg,  0, 5u + 3u * deg + 2u, 1, 1);
+      // Each term is added sequentially after the accuracy elements.
+      layout->addItem(labelTerm,    0, 2u + 4u * term + 0u, 1, 1);
+      layout->addItem(degTerm,      0, 2u + 4u * term + 1u, 1, 1);
+      layout->addItem(realPartTerm, 0, 2u + 4u * term + 2u, 1, 1);
+      layout->addItem(imgPartTerm,  0, 2u + 4u * term + 3u, 1, 1);
     }
 
     layout->addItem(accuracyLabel, 0, 0, 1, 1);
     layout->addItem(accuracyValue, 0, 1, 1, 1);
 
-    layout->addItem(constantLabel,    0, 2, 1, 1);
-    layout->addItem(realPartConstant, 0, 3, 1, 1);
-    layout->addItem(imgPartConstant,  0, 4, 1, 1);
-
     // Assign default values to elements.
     initElements();
   }
@@ -144,23 +148,28 @@ namespace fractsim {
 
     formatter << std::fixed << std::setprecision(1);
 
-    for (unsigned deg = 0u ; deg <= m_maxDegree ; ++deg) {
+    for (unsigned term = 0u ; term < getTermsCount() ; ++term) {
+      sdl::graphic::TextBox* degTB = getChildAs<sdl::graphic::TextBox>(
+        getDegreeValueName(term)
+      );
       sdl::graphic::TextBox* realTB = getChildAs<sdl::graphic::TextBox>(
-        getCoefficientRealPartValueName(deg)
+        getCoefficientRealPartValueName(term)
       );
       sdl::graphic::TextBox* imgTB = getChildAs<sdl::graphic::TextBox>(
-        getCoefficientImgPartValueName(deg)
+        getCoefficientImgPartValueName(term)
       );
 
       // Assign default values.
+      degTB->setValue(std::to_string(getDefaultDegree(term)));
+
       formatter.str("");
       formatter.clear();
-      formatter << getDefaultRealPartCoefficient(deg);
+      formatter << getDefaultRealPartCoefficient(term);
       realTB->setValue(formatter.str());
 
       formatter.str("");
       formatter.clear();
-      formatter << getDefaultImgPartCoefficient(deg);
+      formatter << getDefaultImgPartCoefficient(term);
       imgTB->setValue(formatter.str());
     }
   }
@@ -17,8 +17,12 @@ namespace fractsim {
        *          The information needed to be able to draw one includes the
        *          coefficient of the polynom to `solve` along with desired
        *          accuracy for the computations.
+       *          The polynom is described by a list of terms each defined by a
+       *          degree and a coefficient, so that polynoms with a large degree
+       *          can be described with only a few values.
        * @param maxDegree - the maximum degree of the polynom handled by the
-       *                    options panel.
+       *                    options panel. It is at least large enough to give
+       *                    a distinct degree to each term.
        * @param hint - the size hint for this widget.
        * @param parent - the parent of this widget.
        */
@@ -46,23 +50,32 @@ namespace fractsim {
 
     private:
 
+      /**
+       * @brief - Returns a default name for the textbox receiving the degree of the
+       *          input term.
+       * @return - a name for the degree of the term.
+       */
+      static
+      std::string
+      getDegreeValueName(unsigned term) noexcept;
+
       /**
        * @brief - Returns a default name for the textbox receiving the real part of
-       *          the coefficient for the input degree.
+       *          the coefficient for the input term.
        * @return - a name for the real part of the coefficient.
        */
       static
       std::string
-      getCoefficientRealPartValueName(unsigned degree) noexcept;
+      getCoefficientRealPartValueName(unsigned term) noexcept;
 
       /**
        * @brief - Returns a default name for the textbox receiving the imaginary
-       *          part of the coefficient for the input degree.
+       *          part of the coefficient for the input term.
        * @return - a name for the imaginary part of the coefficient.
        */
       static
       std::string
-      getCoefficientImgPartValueName(unsigned degree) noexcept;
+      getCoefficientImgPartValueName(unsigned term) noexcept;
 
       /**
        * @brief - Returns a default name for the accuracy textbox.
@@ -80,26 +93,47 @@ namespace fractsim {
       unsigned
       getDefaultAccuracy() noexcept;
 
+      /**
+       * @brief - Returns the number of terms of the polynom that can be configured
+       *          with the settings available on this panel.
+       * @return - the number of terms of the polynom.
+       */
+      static
+      unsigned
+      getTermsCount() noexcept;
+
+      /**
+       * @brief - Returns a default value for the degree of the input term. The first
+       *          and last terms are assigned the degrees `0` and `5` (or the maximum
+       *          degree if it is smaller) so that along with the default coefficients
+       *          the polynom is `z^5 - 1`. The other terms have a null coefficient
+       *          and receive distinct degrees in between.
+       * @param term - the index of the term.
+       * @return - a default value for the degree of the term.
+       */
+      unsigned
+      getDefaultDegree(unsigned term) const noexcept;
+
       /**
        * @brief - Returns a default value for the real component of the coefficient
        *          associated to the Newton polynomial fractal for the specified
-       *          degree.
-       * @param degree - the degree of the coefficient to retrieve.
+       *          term.
+       * @param term - the index of the term of the coefficient to retrieve.
        * @return - a default value for the real part of the coefficent.
        */
       static
       float
-      getDefaultRealPartCoefficient(unsigned degree) noexcept;
+      getDefaultRealPartCoefficient(unsigned term) noexcept;
 
       /**
        * @brief - Returns a default value for the imaginary component of the coefficient
-       *          associated to the Newton polynomial fractal for the specified degree.
-       * @param degree - the degree of the coefficient to retrieve.
+       *          associated to the Newton polynomial fractal for the specified term.
+       * @param term - the index of the term of the coefficient to retrieve.
        * @return - a default value for the imaginary part of the coefficent.
        */
       static
       float
-      getDefaultImgPartCoefficient(unsigned degree) noexcept;
+      getDefaultImgPartCoefficient(unsigned term) noexcept;
 
       /**
        * @brief - Used to create the layout of this options panel. This method
@@ -124,7 +158,8 @@ namespace fractsim {
 
       /**
        * @brief - Describes the maximum degree of the polynom that can be configured
-       *          with the settings available on this panel.
+       *          with the settings available on this panel. Larger degrees are
+       *          clamped.
        */
       unsigned m_maxDegree;
   };
@@ -2,6 +2,7 @@
 # define   NEWTON_OPTIONS_HXX
 
 # include "NewtonOptions.hh"
+# include <algorithm>
 
 namespace fractsim {
 
@@ -25,14 +26,20 @@ namespace fractsim {
 
   inline
   std::string
-  NewtonOptions::getCoefficientRealPartValueName(unsigned degree) noexcept {
-    return "deg_" + std::to_string(degree) + "_real_part";
+  NewtonOptions::getDegreeValueName(unsigned term) noexcept {
+    return "term_" + std::to_string(term) + "_degree";
   }
 
   inline
   std::string
-  NewtonOptions::getCoefficientImgPartValueName(unsigned degree) noexcept {
-    return "deg_" + std::to_string(degree) + "_img_part";
+  NewtonOptions::getCoefficientRealPartValueName(unsigned term) noexcept {
+    return "term_" + std::to_string(term) + "_real_part";
+  }
+
+  inline
+  std::string
+  NewtonOptions::getCoefficientImgPartValueName(unsigned term) noexcept {
+    return "term_" + std::to_string(term) + "_img_part";
   }
 
   inline
@@ -47,13 +54,31 @@ namespace fractsim {
     return 128u;
   }
 
+  inline
+  unsigned
+  NewtonOptions::getTermsCount() noexcept {
+    return 4u;
+  }
+
+  inline
+  unsigned
+  NewtonOptions::getDefaultDegree(unsigned term) const noexcept {
+    // The maximum degree is at least the number of terms minus one so the
+    // leading degree is above the degree of all the other terms.
+    if (term + 1u == getTermsCount()) {
+      return std::min(5u, m_maxDegree);
+    }
+
+    return term;
+  }
+
   inline
   float
-  NewtonOptions::getDefaultRealPartCoefficient(unsigned degree) noexcept {
-    if (degree == 5u) {
+  NewtonOptions::getDefaultRealPartCoefficient(unsigned term) noexcept {
+    if (term + 1u == getTermsCount()) {
       return 1.0f;
     }
-    if (degree == 0u) {
+    if (term == 0u) {
       return -1.0f;
     }
 
@@ -62,8 +87,8 @@ namespace fractsim {
 
   inline
   float
-  NewtonOptions::getDefaultImgPartCoefficient(unsigned /*degree*/) noexcept {
-    // The degree is not used.
+  NewtonOptions::getDefaultImgPartCoefficient(unsigned /*term*/) noexcept {
+    // The term is not used.
     return 0.0f;
   }
 
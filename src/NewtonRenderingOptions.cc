@@ -1,5 +1,8 @@
 
 # include "NewtonRenderingOptions.hh"
+# include <algorithm>
+# include <cmath>
+# include <variant>
 # include "ColorPalette.hh"
 
 namespace fractsim {
@@ -14,7 +17,11 @@ namespace fractsim {
     m_coefficients(),
     m_derivative(),
 
+    m_denseReal(),
+    m_denseImag(),
+
     m_maxDegree(),
+
     m_roots()
   {
     initialize(coeffs);
@@ -32,93 +39,149 @@ namespace fractsim {
     // polynom.
     // At this point we have to assign a value to the polynom which is the
     // index of the root.
-
-    // Iterate the function
-    unsigned acc = getAccuracy();
-    unsigned conv = getConvergenceDuration();
-    float thresh = getConvergenceThreshold();
-    unsigned terms = 0u;
     std::complex<float> cur(c.x(), c.y());
-    std::complex<float> p, pp;
+    std::complex<float> p;
 
-    bool optimum = false;
-    unsigned close = 0u;
+    unsigned terms = iterate(cur, p);
 
+    // Determine the confidence for this point by scanning the roots of the
+    // polynom and checking if any is close enough of the value we reached
+    // for this series. The roots are computed beforehand so there's no need
+    // to protect this section.
+    int idRoot = m_roots.find(cur.real(), cur.imag());
 
-    while (terms < acc && !optimum && close <= conv) {
-      evaluate(cur, p, pp);
-      optimum = std::norm(pp) < getNullThreshold();
+    // There are points which do not converge to any root of the polynom (for
+    // example points where the derivative is `null` but the polynom itself is
+    // not null: in such cases the method is stuck at this point forever).
+    if (idRoot < 0) {
+      return 0.0f;
+    }
 
-      if (!optimum) {
-        std::complex<float> tmp = p / pp;
-        cur -= tmp;
+    // We have the index of the root that the series converged to. We know
+    // need to position the value in the interval based on the convergence
+    // speed.
+    return getColorPosFromRoot(idRoot, terms);
+  }
 
-        if (std::norm(tmp) <= thresh) {
-          ++close;
-        }
-        else {
-          close = 0u;
+  void
+  NewtonRenderingOptions::computeBlockPrivate(scalar::AnyOf<kernels::PixelBlock> block,
+                                              float* out,
+                                              RenderingStatistics& stats) const noexcept
+  {
+    // The other precisions are computed point by point by the base class.
+    const kernels::PixelBlock<float>* const* single = std::get_if<const kernels::PixelBlock<float>*>(&block);
+    if (single == nullptr) {
+      FractalOptions::computeBlockPrivate(block, out, stats);
+      return;
+    }
+
+    const kernels::PixelBlock<float>& values = **single;
+
+    // The vectorized kernel only handles polynoms with integer degrees: for
+    // the other cases we compute each point individually. Note that we avoid
+    // the virtual dispatch by explicitly calling the local method.
+    if (m_denseReal.empty()) {
+      for (unsigned y = 0u ; y < values.h ; ++y) {
+        for (unsigned x = 0u ; x < values.w ; ++x) {
+          out[y * values.w + x] = NewtonRenderingOptions::compute(
+            utils::Vector2f(values.xMin + x * values.stepX, values.yMin + y * values.stepY)
+          );
         }
       }
 
-      ++terms;
+      return;
     }
 
-    // Determine the confidence for this point by scanning the roots found
-    // so far and checking if any is close enough of the value we reached
-    // for this series.
-    // To make sure that people can call the computing method in parallel
-    // we will protect this critical section behind a locker.
-    const std::lock_guard guard(m_propsLocker);
+    unsigned count = values.w * values.h;
 
-    unsigned idRoot = 0u;
-    bool found = false;
+    std::vector<unsigned> terms(count, 0u);
+    std::vector<float> xs(count, 0.0f);
+    std::vector<float> ys(count, 0.0f);
 
-    while (idRoot < m_roots.size() && !found) {
-      found = (
-        utils::fuzzyEqual(cur.real(), m_roots[idRoot].real(), getRootEqualityThreshold()) &&
-        utils::fuzzyEqual(cur.imag(), m_roots[idRoot].imag(), getRootEqualityThreshold())
-      );
+    kernels::newton(
+      values,
+      getKernelPolynom(),
+      getKernelParams(),
+      terms.data(),
+      xs.data(),
+      ys.data(),
+      stats
+    );
 
-      ++idRoot;
-    }
+    assignRoots(count, terms, xs, ys, out);
+  }
 
-    // Account for the fact that even when we find the root we actually also
-    // increment the root index.
-    if (found) {
-      --idRoot;
+  void
+  NewtonRenderingOptions::computePointsPrivate(scalar::AnyOf<kernels::PointList> points,
+                                               float* out,
+                                               RenderingStatistics& stats) const noexcept
+  {
+    const kernels::PointList<float>* const* single = std::get_if<const kernels::PointList<float>*>(&points);
+    if (single == nullptr) {
+      FractalOptions::computePointsPrivate(points, out, stats);
+      return;
     }
 
-    // In any case, we want the value to be assigned to the palette entry
-    // matching the index of the root in the internal array. This can be
-    // done by setting a value of `rootStep * accuracy` where the `rootStep`
-    // is just the number of roots that this polynom can have.
-    //
-    // If we found a root matching the value reached by the series, assign
-    // this value and otherwise add the root to the list and set the value.
-    // Without loss of generality we can assign the root and then use the
-    // `idRoot` as a valid value.
-    float perc = 0.0f;
-
-    if (!found) {
-      // This is a fair attempt at finding a root. We have to evaluate that
-      // it is indeed a root. There are points which do not converge to any
-      // root of the polynom (for example points where the derivative is
-      // `null` but the polynom itself is not null: in such cases the method
-      // is stuck at this point forever).
-      if (std::norm(p) < getNullThreshold()) {
-        m_roots.push_back(cur);
+    const kernels::PointList<float>& values = **single;
+    unsigned count = values.count;
+
+    if (m_denseReal.empty()) {
+      for (unsigned id = 0u ; id < count ; ++id) {
+        out[id] = NewtonRenderingOptions::compute(utils::Vector2f(values.xs[id], values.ys[id]));
       }
-    }
 
-    if (found) {
-      // We have the index of the root that the series converged to. We know
-      // need to position the value in the interval based on the convergence
-      // speed.
-      perc = getColorPosFromRoot(idRoot, terms);
+      return;
     }
 
-    return perc;
+    std::vector<unsigned> terms(count, 0u);
+    std::vector<float> lastX(count, 0.0f);
+    std::vector<float> lastY(count, 0.0f);
+
+    kernels::newton(
+      values,
+      getKernelPolynom(),
+      getKernelParams(),
+      terms.data(),
+      lastX.data(),
+      lastY.data(),
+      stats
+    );
+
+    assignRoots(count, terms, lastX, lastY, out);
+  }
+
+  kernels::NewtonPolynom
+  NewtonRenderingOptions::getKernelPolynom() const noexcept {
+    return kernels::NewtonPolynom{
+      static_cast<unsigned>(m_denseReal.size() - 1u),
+      m_denseReal.data(),
+      m_denseImag.data()
+    };
+  }
+
+  kernels::NewtonParams
+  NewtonRenderingOptions::getKernelParams() const noexcept {
+    return kernels::NewtonParams{
+      getAccuracy(),
+      getConvergenceDuration(),
+      getConvergenceThreshold(),
+      getNullThreshold()
+    };
+  }
+
+  void
+  NewtonRenderingOptions::assignRoots(unsigned count,
+                                      const std::vector<unsigned>& terms,
+                                      const std::vector<float>& xs,
+                                      const std::vector<float>& ys,
+                                      float* out) const noexcept
+  {
+    // The roots are not modified while rendering so all the points can be
+    // matched without locking.
+    for (unsigned id = 0u ; id < count ; ++id) {
+      int idRoot = m_roots.find(xs[id], ys[id]);
+      out[id] = (idRoot < 0 ? 0.0f : getColorPosFromRoot(idRoot, terms[id]));
+    }
   }
 
   void
@@ -195,19 +258,293 @@ namespace fractsim {
     for (unsigned id = 0u ; id < m_coefficients.size() ; ++id) {
       const InternalCoefficient& a = m_coefficients[id];
 
-      // For now only handle cases where the degree is at least `1` in the derivative.
-      if (a.degree > 1.0f) {
+      // Constant terms do not contribute to the derivative.
+      if (a.degree != 0.0f) {
         m_derivative.push_back(InternalCoefficient{a.degree - 1.0f, a.degree * a.coeff});
       }
     }
   }
 
+  void
+  NewtonRenderingOptions::computeDenseCoefficients() {
+    m_denseReal.clear();
+    m_denseImag.clear();
+
+    // Check whether all the degrees are positive integers: if this is not
+    // the case the polynom can't be represented densely.
+    float maxDegree = 0.0f;
+
+    for (unsigned id = 0u ; id < m_coefficients.size() ; ++id) {
+      float deg = m_coefficients[id].degree;
+      if (deg < 0.0f || std::floor(deg) != deg) {
+        return;
+      }
+
+      maxDegree = std::max(maxDegree, deg);
+    }
+
+    unsigned size = static_cast<unsigned>(maxDegree) + 1u;
+
+    m_denseReal.resize(size, 0.0f);
+    m_denseImag.resize(size, 0.0f);
+
+    for (unsigned id = 0u ; id < m_coefficients.size() ; ++id) {
+      unsigned deg = static_cast<unsigned>(m_coefficients[id].degree);
+
+      m_denseReal[deg] += m_coefficients[id].coeff.real();
+      m_denseImag[deg] += m_coefficients[id].coeff.imag();
+    }
+  }
+
+  void
+  NewtonRenderingOptions::computeRoots() {
+    std::vector<std::complex<double>> roots = (
+      m_denseReal.empty() ?
+      computeSeededRoots() :
+      computeAberthRoots()
+    );
+
+    // Sort the roots so that their order (and thus the colors associated to
+    // them) only depends on their position.
+    std::sort(
+      roots.begin(),
+      roots.end(),
+      [](const std::complex<double>& lhs, const std::complex<double>& rhs) {
+        double al = std::arg(lhs), ar = std::arg(rhs);
+        return al < ar || (al == ar && std::norm(lhs) < std::norm(rhs));
+      }
+    );
+
+    // Multiple roots (or the same root reached from several starting points)
+    // are only registered once.
+    std::vector<float> xs, ys;
+
+    for (unsigned id = 0u ; id < roots.size() ; ++id) {
+      float x = roots[id].real();
+      float y = roots[id].imag();
+
+      unsigned root = 0u;
+      while (root < xs.size() &&
+             !(utils::fuzzyEqual(x, xs[root], getRootEqualityThreshold()) &&
+               utils::fuzzyEqual(y, ys[root], getRootEqualityThreshold())))
+      {
+        ++root;
+      }
+
+      if (root == xs.size()) {
+        xs.push_back(x);
+        ys.push_back(y);
+      }
+    }
+
+    m_roots = RootsGrid(xs, ys, getRootEqualityThreshold());
+
+    debug("Found " + std::to_string(xs.size()) + " root(s) for the polynom");
+  }
+
+  std::vector<std::complex<double>>
+  NewtonRenderingOptions::computeAberthRoots() const {
+    auto coeff = [this](unsigned deg) {
+      return std::complex<double>(m_denseReal[deg], m_denseImag[deg]);
+    };
+
+    // The leading coefficients might be null, in which case the degree of
+    // the polynom is smaller than the size of the dense representation.
+    unsigned degree = m_denseReal.size() - 1u;
+    while (degree > 0u && coeff(degree) == 0.0) {
+      --degree;
+    }
+
+    std::vector<std::complex<double>> roots;
+    if (degree == 0u) {
+      return roots;
+    }
+
+    // All the roots lie within a circle whose radius is given by the bound
+    // of Fujiwara. The starting points are spread along this circle with a
+    // slight rotation so that they are not aligned with symmetric roots.
+    double lead = std::abs(coeff(degree));
+    double radius = 0.0;
+
+    for (unsigned deg = 0u ; deg < degree ; ++deg) {
+      radius = std::max(radius, std::pow(std::abs(coeff(deg)) / lead, 1.0 / (degree - deg)));
+    }
+
+    if (radius == 0.0) {
+      // The polynom is a monomial: all the roots are null.
+      roots.resize(degree, std::complex<double>(0.0, 0.0));
+      return roots;
+    }
+
+    for (unsigned id = 0u ; id < degree ; ++id) {
+      roots.push_back(std::polar(2.0 * radius, 2.0 * M_PI * id / degree + 0.4));
+    }
+
+    // Refine all the roots at once: each step is the Newton step corrected
+    // by the repulsion of the other roots, which prevents several of them
+    // from converging to the same value.
+    unsigned iteration = 0u;
+    bool converged = false;
+
+    while (iteration < getRootsMaxIterations() && !converged) {
+      converged = true;
+
+      for (unsigned id = 0u ; id < degree ; ++id) {
+        const std::complex<double>& z = roots[id];
+
+        std::complex<double> p = coeff(degree);
+        std::complex<double> pp(0.0, 0.0);
+
+        for (unsigned deg = degree ; deg > 0u ; --deg) {
+          pp = pp * z + p;
+          p = p * z + coeff(deg - 1u);
+        }
+
+        std::complex<double> repulsion(0.0, 0.0);
+        for (unsigned other = 0u ; other < degree ; ++other) {
+          if (other != id && roots[other] != z) {
+            repulsion += 1.0 / (z - roots[other]);
+          }
+        }
+
+        std::complex<double> w = p / (pp - p * repulsion);
+        if (!std::isfinite(w.real()) || !std::isfinite(w.imag())) {
+          continue;
+        }
+
+        roots[id] -= w;
+
+        if (std::abs(w) > getRootsPrecision() * std::max(1.0, std::abs(roots[id]))) {
+          converged = false;
+        }
+      }
+
+      ++iteration;
+    }
+
+    if (!converged) {
+      warn("Roots of the polynom did not converge after " + std::to_string(iteration) + " iteration(s)");
+    }
+
+    return roots;
+  }
+
+  std::vector<std::complex<double>>
+  NewtonRenderingOptions::computeSeededRoots() const {
+    std::vector<std::complex<double>> roots;
+
+    // Use the default rendering window as it should contain the interesting
+    // part of the fractal, and thus the roots reached by the series.
+    utils::Boxf area = getDefaultRenderingWindow();
+    unsigned count = getRootsSeedsCount();
+
+    for (unsigned y = 0u ; y < count ; ++y) {
+      for (unsigned x = 0u ; x < count ; ++x) {
+        std::complex<float> z(
+          area.getLeftBound() + (x + 0.5f) * area.w() / count,
+          area.getBottomBound() + (y + 0.5f) * area.h() / count
+        );
+        std::complex<float> p;
+
+        iterate(z, p);
+
+        // Only keep the values which are actual roots of the polynom.
+        if (std::norm(p) < getNullThreshold()) {
+          roots.push_back(std::complex<double>(z.real(), z.imag()));
+        }
+      }
+    }
+
+    return roots;
+  }
+
+  unsigned
+  NewtonRenderingOptions::iterate(std::complex<float>& z,
+                                  std::complex<float>& p) const noexcept
+  {
+    unsigned acc = getAccuracy();
+    unsigned conv = getConvergenceDuration();
+    float thresh = getConvergenceThreshold();
+    unsigned terms = 0u;
+    std::complex<float> pp;
+
+    bool optimum = false;
+    unsigned close = 0u;
+
+    while (terms < acc && !optimum && close <= conv) {
+      evaluate(z, p, pp);
+
+      float len = std::norm(pp);
+      optimum = len < getNullThreshold();
+
+      if (!optimum) {
+        // The quotient is expanded just like in the vectorized kernel, which
+        // also avoids the special cases handled by the complex division.
+        std::complex<float> tmp(
+          (p.real() * pp.real() + p.imag() * pp.imag()) / len,
+          (p.imag() * pp.real() - p.real() * pp.imag()) / len
+        );
+
+        // For large degrees the products overflow far from the origin: the
+        // derivative is then scaled down before dividing.
+        if (!std::isfinite(len) || !std::isfinite(tmp.real()) || !std::isfinite(tmp.imag())) {
+          float m = std::max(std::abs(pp.real()), std::abs(pp.imag()));
+
+          float sr = pp.real() / m, si = pp.imag() / m;
+          float den = (sr * sr + si * si) * m;
+
+          tmp = std::complex<float>(
+            (p.real() * sr + p.imag() * si) / den,
+            (p.imag() * sr - p.real() * si) / den
+          );
+        }
+
+        z -= tmp;
+
+        if (std::norm(tmp) <= thresh) {
+          ++close;
+        }
+        else {
+          close = 0u;
+        }
+      }
+
+      ++terms;
+    }
+
+    return terms;
+  }
+
   void
   NewtonRenderingOptions::evaluate(const std::complex<float>& x,
                                    std::complex<float>& p,
                                    std::complex<float>& pp) const noexcept
   {
-    // Compute the value of the polynom.
+    // In case the polynom is available in its dense form, evaluate it along
+    // with its derivative in a single Horner pass: starting from the highest
+    // degree, the derivative accumulates the successive values of the polynom.
+    // The operations are the same as the ones of the vectorized kernel.
+    if (!m_denseReal.empty()) {
+      float vr = m_denseReal.back(), vi = m_denseImag.back();
+      float dr = 0.0f, di = 0.0f;
+
+      for (unsigned deg = m_denseReal.size() - 1u ; deg > 0u ; --deg) {
+        float tmp = dr * x.real() - di * x.imag() + vr;
+        di = dr * x.imag() + di * x.real() + vi;
+        dr = tmp;
+
+        tmp = vr * x.real() - vi * x.imag() + m_denseReal[deg - 1u];
+        vi = vr * x.imag() + vi * x.real() + m_denseImag[deg - 1u];
+        vr = tmp;
+      }
+
+      p = std::complex<float>(vr, vi);
+      pp = std::complex<float>(dr, di);
+
+      return;
+    }
+
+    // Otherwise compute each term of the polynom and its derivative.
     p = std::complex<float>(0.0f, 0.0f);
     pp = std::complex<float>(0.0f, 0.0f);
 
@@ -4,9 +4,12 @@
 # include <memory>
 # include <vector>
 # include <complex>
+# include <mutex>
 # include <maths_utils/Vector2.hh>
 # include <maths_utils/Box.hh>
 # include "FractalOptions.hh"
+# include "NewtonKernel.hh"
+# include "RootsGrid.hh"
 
 namespace fractsim {
 
@@ -50,9 +53,9 @@ namespace fractsim {
        *          the input point belongs to the Newton polynomial fractal or not.
        *          This function does not lock the properties mutex while computing
        *          the series *which means that we don't support concurrent changes
-       *          to the coefficients while a computation is being performed*. It
-       *          does handle the creation of roots in a thread-safe manner though
-       *          and can be used concurrently.
+       *          to the coefficients while a computation is being performed*. The
+       *          roots of the polynom are computed beforehand and only read here
+       *          so that this method can be used concurrently without locking.
        * @param c - the point to determine whether it belongs to the fractal.
        * @return - a value indicating the level of confidence that this point is
        *           part of the fractal.
@@ -63,6 +66,38 @@ namespace fractsim {
       void
       setCoefficients(const std::vector<Coefficient>& coeffs) noexcept;
 
+    protected:
+
+      /**
+       * @brief - Specialization of the base class to process a whole block of points
+       *          at once. When all the degrees of the polynom are positive integers
+       *          the series are iterated through a vectorized kernel, otherwise each
+       *          point is computed individually.
+       *          The roots are matched once for the whole block. Only the single
+       *          precision is supported by Newton fractals: the other ones are left
+       *          to the base class.
+       * @param block - the block of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      void
+      computeBlockPrivate(scalar::AnyOf<kernels::PixelBlock> block,
+                          float* out,
+                          RenderingStatistics& stats) const noexcept override;
+
+      /**
+       * @brief - Specialization of the base class to process a list of points at
+       *          once. Just like for `computeBlockPrivate` a vectorized kernel is
+       *          used when all the degrees of the polynom are positive integers.
+       * @param points - the list of points to compute.
+       * @param out - output array receiving the confidence of each point.
+       * @param stats - output statistics updated with the work performed.
+       */
+      void
+      computePointsPrivate(scalar::AnyOf<kernels::PointList> points,
+                           float* out,
+                           RenderingStatistics& stats) const noexcept override;
+
     private:
 
       /**
@@ -115,6 +150,37 @@ namespace fractsim {
       unsigned
       getConvergenceDuration() noexcept;
 
+      /**
+       * @brief - Used to retrieve the maximum number of iterations performed when
+       *          computing the roots of the polynom. The method usually converges
+       *          in a few tens of iterations.
+       * @return - the maximum number of iterations to compute the roots.
+       */
+      static
+      unsigned
+      getRootsMaxIterations() noexcept;
+
+      /**
+       * @brief - Used to retrieve the threshold below which the correction applied
+       *          to the roots during their computation is considered small enough
+       *          to stop the process. The value is relative to the modulus of the
+       *          roots.
+       * @return - the convergence threshold for the computation of the roots.
+       */
+      static
+      double
+      getRootsPrecision() noexcept;
+
+      /**
+       * @brief - Used to retrieve the number of starting points along each axis of
+       *          the grid used to find the roots of polynoms that do not have only
+       *          integer degrees.
+       * @return - the number of seeds along each axis.
+       */
+      static
+      unsigned
+      getRootsSeedsCount() noexcept;
+
       /**
        * @brief - Return a value representing the available interval from the range `[0; 1]`
        *          is available to represent the roots colors.
@@ -152,10 +218,68 @@ namespace fractsim {
       void
       computeDerivative();
 
+      /**
+       * @brief - Used whenever the coefficients of the polynom are changed to update
+       *          the dense representation of the polynom used by the Horner scheme.
+       *          In case some degrees are not integers (or are negative) the dense
+       *          representation is left empty.
+       *          Assumes that the locker is already acquired.
+       */
+      void
+      computeDenseCoefficients();
+
+      /**
+       * @brief - Used whenever the coefficients of the polynom are changed to update
+       *          the list of roots. When the polynom can be represented densely, its
+       *          roots are computed with the Aberth method. Otherwise the series are
+       *          iterated from a grid of starting points and the values they reach
+       *          are collected.
+       *          The roots are sorted by argument so that the colors assigned to them
+       *          do not depend on the order in which they were found.
+       *          Assumes that the locker is already acquired.
+       */
+      void
+      computeRoots();
+
+      /**
+       * @brief - Used to compute the roots of the polynom with the Aberth method. It
+       *          refines all the roots at once starting from points spread around a
+       *          circle enclosing them. The dense representation of the polynom is
+       *          expected to be available.
+       * @return - the roots of the polynom, including multiple roots.
+       */
+      std::vector<std::complex<double>>
+      computeAberthRoots() const;
+
+      /**
+       * @brief - Used to find the roots of the polynom by iterating the Newton series
+       *          from a grid of starting points covering the default rendering window.
+       *          This is used when the polynom does not have integer degrees in which
+       *          case the roots can't be computed with the Aberth method.
+       * @return - the values reached by the converging series.
+       */
+      std::vector<std::complex<double>>
+      computeSeededRoots() const;
+
+      /**
+       * @brief - Used to iterate the Newton series starting at `z` until it converges
+       *          or the accuracy is reached. The locker is not assumed to be acquired
+       *          and is *not* acquired by this method.
+       * @param z - the first term of the series, updated with the last one.
+       * @param p - output value storing the value of the polynom for the last term.
+       * @return - the number of terms computed.
+       */
+      unsigned
+      iterate(std::complex<float>& z,
+              std::complex<float>& p) const noexcept;
+
       /**
        * @brief - Used to evaluate the polynom defined by the coefficients and derivative
-       *          at the input point `x`. The locker is not assumed to be acquired and is
-       *          *not* acquired by this method.
+       *          at the input point `x`. When all the degrees are integers, the dense
+       *          representation is evaluated with a Horner scheme which yields both
+       *          values at once. Otherwise each term is computed with `std::pow`.
+       *          The locker is not assumed to be acquired and is *not* acquired by
+       *          this method.
        * @param x - the value at which the polynom and its derivative should be evaluated.
        * @param p - output value storing the value of this polynom at `x`.
        * @param pp - output value storing the value of the derivative at `x`.
@@ -165,11 +289,43 @@ namespace fractsim {
                std::complex<float>& p,
                std::complex<float>& pp) const noexcept;
 
+      /**
+       * @brief - Used to build the description of the polynom used by the kernels
+       *          from the dense representation of the coefficients.
+       * @return - the polynom to provide to the kernels.
+       */
+      kernels::NewtonPolynom
+      getKernelPolynom() const noexcept;
+
+      /**
+       * @brief - Used to gather the parameters to provide to the kernels in order
+       *          to reproduce the computations of the `compute` method.
+       * @return - the parameters of the series.
+       */
+      kernels::NewtonParams
+      getKernelParams() const noexcept;
+
+      /**
+       * @brief - Used to convert the results of the kernel into confidence values by
+       *          matching the last term of the series of each point against the roots
+       *          of the polynom. The roots are only read so no locking is needed.
+       * @param count - the number of points.
+       * @param terms - the number of terms computed for each point.
+       * @param xs - the real part of the last term of the series for each point.
+       * @param ys - the imaginary part of the last term of the series for each point.
+       * @param out - output array receiving the confidence of each point.
+       */
+      void
+      assignRoots(unsigned count,
+                  const std::vector<unsigned>& terms,
+                  const std::vector<float>& xs,
+                  const std::vector<float>& ys,
+                  float* out) const noexcept;
+
       /**
        * @brief - Used to compute a valid position that can be used in the gradient defined
        *          for this object given the series converged to the `root`-th root within a
        *          number of iterations represented by `terms`.
-       *          This method assumes that the locker is already locked.
        * @param root - the index of the root the series converged to.
        * @param terms - the number of temrs it took to consider that the series converged.
        * @return - a value that can be used in the internal gradient to retrieve the color
@@ -197,11 +353,24 @@ namespace fractsim {
 
       /**
        * @brief - An evaluation of the derivative of the polynom. It is evaluated when
-       *          the coefficients are changed and can be used for more efficient time
-       *          to compute the orbit of a point.
+       *          the coefficients are changed and is only used when the polynom does
+       *          not have a dense representation.
        */
       std::vector<InternalCoefficient> m_derivative;
 
+      /**
+       * @brief - Dense representation of the real part of the coefficients of the
+       *          polynom, indexed by degree. Empty if the polynom has some degrees
+       *          which are not positive integers.
+       */
+      std::vector<float> m_denseReal;
+
+      /**
+       * @brief - Dense representation of the imaginary part of the coefficients of
+       *          the polynom, indexed by degree.
+       */
+      std::vector<float> m_denseImag;
+
       /**
        * @brief - A value holding the maximum degree of any coefficients for the underlying
        *          polynom.
@@ -209,11 +378,12 @@ namespace fractsim {
       float m_maxDegree;
 
       /**
-       * @brief - A vector holding the roots for the polynom associated to this fractal.
-       *          The roots are cleared when needed and accumulated with each call to
-       *          the `compute` method.
+       * @brief - The roots of the polynom associated to this fractal, arranged so that
+       *          the root matching a point can be found without scanning all of them.
+       *          The roots are computed whenever the coefficients change and are then
+       *          only read when rendering.
        */
-      mutable std::vector<std::complex<float>> m_roots;
+      RootsGrid m_roots;
   };
 
   using NewtonRenderingOptionsShPtr = std::shared_ptr<NewtonRenderingOptions>;
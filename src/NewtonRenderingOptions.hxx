@@ -35,6 +35,24 @@ namespace fractsim {
     return 5u;
   }
 
+  inline
+  unsigned
+  NewtonRenderingOptions::getRootsMaxIterations() noexcept {
+    return 500u;
+  }
+
+  inline
+  double
+  NewtonRenderingOptions::getRootsPrecision() noexcept {
+    return 1e-14;
+  }
+
+  inline
+  unsigned
+  NewtonRenderingOptions::getRootsSeedsCount() noexcept {
+    return 32u;
+  }
+
   inline
   float
   NewtonRenderingOptions::getRootGradientInterval() noexcept {
@@ -52,8 +70,15 @@ namespace fractsim {
   NewtonRenderingOptions::setCoefficients(const std::vector<Coefficient>& coeffs) noexcept {
     const std::lock_guard guard(m_propsLocker);
 
-    // Update coefficients and derivative.
+    // Update coefficients and derivative. The null coefficients are not
+    // registered as they would needlessly increase the degree of the polynom.
+    m_coefficients.clear();
+
     for (unsigned id = 0u ; id < coeffs.size() ; ++id) {
+      if (coeffs[id].coeff.x() == 0.0f && coeffs[id].coeff.y() == 0.0f) {
+        continue;
+      }
+
       m_coefficients.push_back(
         InternalCoefficient{
           coeffs[id].degree,
@@ -63,6 +88,8 @@ namespace fractsim {
     }
 
     computeDerivative();
+    computeDenseCoefficients();
+    computeRoots();
   }
 
 }
@@ -0,0 +1,114 @@
+
+# include "PerturbationKernel.hh"
+# include "SimdPacket.hh"
+
+namespace fractsim {
+  namespace kernels::inline FRACTSIM_KERNELS_VARIANT {
+
+    void
+    perturbation(const DeltaList& deltas,
+                 const ReferenceData& reference,
+                 const SeriesData& series,
+                 const PerturbationParams& params,
+                 unsigned* terms,
+                 float* lens,
+                 int* glitches,
+                 RenderingStatistics& stats) noexcept
+    {
+      const simd::Counters none = simd::Counters{};
+
+      for (unsigned id = 0u ; id < deltas.count ; id += simd::Width) {
+        unsigned count = deltas.count - id;
+
+        simd::Doubles cr = simd::load<simd::Doubles>(deltas.dxs + id, count);
+        simd::Doubles ci = simd::load<simd::Doubles>(deltas.dys + id, count);
+        simd::Mask valid = simd::firstLanes(count);
+
+        // The first offsets are given by the series: `dc^2` and `dc^3` are only
+        // needed to evaluate it.
+        simd::Doubles sr = cr * cr - ci * ci;
+        simd::Doubles si = 2.0 * cr * ci;
+        simd::Doubles tr = sr * cr - si * ci;
+        simd::Doubles ti = sr * ci + si * cr;
+
+        simd::Doubles dr = series.ar * cr - series.ai * ci + series.br * sr - series.bi * si + series.cr * tr - series.ci * ti;
+        simd::Doubles di = series.ar * ci + series.ai * cr + series.br * si + series.bi * sr + series.cr * ti + series.ci * tr;
+
+        simd::Counters t = none + series.skip, conv = none;
+        simd::Mask glitched = simd::Mask{};
+
+        // Same condition as the one used by the escape-time kernels. Note that
+        // the comparisons are performed on single precision values: this avoids
+        // relying on comparisons of packets of doubles, which are not natively
+        // supported when such packets span several registers.
+        simd::Floats fLen = simd::Floats{};
+        simd::Mask active = valid & (
+          ((fLen < params.threshold) & (t < params.accuracy)) |
+          ((t - conv) < params.overshoot)
+        );
+
+        // All the active lanes compute their terms in lockstep so they all
+        // use the same term of the reference orbit.
+        unsigned n = series.skip;
+
+        while (simd::any(active)) {
+          // The pixels still iterating when the reference orbit is exhausted
+          // cannot be computed with this reference.
+          if (n + 1u >= reference.length) {
+            glitched |= active;
+            break;
+          }
+
+          // The terms of the reference are explicitly broadcast so that the
+          // compiler does not build them lane by lane.
+          const simd::Doubles zr = simd::broadcast<simd::Doubles>(reference.real[n]);
+          const simd::Doubles zi = simd::broadcast<simd::Doubles>(reference.imag[n]);
+
+          simd::Doubles nr = 2.0 * (zr * dr - zi * di) + dr * dr - di * di + cr;
+          simd::Doubles ni = 2.0 * (zr * di + zi * dr) + 2.0 * dr * di + ci;
+
+          // The offsets of the inactive lanes are updated as well, as selecting
+          // lanes of packets of doubles is not native either: only the modulus
+          // of their last term needs to be kept.
+          dr = nr;
+          di = ni;
+
+          ++n;
+          double rr = reference.real[n];
+          double ri = reference.imag[n];
+
+          simd::Doubles pr = simd::broadcast<simd::Doubles>(rr) + dr;
+          simd::Doubles pi = simd::broadcast<simd::Doubles>(ri) + di;
+          simd::Doubles pLen = pr * pr + pi * pi;
+          fLen = active ? __builtin_convertvector(pLen, simd::Floats) : fLen;
+
+          simd::Mask diverged = active & (fLen >= params.threshold) & (conv == 0u);
+          conv = diverged ? t : conv;
+
+          t -= reinterpret_cast<simd::Counters>(active);
+
+          // Pauldelbrot's criterion: the deltas lost their precision when the
+          // term of the pixel is much smaller than the one of the reference.
+          // The ratio is computed in double precision so that it does not get
+          // flushed to zero when converted, even for tiny terms.
+          simd::Floats ratio = __builtin_convertvector(pLen * (1.0 / (rr * rr + ri * ri)), simd::Floats);
+          glitched |= active & (ratio < params.glitch);
+
+          active = valid & ~glitched & (
+            ((fLen < params.threshold) & (t < params.accuracy)) |
+            ((t - conv) < params.overshoot)
+          );
+        }
+
+        const simd::Counters skipped = none + series.skip;
+        stats.iterations += simd::sum(valid ? t - skipped : none);
+        stats.saved += simd::sum(valid ? skipped : none);
+
+        simd::store(t, terms + id, count);
+        simd::store(fLen, lens + id, count);
+        simd::store(glitched, glitches + id, count);
+      }
+    }
+
+  }
+}
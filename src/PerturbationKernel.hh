@@ -0,0 +1,125 @@
+#ifndef    PERTURBATION_KERNEL_HH
+# define   PERTURBATION_KERNEL_HH
+
+# include "KernelDispatch.hh"
+# include "RenderingStatistics.hh"
+
+namespace fractsim {
+  namespace kernels {
+
+    /**
+     * @brief - Describes the orbit of the reference point used by the perturbation
+     *          kernel. The term `n` of the series of the reference is located at
+     *          `(real[n], imag[n])`, the first term being `0`. The orbit contains
+     *          `length` terms.
+     */
+    struct ReferenceData {
+      const double* real;
+      const double* imag;
+
+      unsigned length;
+    };
+
+    /**
+     * @brief - Describes a series approximating the offsets of the pixels to the
+     *          reference orbit. After `skip` terms the offset of a pixel whose
+     *          position relatively to the reference is `dc` is approximated by:
+     *            `d(skip) = a * dc + b * dc^2 + c * dc^3`
+     *          where `a`, `b` and `c` are complex coefficients. This allows to
+     *          skip the first terms of the series for all the pixels at once.
+     *          A series with no skipped terms and null coefficients describes
+     *          the regular iteration.
+     */
+    struct SeriesData {
+      unsigned skip;
+
+      double ar;
+      double ai;
+
+      double br;
+      double bi;
+
+      double cr;
+      double ci;
+    };
+
+    /**
+     * @brief - Describes a list of pixels to process with the perturbation kernel.
+     *          Rather than its coordinates each pixel is described by its offset
+     *          from the reference point: the pixel at index `id` is located at
+     *          `reference + (dxs[id], dys[id])` in the real world coordinate frame.
+     */
+    struct DeltaList {
+      const double* dxs;
+      const double* dys;
+
+      unsigned count;
+    };
+
+    /**
+     * @brief - Convenience structure regrouping the values controlling the iterations
+     *          of the perturbation kernel. The first values have the same semantic as
+     *          in the `EscapeTimeParams`.
+     *          The `glitch` describes the squared ratio between the modulus of the
+     *          term of a pixel and the one of the reference below which the deltas
+     *          are considered to have lost too much precision.
+     */
+    struct PerturbationParams {
+      unsigned accuracy;
+      unsigned overshoot;
+      float threshold;
+      float glitch;
+    };
+
+  }
+
+  namespace kernels::inline FRACTSIM_KERNELS_VARIANT {
+
+    /**
+     * @brief - Iterates the quadratic Mandelbrot series for each pixel of the list
+     *          relatively to the orbit of a reference point. Rather than computing
+     *          the terms `z(n)` of the series of a pixel we compute their offset to
+     *          the terms `Z(n)` of the reference orbit, which follows:
+     *            `d(n+1) = 2 * Z(n) * d(n) + d(n)^2 + dc`
+     *          As the offsets are small they can be represented accurately by low
+     *          precision values, even when the coordinates of the pixels themselves
+     *          cannot. Only the reference orbit needs to be computed with arbitrary
+     *          precision.
+     *          The termination condition is identical to the one of the `mandelbrot`
+     *          kernel and is evaluated on `Z(n) + d(n)`.
+     *          The offsets are not accurate anymore when the term of a pixel becomes
+     *          much smaller than the term of the reference (see Pauldelbrot's glitch
+     *          detection criterion) or when the reference orbit is exhausted before
+     *          the series of the pixel ends. Such pixels are flagged as glitched:
+     *          they should be computed again with another reference.
+     *          The iterations start after the terms skipped by the input series,
+     *          with the offsets it approximates. The skipped terms are counted as
+     *          saved in the statistics.
+     * @param deltas - the pixels to process.
+     * @param reference - the orbit of the reference point.
+     * @param series - the series approximating the first terms of the offsets.
+     * @param params - the parameters of the series.
+     * @param terms - output array receiving the number of terms computed for each
+     *                pixel. Should be able to hold all the pixels of the list.
+     * @param lens - output array receiving the squared modulus of the last term of
+     *               the series for each pixel. Should be able to hold all the pixels
+     *               of the list.
+     * @param glitches - output array receiving a non-null value for each pixel that
+     *                   is glitched. Should be able to hold all the pixels of the
+     *                   list.
+     * @param stats - output statistics updated with the work performed.
+     */
+    void
+    perturbation(const DeltaList& deltas,
+                 const ReferenceData& reference,
+                 const SeriesData& series,
+                 const PerturbationParams& params,
+                 unsigned* terms,
+                 float* lens,
+                 int* glitches,
+                 RenderingStatistics& stats) noexcept;
+
+  }
+}
+
+#endif    /* PERTURBATION_KERNEL_HH */
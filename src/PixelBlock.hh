@@ -0,0 +1,75 @@
+#ifndef    PIXEL_BLOCK_HH
+# define   PIXEL_BLOCK_HH
+
+namespace fractsim {
+  namespace kernels {
+
+    /**
+     * @brief - Describes how the pixels of a block are grouped into packets by the
+     *          vectorized kernels, and in which order the packets are processed.
+     *          The `Rows` traversal packs horizontally adjacent pixels and walks
+     *          the block row by row. The other traversals pack compact 2D blocks
+     *          of pixels (for example `4x2` pixels for `8` lanes), which are more
+     *          likely to require a similar number of terms than a long horizontal
+     *          run of pixels. These blocks are visited in row major order with
+     *          `Blocks`, and along a Z-order or a Hilbert curve with respectively
+     *          `Morton` and `Hilbert`: consecutive packets are then close to each
+     *          other in both directions.
+     *          The traversal does not change the layout of the output arrays nor
+     *          the computed values, only how the work is split.
+     */
+    enum class Traversal {
+      Rows,
+      Blocks,
+      Morton,
+      Hilbert
+    };
+
+    /**
+     * @brief - Describes a rectangular block of pixels to process in a kernel. The
+     *          pixels are laid out in row major order in the output arrays, and the
+     *          pixel at `(x, y)` is located at `(xMin + x * stepX, yMin + y * stepY)`
+     *          in the real world coordinate frame.
+     *          The coordinates are expressed with the scalar type used to compute
+     *          the pixels: this defines the precision of the computations.
+     *          The `order` describes how the vectorized kernels split the block in
+     *          packets of pixels.
+     */
+    template <typename Scalar>
+    struct PixelBlock {
+      Scalar xMin;
+      Scalar yMin;
+
+      Scalar stepX;
+      Scalar stepY;
+
+      unsigned w;
+      unsigned h;
+
+      Traversal order;
+    };
+
+    /**
+     * @brief - Describes an arbitrary list of pixels to process in a kernel. The
+     *          pixel at index `id` is located at `(xs[id], ys[id])` in the real
+     *          world coordinate frame and its results are saved at the same index
+     *          in the output arrays.
+     *          The `stepX` and `stepY` describe the size of the pixels from which
+     *          the points were picked: the coordinates do not need them but some
+     *          tolerances of the computations depend on it.
+     */
+    template <typename Scalar>
+    struct PointList {
+      const Scalar* xs;
+      const Scalar* ys;
+
+      unsigned count;
+
+      Scalar stepX;
+      Scalar stepY;
+    };
+
+  }
+}
+
+#endif    /* PIXEL_BLOCK_HH */
@@ -0,0 +1,125 @@
+
+# include "ReferenceOrbit.hh"
+
+namespace fractsim {
+
+  ReferenceOrbit::ReferenceOrbit(const GMPVector2& center,
+                                 unsigned precision,
+                                 const kernels::PerturbationParams& params):
+    m_x(),
+    m_y(),
+
+    m_precision(precision),
+    m_params(params),
+
+    m_real(),
+    m_imag()
+  {
+    mpf_init2(m_x, m_precision);
+    mpf_init2(m_y, m_precision);
+
+    mpf_set(m_x, center.x());
+    mpf_set(m_y, center.y());
+
+    compute();
+  }
+
+  ReferenceOrbit::ReferenceOrbit(const ReferenceOrbit& parent,
+                                 double dx,
+                                 double dy):
+    m_x(),
+    m_y(),
+
+    m_precision(parent.getPrecision()),
+    m_params(parent.getParams()),
+
+    m_real(),
+    m_imag()
+  {
+    mpf_init2(m_x, m_precision);
+    mpf_init2(m_y, m_precision);
+
+    mpf_set_d(m_x, dx);
+    mpf_set_d(m_y, dy);
+
+    mpf_add(m_x, m_x, parent.m_x);
+    mpf_add(m_y, m_y, parent.m_y);
+
+    compute();
+  }
+
+  void
+  ReferenceOrbit::getOffset(const scalar::Arbitrary& x,
+                            const scalar::Arbitrary& y,
+                            double& dx,
+                            double& dy) const noexcept
+  {
+    mpf_t tmp;
+    mpf_init2(tmp, m_precision);
+
+    mpf_sub(tmp, x.get(), m_x);
+    dx = mpf_get_d(tmp);
+
+    mpf_sub(tmp, y.get(), m_y);
+    dy = mpf_get_d(tmp);
+
+    mpf_clear(tmp);
+  }
+
+  void
+  ReferenceOrbit::compute() {
+    mpf_t zr, zi, zr2, zi2, tmp;
+
+    mpf_init2(zr, m_precision);
+    mpf_init2(zi, m_precision);
+    mpf_init2(zr2, m_precision);
+    mpf_init2(zi2, m_precision);
+    mpf_init2(tmp, m_precision);
+
+    // The first term of the series is `0`.
+    m_real.clear();
+    m_imag.clear();
+    m_real.push_back(0.0);
+    m_imag.push_back(0.0);
+
+    // The pixels computed with this reference may need any term up to the
+    // accuracy plus the overshoot: we stop earlier only in case the series
+    // diverges, as the pixels which are still iterating at this point are
+    // glitched anyway.
+    unsigned acc = m_params.accuracy;
+    unsigned over = m_params.overshoot;
+    double len = 0.0;
+    unsigned terms = 0u, conv = 0u;
+
+    while (terms < acc + over && (len < m_params.threshold || terms - conv < over)) {
+      mpf_mul(zr2, zr, zr);
+      mpf_mul(zi2, zi, zi);
+
+      mpf_mul(tmp, zr, zi);
+      mpf_mul_2exp(tmp, tmp, 1u);
+      mpf_add(zi, tmp, m_y);
+
+      mpf_sub(zr, zr2, zi2);
+      mpf_add(zr, zr, m_x);
+
+      double re = mpf_get_d(zr);
+      double im = mpf_get_d(zi);
+
+      m_real.push_back(re);
+      m_imag.push_back(im);
+
+      len = re * re + im * im;
+      if (len >= m_params.threshold && conv == 0u) {
+        conv = terms;
+      }
+      ++terms;
+    }
+
+    mpf_clear(zr);
+    mpf_clear(zi);
+    mpf_clear(zr2);
+    mpf_clear(zi2);
+    mpf_clear(tmp);
+  }
+
+}
@@ -0,0 +1,143 @@
+#ifndef    REFERENCE_ORBIT_HH
+# define   REFERENCE_ORBIT_HH
+
+# include <gmp.h>
+# include <memory>
+# include <vector>
+# include "GMPVector2.hh"
+# include "PerturbationKernel.hh"
+# include "ScalarPrecision.hh"
+
+namespace fractsim {
+
+  class ReferenceOrbit {
+    public:
+
+      /**
+       * @brief - Create the orbit of the input point for the quadratic Mandelbrot
+       *          series. The terms of the series are computed with arbitrary
+       *          precision and then saved with double precision so that they can
+       *          be used by the perturbation kernel.
+       *          The series is iterated until it reaches the accuracy (and the
+       *          overshoot) or until it diverged and performed the overshoot
+       *          steps.
+       * @param center - the reference point.
+       * @param precision - the number of bits to use for the computations. It
+       *                    should be large enough to distinguish the pixels of
+       *                    the area rendered with this reference.
+       * @param params - the parameters of the series.
+       */
+      ReferenceOrbit(const GMPVector2& center,
+                     unsigned precision,
+                     const kernels::PerturbationParams& params);
+
+      /**
+       * @brief - Create a reference orbit for a point located at some offset from
+       *          the center of an existing reference. The precision and the
+       *          parameters of the series are the same as the existing one.
+       *          This is typically used when some pixels are glitched with the
+       *          first reference.
+       * @param parent - the existing reference.
+       * @param dx - the offset of the new reference along the `x` axis.
+       * @param dy - the offset of the new reference along the `y` axis.
+       */
+      ReferenceOrbit(const ReferenceOrbit& parent,
+                     double dx,
+                     double dy);
+
+      /**
+       * @brief - Desctruction of the object.
+       */
+      ~ReferenceOrbit();
+
+      /**
+       * @brief - The arbitrary precision values cannot be copied without being
+       *          initialized again so we prevent copies.
+       */
+      ReferenceOrbit(const ReferenceOrbit& other) = delete;
+
+      ReferenceOrbit&
+      operator=(const ReferenceOrbit& other) = delete;
+
+      unsigned
+      getPrecision() const noexcept;
+
+      const kernels::PerturbationParams&
+      getParams() const noexcept;
+
+      /**
+       * @brief - Used to retrieve a description of the orbit suited for the
+       *          perturbation kernel.
+       * @return - the orbit of the reference point.
+       */
+      kernels::ReferenceData
+      getData() const noexcept;
+
+      /**
+       * @brief - Computes the offset of the input point relatively to the reference
+       *          point. The subtraction is performed with the precision of the orbit
+       *          so that the offset is accurate even when the input point is very
+       *          close to the reference.
+       *          The coordinates are provided with arbitrary precision so that any
+       *          of the scalar types supported by the kernels can be used without
+       *          losing bits.
+       * @param x - the coordinate of the point along the `x` axis.
+       * @param y - the coordinate of the point along the `y` axis.
+       * @param dx - output value receiving the offset along the `x` axis.
+       * @param dy - output value receiving the offset along the `y` axis.
+       */
+      void
+      getOffset(const scalar::Arbitrary& x,
+                const scalar::Arbitrary& y,
+                double& dx,
+                double& dy) const noexcept;
+
+    private:
+
+      /**
+       * @brief - Used to compute the terms of the series for the reference point
+       *          and save them in the internal arrays.
+       */
+      void
+      compute();
+
+    private:
+
+      /**
+       * @brief - The coordinate of the reference point along the `x` axis.
+       */
+      mpf_t m_x;
+
+      /**
+       * @brief - The coordinate of the reference point along the `y` axis.
+       */
+      mpf_t m_y;
+
+      /**
+       * @brief - The number of bits used to compute the orbit.
+       */
+      unsigned m_precision;
+
+      /**
+       * @brief - The parameters used to compute the orbit.
+       */
+      kernels::PerturbationParams m_params;
+
+      /**
+       * @brief - The real part of the terms of the series for the reference point.
+       */
+      std::vector<double> m_real;
+
+      /**
+       * @brief - The imaginary part of the terms of the series for the reference
+       *          point.
+       */
+      std::vector<double> m_imag;
+  };
+
+  using ReferenceOrbitShPtr = std::shared_ptr<ReferenceOrbit>;
+}
+
+# include "ReferenceOrbit.hxx"
+
+#endif    /* REFERENCE_ORBIT_HH */
@@ -0,0 +1,38 @@
+#ifndef    REFERENCE_ORBIT_HXX
+# define   REFERENCE_ORBIT_HXX
+
+# include "ReferenceOrbit.hh"
+
+namespace fractsim {
+
+  inline
+  ReferenceOrbit::~ReferenceOrbit() {
+    mpf_clear(m_x);
+    mpf_clear(m_y);
+  }
+
+  inline
+  unsigned
+  ReferenceOrbit::getPrecision() const noexcept {
+    return m_precision;
+  }
+
+  inline
+  const kernels::PerturbationParams&
+  ReferenceOrbit::getParams() const noexcept {
+    return m_params;
+  }
+
+  inline
+  kernels::ReferenceData
+  ReferenceOrbit::getData() const noexcept {
+    return kernels::ReferenceData{
+      m_real.data(),
+      m_imag.data(),
+      static_cast<unsigned>(m_real.size())
+    };
+  }
+
+}
+
+#endif    /* REFERENCE_ORBIT_HXX */
@@ -5,6 +5,8 @@
 # include <core_utils/CoreObject.hh>
 # include <maths_utils/Box.hh>
 # include <maths_utils/Vector2.hh>
+# include "GMPBox.hh"
+# include "GMPVector2.hh"
 
 namespace fractsim {
 
@@ -30,8 +32,15 @@ namespace fractsim {
        */
       ~RenderingOptions() = default;
 
-      utils::Boxf
-      getRenderingArea() const noexcept;
+      /**
+       * @brief - Returns the rendering area of these options. The area is kept with
+       *          arbitrary precision so that the successive zoom and scroll operations
+       *          do not accumulate rounding errors, which would make the view drift at
+       *          deep zoom levels.
+       * @return - the current rendering area.
+       */
+      GMPBox
+      getRenderingArea() const;
 
       /**
        * @brief - Assigns a new rendering area for these options. Note that if the
@@ -55,13 +64,6 @@ namespace fractsim {
       utils::Vector2f
       getZoom() const noexcept;
 
-      /**
-       * @brief - Returns the zoom as a mean value averaging the zoom along each axis.
-       * @return - the average of the zoom along both axos.
-       */
-      float
-      getMeanZoom() const noexcept;
-
       /**
        * @brief - Perform a zoom which keeps the `center` at the specified location and
        *          with the specified factor. Note that theoretically the center could be
@@ -71,15 +73,26 @@ namespace fractsim {
        *                 of the rendering area.
        * @return - the new rendering area.
        */
-      utils::Boxf
-      zoom(const utils::Vector2f& center,
+      GMPBox
+      zoom(const GMPVector2& center,
            float factor = 2.0f);
 
+      /**
+       * @brief - Moves the current rendering area by the specified offset. The offset
+       *          is expressed as a fraction of the dimensions of the rendering area:
+       *          this is why single precision is enough to describe it whatever the
+       *          zoom level.
+       * @param motion - the offset to apply to the rendering area.
+       * @return - the new rendering area.
+       */
+      GMPBox
+      translate(const utils::Vector2f& motion);
+
       /**
        * @brief - Resets the current rendering area to its initial value.
        * @return - the new rendering area.
        */
-      utils::Boxf
+      GMPBox
       reset();
 
       utils::Sizef
@@ -99,11 +112,12 @@ namespace fractsim {
        *          translate into `getRenderingArea().getRightBound()` and so on.
        *          Note that the input range for each coordinate of the `p` vector is
        *          `[-0.5; 0.5]`.
+       *          The point is computed with the precision of the rendering area.
        * @param p - the point in percentage to convert.
        * @return - the real world coordinate of the input point.
        */
-      utils::Vector2f
-      getPointAt(const utils::Vector2f& p) const noexcept;
+      GMPVector2
+      getPointAt(const utils::Vector2f& p) const;
 
     private:
 
@@ -112,13 +126,13 @@ namespace fractsim {
        *          to these options. Allows to easily clear the area and reset it to the
        *          initial values.
        */
-      utils::Boxf m_initial;
+      GMPBox m_initial;
 
       /**
        * @brief - The rendering area assigned to these options. Define the visible area
        *          that can be achieved when the zooming factor is minimal.
        */
-      utils::Boxf m_area;
+      GMPBox m_area;
 
       /**
        * @brief - The size of the canvas onto which the fractal will be drawn. This allows
@@ -6,8 +6,8 @@
 namespace fractsim {
 
   inline
-  utils::Boxf
-  RenderingOptions::getRenderingArea() const noexcept {
+  GMPBox
+  RenderingOptions::getRenderingArea() const {
     return m_area;
   }
 
@@ -26,30 +26,38 @@ namespace fractsim {
 
     // Update the current area and set the initial one if needed.
     if (considerInit) {
-      m_initial = area;
+      m_initial = GMPBox(area);
       reset();
 
       return;
     }
 
-    m_area = area;
+    m_area = GMPBox(area);
   }
 
   inline
   utils::Vector2f
   RenderingOptions::getZoom() const noexcept {
-    return utils::Vector2f(m_initial.w() / m_area.w(), m_initial.h() / m_area.h());
+    // The dimensions are expressed relatively to the scale of the area: they
+    // might not be representable in double precision at deep zoom levels.
+    long scale = m_area.getScale();
+
+    return utils::Vector2f(
+      static_cast<float>(GMPFloat::toDouble(m_initial.w(), scale) / GMPFloat::toDouble(m_area.w(), scale)),
+      static_cast<float>(GMPFloat::toDouble(m_initial.h(), scale) / GMPFloat::toDouble(m_area.h(), scale))
+    );
   }
 
   inline
-  float
-  RenderingOptions::getMeanZoom() const noexcept {
-    utils::Vector2f zoom = getZoom();
-    return (zoom.x() + zoom.y()) / 2.0f;
+  GMPBox
+  RenderingOptions::translate(const utils::Vector2f& motion) {
+    m_area.translate(motion);
+
+    return m_area;
   }
 
   inline
-  utils::Boxf
+  GMPBox
   RenderingOptions::reset() {
     m_area = m_initial;
 
@@ -77,12 +85,9 @@ namespace fractsim {
   }
 
   inline
-  utils::Vector2f
-  RenderingOptions::getPointAt(const utils::Vector2f& p) const noexcept {
-    return utils::Vector2f(
-      m_area.x() + p.x() * m_area.w(),
-      m_area.y() + p.y() * m_area.h()
-    );
+  GMPVector2
+  RenderingOptions::getPointAt(const utils::Vector2f& p) const {
+    return m_area.getPointAt(p);
   }
 
 }
@@ -0,0 +1,98 @@
+#ifndef    RENDERING_STATISTICS_HH
+# define   RENDERING_STATISTICS_HH
+
+# include <string>
+
+namespace fractsim {
+
+  /**
+   * @brief - Convenience structure gathering some information about the work
+   *          performed to compute a set of pixels. Each tile keeps track of the
+   *          statistics of its own rendering and the values are then aggregated
+   *          to describe a complete rendering operation.
+   */
+  struct RenderingStatistics {
+    /**
+     * @brief - The number of pixels computed.
+     */
+    unsigned long long pixels;
+
+    /**
+     * @brief - The number of pixels which were not computed but rather deduced
+     *          from the values of the surrounding pixels.
+     */
+    unsigned long long filled;
+
+    /**
+     * @brief - The number of terms of the series actually computed for all the
+     *          pixels. Note that only the block computations are able to report
+     *          this value: the pixels processed individually are not counted.
+     */
+    unsigned long long iterations;
+
+    /**
+     * @brief - The number of terms that did not need to be computed because the
+     *          corresponding pixels were detected to belong to the fractal early
+     *          (for example because their orbit was found to be periodic) or
+     *          because they were approximated for a whole view at once.
+     */
+    unsigned long long saved;
+
+    /**
+     * @brief - The number of additional reference orbits computed because some
+     *          pixels could not be computed accurately with the reference orbit
+     *          of the view (only relevant for the perturbation computations).
+     */
+    unsigned long long references;
+
+    /**
+     * @brief - The number of lanes offered by the vector units to the packet
+     *          kernels: each iteration of a packet accounts for all its lanes, be
+     *          they computing a term or idle (for example because their pixel is
+     *          already done or because the iteration was rolled back).
+     */
+    unsigned long long lanes;
+
+    /**
+     * @brief - Among the `lanes`, the ones which actually computed a term of the
+     *          series of their pixel. The ratio of both values describes how well
+     *          the vector units are used.
+     */
+    unsigned long long busy;
+
+    /**
+     * @brief - Describes how coherent the packets of pixels processed by the vector
+     *          units are: each pixel of a packet accounts for the largest number
+     *          of terms reached in its packet.
+     */
+    unsigned long long span;
+
+    /**
+     * @brief - Among the `span`, the terms not needed by the pixels themselves,
+     *          which is the difference between the largest number of terms of a
+     *          packet and the number of terms of each of its pixels. A null value
+     *          means that all the pixels of each packet required the same number
+     *          of terms, independently of how the lanes were scheduled.
+     */
+    unsigned long long spread;
+
+    /**
+     * @brief - Accumulates the input statistics into this object.
+     * @param rhs - the statistics to add to this object.
+     */
+    void
+    merge(const RenderingStatistics& rhs) noexcept;
+
+    /**
+     * @brief - Produces a human readable description of the statistics.
+     * @return - a string describing the statistics.
+     */
+    std::string
+    toString() const;
+  };
+
+}
+
+# include "RenderingStatistics.hxx"
+
+#endif    /* RENDERING_STATISTICS_HH */
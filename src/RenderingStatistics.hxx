@@ -0,0 +1,51 @@
+#ifndef    RENDERING_STATISTICS_HXX
+# define   RENDERING_STATISTICS_HXX
+
+# include "RenderingStatistics.hh"
+
+namespace fractsim {
+
+  inline
+  void
+  RenderingStatistics::merge(const RenderingStatistics& rhs) noexcept {
+    pixels += rhs.pixels;
+    filled += rhs.filled;
+    iterations += rhs.iterations;
+    saved += rhs.saved;
+    references += rhs.references;
+    lanes += rhs.lanes;
+    busy += rhs.busy;
+    span += rhs.span;
+    spread += rhs.spread;
+  }
+
+  inline
+  std::string
+  RenderingStatistics::toString() const {
+    // Compute the proportion of the terms which were avoided compared to
+    // the total amount of work needed without any optimization.
+    unsigned long long total = iterations + saved;
+    float perc = (total == 0u ? 0.0f : 100.0f * saved / total);
+
+    std::string out =
+      std::to_string(pixels) + " pixel(s) (" + std::to_string(filled) + " filled), " +
+      std::to_string(iterations) + " iteration(s), " +
+      std::to_string(saved) + " saved (" + std::to_string(perc) + "%), " +
+      std::to_string(references) + " reference(s)"
+    ;
+
+    // The usage of the lanes is only meaningful when some pixels were computed
+    // by the vector units.
+    if (lanes > 0u) {
+      out += ", " + std::to_string(100.0f * busy / lanes) + "% lanes usage";
+    }
+    if (span > 0u) {
+      out += ", " + std::to_string(100.0f * (span - spread) / span) + "% packets coherence";
+    }
+
+    return out;
+  }
+
+}
+
+#endif    /* RENDERING_STATISTICS_HXX */
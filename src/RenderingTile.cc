@@ -1,26 +1,61 @@
 
 # include "RenderingTile.hh"
+# include <algorithm>
 
 namespace fractsim {
 
-  RenderingTile::RenderingTile(const utils::Boxf& area,
+  RenderingTile::RenderingTile(GMPVector2ShPtr anchor,
+                               double xMin,
+                               double yMin,
+                               const utils::Sizef& dims,
                                const utils::Sizef& step,
-                               FractalOptionsShPtr options):
-    utils::AsynchronousJob(std::string("tile_") + area.toString()),
+                               long scale,
+                               FractalOptionsShPtr options,
+                               const tile::Strategy& strategy,
+                               const kernels::Traversal& traversal,
+                               const scalar::Precision& precision):
+    utils::AsynchronousJob(
+      std::string("tile_") +
+      utils::Boxf(
+        static_cast<float>(xMin + dims.w() / 2.0f),
+        static_cast<float>(yMin + dims.h() / 2.0f),
+        dims
+      ).toString()
+    ),
 
-    m_area(area),
+    m_anchor(anchor),
+    m_xMin(xMin),
+    m_yMin(yMin),
+    m_area(
+      static_cast<float>(xMin + dims.w() / 2.0f),
+      static_cast<float>(yMin + dims.h() / 2.0f),
+      dims
+    ),
     m_discretization(step),
+    m_scale(scale),
 
     m_computing(options),
+    m_strategy(strategy),
+    m_traversal(traversal),
+    m_precision(precision),
 
     m_dims(),
-    m_data()
+    m_data(),
+
+    m_stats{}
   {
     // Check consistency.
+    if (m_anchor == nullptr) {
+      error(
+        std::string("Could not create rendering tile"),
+        std::string("Invalid null anchor")
+      );
+    }
+
     if (!m_area.valid()) {
       error(
         std::string("Could not create rendering tile"),
-        std::string("Invalid rendering area ") + area.toString()
+        std::string("Invalid rendering area ") + m_area.toString()
       );
     }
 
@@ -38,43 +73,73 @@ namespace fractsim {
 
   void
   RenderingTile::compute() {
-    // Compute the value needed to fill in each cell.
-    float xMin = m_area.getLeftBound();
-    float yMin = m_area.getBottomBound();
-
-    for (int y = 0 ; y < m_dims.h() ; ++y) {
-      unsigned offset = y * m_dims.w();
-
-      for (int x = 0 ; x < m_dims.w() ; ++x) {
-        // Compute the point associated to this cell.
-        utils::Vector2f p(
-          xMin + x * m_discretization.w(),
-          yMin + y * m_discretization.h()
-        );
+    m_stats = RenderingStatistics{};
 
-        // Compute the divergence count for this point.
-        // Normalize the contribution with the maximum
-        // confidence.
-        float div = m_computing->compute(p);
-        float clamped = std::min(1.0f, std::max(0.0f, div));
+    if (m_strategy == tile::Strategy::Subdivision) {
+      computeSubdivision();
+      return;
+    }
 
-        m_data[offset + x] = clamped;
-      }
+    if (m_strategy == tile::Strategy::BoundaryTracing) {
+      computeBoundaryTracing();
+      return;
     }
+
+    // Compute the value needed to fill in each cell: the whole
+    // tile is handled at once by the computing options with the
+    // scalar type matching the precision of the tile.
+    scalar::Arbitrary x0, y0, sx, sy;
+    getOrigin(x0, y0);
+    getStep(sx, sy);
+
+    scalar::dispatch(
+      m_precision,
+      [this, &x0, &y0, &sx, &sy](auto zero) {
+        using Scalar = decltype(zero);
+
+        // The fixed point values can't describe the step between two pixels
+        // accurately (see `computePixels`): each pixel is rather positioned
+        // individually, which costs nothing compared to the iterations.
+        if constexpr (fixed::isNumber<Scalar>) {
+          std::vector<unsigned> pixels(m_data.size());
+          for (unsigned id = 0u ; id < pixels.size() ; ++id) {
+            pixels[id] = id;
+          }
+
+          computePixels<Scalar>(pixels, m_data);
+          return;
+        }
+
+        m_computing->computeBlock(
+          kernels::PixelBlock<Scalar>{
+            static_cast<Scalar>(x0),
+            static_cast<Scalar>(y0),
+            static_cast<Scalar>(sx),
+            static_cast<Scalar>(sy),
+            static_cast<unsigned>(m_dims.w()),
+            static_cast<unsigned>(m_dims.h()),
+            m_traversal
+          },
+          m_data.data(),
+          m_stats
+        );
+      }
+    );
   }
 
   float
-  RenderingTile::getConfidenceAt(const utils::Vector2f& p,
+  RenderingTile::getConfidenceAt(double x,
+                                 double y,
                                  bool& inside)
   {
     // Check trivial case where the point does not belong to the tile.
-    inside = m_area.contains(p);
+    inside = (x >= 0.0 && x <= m_area.w() && y >= 0.0 && y <= m_area.h());
     if (!inside) {
       return 0.0f;
     }
 
-    // Compute the local position of `p` within the support area of this tile.
-    utils::Vector2f local = p - m_area.getBottomLeftCorner();
+    // The input position is already local to the support area of this tile.
+    utils::Vector2f local(static_cast<float>(x), static_cast<float>(y));
 
     // Transform this coordinate into a cell value.
     utils::Vector2f fCell(
@@ -139,5 +204,329 @@ namespace fractsim {
     m_data.resize(m_dims.area(), 0u);
   }
 
-}
+  void
+  RenderingTile::getOrigin(scalar::Arbitrary& x,
+                           scalar::Arbitrary& y) const
+  {
+    // The sum is computed without loss so that the precision of the
+    // anchor is preserved.
+    x = scalar::Arbitrary(m_anchor->x()) + ldexp(scalar::Arbitrary(m_xMin), m_scale);
+    y = scalar::Arbitrary(m_anchor->y()) + ldexp(scalar::Arbitrary(m_yMin), m_scale);
+  }
 
+  void
+  RenderingTile::getStep(scalar::Arbitrary& x,
+                         scalar::Arbitrary& y) const
+  {
+    x = ldexp(scalar::Arbitrary(m_discretization.w()), m_scale);
+    y = ldexp(scalar::Arbitrary(m_discretization.h()), m_scale);
+  }
+
+  void
+  RenderingTile::computePixels(const std::vector<unsigned>& pixels) {
+    if (pixels.empty()) {
+      return;
+    }
+
+    std::vector<float> values(pixels.size(), 0.0f);
+
+    scalar::dispatch(
+      m_precision,
+      [this, &pixels, &values](auto zero) {
+        computePixels<decltype(zero)>(pixels, values);
+      }
+    );
+
+    for (unsigned id = 0u ; id < pixels.size() ; ++id) {
+      m_data[pixels[id]] = values[id];
+    }
+  }
+
+  void
+  RenderingTile::computeSubdivision() {
+    int w = m_dims.w();
+    std::vector<unsigned> pixels;
+
+    // Compute the border of the tile: the rest of the pixels will
+    // be either computed or filled by the subdivision process.
+    for (int x = 0 ; x < w ; ++x) {
+      pixels.push_back(x);
+      if (m_dims.h() > 1) {
+        pixels.push_back((m_dims.h() - 1) * w + x);
+      }
+    }
+    for (int y = 1 ; y < m_dims.h() - 1 ; ++y) {
+      pixels.push_back(y * w);
+      if (w > 1) {
+        pixels.push_back(y * w + w - 1);
+      }
+    }
+
+    computePixels(pixels);
+
+    std::vector<Area> areas(1u, Area{0, 0, w, m_dims.h()});
+    std::vector<Area> next;
+
+    while (!areas.empty()) {
+      pixels.clear();
+      next.clear();
+
+      for (unsigned id = 0u ; id < areas.size() ; ++id) {
+        const Area& a = areas[id];
+
+        // Areas with no interior are already fully computed.
+        if (a.w <= 2 || a.h <= 2) {
+          continue;
+        }
+
+        // In case the border is uniform, we can fill the interior of the area
+        // with the value of the border: this relies on the fact that the regions
+        // of the fractals formed by a class of points do not contain holes.
+        if (isBorderUniform(a)) {
+          float value = m_data[a.y * w + a.x];
+
+          for (int y = a.y + 1 ; y < a.y + a.h - 1 ; ++y) {
+            std::fill(
+              m_data.begin() + y * w + a.x + 1,
+              m_data.begin() + y * w + a.x + a.w - 1,
+              value
+            );
+          }
+
+          m_stats.filled += (a.w - 2) * (a.h - 2);
+
+          continue;
+        }
+
+        // Small areas are not worth splitting further.
+        if (a.w <= getSubdivisionMinSize() || a.h <= getSubdivisionMinSize()) {
+          for (int y = a.y + 1 ; y < a.y + a.h - 1 ; ++y) {
+            for (int x = a.x + 1 ; x < a.x + a.w - 1 ; ++x) {
+              pixels.push_back(y * w + x);
+            }
+          }
+
+          continue;
+        }
+
+        // Split the area in four quadrants: the splitting lines are shared by
+        // the siblings and serve as part of their borders. Compared to halving
+        // the area this computes the borders of twice as many areas in each
+        // batch, which keeps more lanes of the kernels busy.
+        int midX = a.x + a.w / 2;
+        int midY = a.y + a.h / 2;
+
+        for (int y = a.y + 1 ; y < a.y + a.h - 1 ; ++y) {
+          pixels.push_back(y * w + midX);
+        }
+        for (int x = a.x + 1 ; x < a.x + a.w - 1 ; ++x) {
+          if (x != midX) {
+            pixels.push_back(midY * w + x);
+          }
+        }
+
+        next.push_back(Area{a.x, a.y, midX - a.x + 1, midY - a.y + 1});
+        next.push_back(Area{midX, a.y, a.x + a.w - midX, midY - a.y + 1});
+        next.push_back(Area{a.x, midY, midX - a.x + 1, a.y + a.h - midY});
+        next.push_back(Area{midX, midY, a.x + a.w - midX, a.y + a.h - midY});
+      }
+
+      computePixels(pixels);
+
+      areas.swap(next);
+    }
+  }
+
+  void
+  RenderingTile::computeBoundaryTracing() {
+    const int w = m_dims.w();
+    const int h = m_dims.h();
+
+    // Keep track of the pixels already computed and of the ones that
+    // were already queued to be scanned.
+    std::vector<bool> computed(m_data.size(), false);
+    std::vector<bool> queued(m_data.size(), false);
+
+    std::vector<unsigned> wave, next, ring, added, pixels;
+
+    auto enqueue = [&queued, &next](unsigned p) {
+      if (!queued[p]) {
+        queued[p] = true;
+        next.push_back(p);
+      }
+    };
+
+    // The contours can only be reached from the edges of the tile.
+    for (int x = 0 ; x < w ; ++x) {
+      enqueue(x);
+      enqueue((h - 1) * w + x);
+    }
+    for (int y = 1 ; y < h - 1 ; ++y) {
+      enqueue(y * w);
+      enqueue(y * w + w - 1);
+    }
+
+    while (!next.empty()) {
+      wave.swap(next);
+      next.clear();
+
+      // Compute the pixels of the wave along with their direct neighbors
+      // as they are needed to detect the boundaries. The waves following
+      // thin contours only hold a few pixels which would leave most lanes
+      // of the kernels idle: the batch is then extended with the neighbors
+      // of the pixels it contains, which the next waves are likely to need.
+      pixels.clear();
+      ring = wave;
+
+      while (!ring.empty()) {
+        added.clear();
+
+        for (unsigned id = 0u ; id < ring.size() ; ++id) {
+          int x = ring[id] % w;
+          int y = ring[id] / w;
+
+          const int neighbors[5][2] = {{x, y}, {x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1}};
+
+          for (unsigned n = 0u ; n < 5u ; ++n) {
+            int nx = neighbors[n][0];
+            int ny = neighbors[n][1];
+
+            if (nx < 0 || nx >= w || ny < 0 || ny >= h || computed[ny * w + nx]) {
+              continue;
+            }
+
+            computed[ny * w + nx] = true;
+            pixels.push_back(ny * w + nx);
+            added.push_back(ny * w + nx);
+          }
+        }
+
+        if (pixels.size() >= getTracingMinBatch()) {
+          break;
+        }
+
+        ring.swap(added);
+      }
+
+      computePixels(pixels);
+
+      // Scan the pixels of the wave: each neighbor with a different value
+      // indicates a boundary which should be followed.
+      for (unsigned id = 0u ; id < wave.size() ; ++id) {
+        unsigned p = wave[id];
+        int x = p % w;
+        int y = p / w;
+        float center = m_data[p];
+
+        bool ll = x >= 1, rr = x < w - 1;
+        bool uu = y >= 1, dd = y < h - 1;
+
+        bool l = ll && !m_computing->isSameClass(center, m_data[p - 1]);
+        bool r = rr && !m_computing->isSameClass(center, m_data[p + 1]);
+        bool u = uu && !m_computing->isSameClass(center, m_data[p - w]);
+        bool d = dd && !m_computing->isSameClass(center, m_data[p + w]);
+
+        if (l) {
+          enqueue(p - 1);
+        }
+        if (r) {
+          enqueue(p + 1);
+        }
+        if (u) {
+          enqueue(p - w);
+        }
+        if (d) {
+          enqueue(p + w);
+        }
+
+        // Also follow the diagonals so that the contours can't leak
+        // through diagonally adjacent pixels.
+        if (uu && ll && (l || u)) {
+          enqueue(p - w - 1);
+        }
+        if (uu && rr && (r || u)) {
+          enqueue(p - w + 1);
+        }
+        if (dd && ll && (l || d)) {
+          enqueue(p + w - 1);
+        }
+        if (dd && rr && (r || d)) {
+          enqueue(p + w + 1);
+        }
+      }
+    }
+
+    // The pixels which were not computed form regions enclosed by a traced
+    // contour, whose pixels all belong to the same class: each region is
+    // flooded and filled with the value of the contour.
+    std::vector<bool> flooded(m_data.size(), false);
+    std::vector<unsigned> region;
+
+    for (unsigned start = 0u ; start < m_data.size() ; ++start) {
+      if (computed[start] || flooded[start]) {
+        continue;
+      }
+
+      region.clear();
+      region.push_back(start);
+      flooded[start] = true;
+
+      float value = 0.0f;
+
+      for (unsigned id = 0u ; id < region.size() ; ++id) {
+        int x = region[id] % w;
+        int y = region[id] / w;
+
+        const int neighbors[4][2] = {{x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1}};
+
+        for (unsigned n = 0u ; n < 4u ; ++n) {
+          int nx = neighbors[n][0];
+          int ny = neighbors[n][1];
+
+          if (nx < 0 || nx >= w || ny < 0 || ny >= h || flooded[ny * w + nx]) {
+            continue;
+          }
+
+          if (computed[ny * w + nx]) {
+            value = m_data[ny * w + nx];
+            continue;
+          }
+
+          flooded[ny * w + nx] = true;
+          region.push_back(ny * w + nx);
+        }
+      }
+
+      for (unsigned id = 0u ; id < region.size() ; ++id) {
+        m_data[region[id]] = value;
+      }
+
+      m_stats.filled += region.size();
+    }
+  }
+
+  bool
+  RenderingTile::isBorderUniform(const Area& area) const noexcept {
+    const int w = m_dims.w();
+    const float ref = m_data[area.y * w + area.x];
+
+    auto same = [this, ref](unsigned p) {
+      return m_computing->isSameClass(ref, m_data[p]);
+    };
+
+    for (int x = area.x ; x < area.x + area.w ; ++x) {
+      if (!same(area.y * w + x) || !same((area.y + area.h - 1) * w + x)) {
+        return false;
+      }
+    }
+
+    for (int y = area.y + 1 ; y < area.y + area.h - 1 ; ++y) {
+      if (!same(y * w + area.x) || !same(y * w + area.x + area.w - 1)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+}
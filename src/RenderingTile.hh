@@ -6,9 +6,48 @@
 # include <maths_utils/Vector2.hh>
 # include <core_utils/AsynchronousJob.hh>
 # include "FractalOptions.hh"
+# include "GMPVector2.hh"
+# include "RenderingStatistics.hh"
+# include "ScalarPrecision.hh"
 
 namespace fractsim {
 
+  namespace tile {
+
+    /**
+     * @brief - Describes the possible strategies to fill the pixels of a tile.
+     *          The `PerPixel` strategy computes each pixel of the tile while the
+     *          `Subdivision` strategy uses the Mariani-Silver algorithm: regions
+     *          of the tile with a uniform border are filled without computing
+     *          their interior.
+     *          The `BoundaryTracing` strategy follows the contours between the
+     *          regions of the tile having different values and only computes
+     *          the pixels along them: the enclosed regions are then filled.
+     */
+    enum class Strategy {
+      PerPixel,
+      Subdivision,
+      BoundaryTracing
+    };
+
+    /**
+     * @brief - Used to retrieve a human readable name for the input strategy.
+     * @param strategy - the strategy to convert.
+     * @return - a string describing the strategy.
+     */
+    std::string
+    toString(const Strategy& strategy) noexcept;
+
+    /**
+     * @brief - Used to retrieve a human readable name for the input traversal.
+     * @param traversal - the traversal to convert.
+     * @return - a string describing the traversal.
+     */
+    std::string
+    toString(const kernels::Traversal& traversal) noexcept;
+
+  }
+
   class RenderingTile: public utils::AsynchronousJob {
     public:
 
@@ -17,16 +56,42 @@ namespace fractsim {
        *          The tile also needs some options to be provided in order to be
        *          able to perform the computations.
        *          In case the area or the options are not valid an error is raised.
-       * @param area - the rendering area for which the computations should be done.
+       *          The bottom left corner of the tile is provided as an offset to an
+       *          anchor point which is described with arbitrary precision: this
+       *          allows to accurately position the tiles at any zoom level while
+       *          manipulating small offsets. The pixels are computed with the input
+       *          precision.
+       *          The offsets and dimensions are expressed in units of `2^scale`: this
+       *          keeps them in the range of a float whatever the zoom level.
+       * @param anchor - the point relatively to which the tile is positioned.
+       * @param xMin - the left bound of the rendering area of the tile relatively
+       *               to the anchor.
+       * @param yMin - the bottom bound of the rendering area of the tile relatively
+       *               to the anchor.
+       * @param dims - the dimensions of the rendering area of the tile.
        * @param step - represents the real world area covered by a single pixel. Can
        *               be used as an indication of how many pixels are needed for
        *               this tile.
+       * @param scale - the binary exponent of the unit of the offsets, dimensions
+       *                and step of the tile.
        * @param options - the options to use to compute the fractal (accuracy, actual
        *                  formula, etc.).
+       * @param strategy - the strategy to use to fill the pixels of the tile.
+       * @param traversal - the order in which the pixels of the tile are packed
+       *                    by the vectorized kernels. Only relevant when all the
+       *                    pixels of the tile are computed.
+       * @param precision - the precision to use to compute the pixels of the tile.
        */
-      RenderingTile(const utils::Boxf& area,
+      RenderingTile(GMPVector2ShPtr anchor,
+                    double xMin,
+                    double yMin,
+                    const utils::Sizef& dims,
                     const utils::Sizef& step,
-                    FractalOptionsShPtr options);
+                    long scale,
+                    FractalOptionsShPtr options,
+                    const tile::Strategy& strategy,
+                    const kernels::Traversal& traversal,
+                    const scalar::Precision& precision);
 
       ~RenderingTile() = default;
 
@@ -38,27 +103,80 @@ namespace fractsim {
       compute() override;
 
       /**
-       * @brief - Returns the area associated to this tile in the fractal's coordinate frame.
+       * @brief - Returns the area associated to this tile relatively to its anchor.
        * @¶eturn - a box representing the area associated to this tile.
        */
       utils::Boxf
       getArea() const noexcept;
 
       /**
-       * @brief - Used to retrieve the confidence computed for the input point `p`. If the
+       * @brief - Used to retrieve the point relatively to which this tile is positioned.
+       * @return - the anchor of this tile.
+       */
+      GMPVector2ShPtr
+      getAnchor() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the left bound of the area of this tile relatively to
+       *          its anchor.
+       * @return - the left bound of the tile.
+       */
+      double
+      getXMin() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the bottom bound of the area of this tile relatively to
+       *          its anchor.
+       * @return - the bottom bound of the tile.
+       */
+      double
+      getYMin() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the binary exponent of the unit in which the area of
+       *          this tile is expressed.
+       * @return - the scale of this tile.
+       */
+      long
+      getScale() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the precision used to compute the pixels of this tile.
+       * @return - the precision of the computations of this tile.
+       */
+      scalar::Precision
+      getPrecision() const noexcept;
+
+      /**
+       * @brief - Used to retrieve the confidence computed for the input point. If the
        *          point does not belong to the area of this tile the `inside` boolean is
        *          set to `false` and a default color is returned (but should not be used or
        *          relied upon).
-       * @param p - the point for which the confidence should be returned.
+       *          The point is expressed relatively to the bottom left corner of the tile
+       *          so that the lookup does not depend on the magnitude of the coordinates.
+       * @param x - the coordinate of the point along the `x` axis relatively to the left
+       *            bound of the tile.
+       * @param y - the coordinate of the point along the `y` axis relatively to the bottom
+       *            bound of the tile.
        * @param inside - output value indicating whether the point is inside or outside of
        *                 the area defined for this tile.
        * @return - a value in the range `[0; 1]` indicating the level of confidence for the
        *           input position.
        */
       float
-      getConfidenceAt(const utils::Vector2f& p,
+      getConfidenceAt(double x,
+                      double y,
                       bool& inside);
 
+      /**
+       * @brief - Used to retrieve the statistics describing the work performed to
+       *          compute this tile. The values are only relevant once the tile has
+       *          been computed.
+       * @return - the statistics of the computations of this tile.
+       */
+      const RenderingStatistics&
+      getStatistics() const noexcept;
+
     private:
 
       /**
@@ -69,10 +187,137 @@ namespace fractsim {
       void
       initialize();
 
+      /**
+       * @brief - Used to compute the bottom left corner of the tile with arbitrary
+       *          precision. The coordinates can then be converted to the scalar type
+       *          matching the precision of the tile.
+       * @param x - output value receiving the left bound of the tile.
+       * @param y - output value receiving the bottom bound of the tile.
+       */
+      void
+      getOrigin(scalar::Arbitrary& x,
+                scalar::Arbitrary& y) const;
+
+      /**
+       * @brief - Used to compute the real world size of a pixel of the tile with
+       *          arbitrary precision, as the discretization step is expressed in
+       *          units of `2^scale`.
+       * @param x - output value receiving the width of a pixel.
+       * @param y - output value receiving the height of a pixel.
+       */
+      void
+      getStep(scalar::Arbitrary& x,
+              scalar::Arbitrary& y) const;
+
+      /**
+       * @brief - Describes a rectangular area of the tile, expressed in pixels.
+       */
+      struct Area {
+        int x;
+        int y;
+        int w;
+        int h;
+      };
+
+      /**
+       * @brief - Used to compute the pixels of the tile with the input indices and
+       *          save them in the internal data array. All the pixels are handled
+       *          at once by the computing options.
+       * @param pixels - the indices of the pixels to compute in the internal data
+       *                 array.
+       */
+      void
+      computePixels(const std::vector<unsigned>& pixels);
+
+      /**
+       * @brief - Used to compute the pixels of the tile with the input indices using
+       *          the scalar type `Scalar`.
+       * @param pixels - the indices of the pixels to compute.
+       * @param values - output array receiving the confidence of each pixel.
+       */
+      template <typename Scalar>
+      void
+      computePixels(const std::vector<unsigned>& pixels,
+                    std::vector<float>& values);
+
+      /**
+       * @brief - Fills the internal data array using the Mariani-Silver algorithm.
+       *          The border of the tile is computed first. Then each area whose border
+       *          is known is processed: if all the pixels of the border belong to the
+       *          same class (see `FractalOptions::isSameClass`) the interior is filled
+       *          with the value of a corner, otherwise the area is split in four and
+       *          the splitting lines are computed. Small areas are computed directly.
+       *          The areas are processed level by level so that all the pixels needed
+       *          by a level are computed in a single batch.
+       */
+      void
+      computeSubdivision();
+
+      /**
+       * @brief - Fills the internal data array by tracing the boundaries between the
+       *          regions of the tile with different values. The pixels on the edges
+       *          of the tile are scanned first: whenever a scanned pixel differs from
+       *          one of its neighbors, the neighbors are scanned as well. This allows
+       *          to follow the contours of the regions, however thin they are.
+       *          The scanning is performed in waves so that all the pixels needed by
+       *          a wave are computed in a single batch, extended with their neighbors
+       *          when it is too small to keep the kernels busy. Once no more pixels
+       *          need to be scanned, the pixels which were not computed form regions
+       *          enclosed by a contour: each region is flooded and filled with the
+       *          value of the pixels surrounding it.
+       */
+      void
+      computeBoundaryTracing();
+
+      /**
+       * @brief - Used to determine whether all the pixels on the border of the input
+       *          area belong to the same class as its bottom left corner.
+       * @param area - the area to check.
+       * @return - `true` if the border of the area is uniform.
+       */
+      bool
+      isBorderUniform(const Area& area) const noexcept;
+
+      /**
+       * @brief - Used to retrieve the size (in pixels) below which an area is not
+       *          subdivided anymore but rather computed directly.
+       * @return - the minimum size of an area to subdivide.
+       */
+      static
+      int
+      getSubdivisionMinSize() noexcept;
+
+      /**
+       * @brief - Used to retrieve the number of pixels below which the batches of
+       *          the boundary tracing are extended with the pixels likely to be
+       *          needed by the next waves.
+       * @return - the minimum size of a batch of the boundary tracing.
+       */
+      static
+      unsigned
+      getTracingMinBatch() noexcept;
+
     private:
 
       /**
-       * @brief - The rendering area for which the computations should be performed.
+       * @brief - The point relatively to which the tile is positioned. It is shared
+       *          by all the tiles generated for the same view.
+       */
+      GMPVector2ShPtr m_anchor;
+
+      /**
+       * @brief - The left bound of the rendering area, relatively to the anchor.
+       */
+      double m_xMin;
+
+      /**
+       * @brief - The bottom bound of the rendering area, relatively to the anchor.
+       */
+      double m_yMin;
+
+      /**
+       * @brief - The rendering area for which the computations should be performed,
+       *          relatively to the anchor.
        */
       utils::Boxf m_area;
 
@@ -82,6 +327,12 @@ namespace fractsim {
        */
       utils::Sizef m_discretization;
 
+      /**
+       * @brief - The binary exponent of the unit in which the offsets, the area and
+       *          the discretization step of the tile are expressed.
+       */
+      long m_scale;
+
       /**
        * @brief - Describes the object to use to perform the computation for each
        *          individual pixel of the rendering area. Allows to abstract away
@@ -90,6 +341,22 @@ namespace fractsim {
        */
       FractalOptionsShPtr m_computing;
 
+      /**
+       * @brief - The strategy to use to fill the pixels of the tile.
+       */
+      tile::Strategy m_strategy;
+
+      /**
+       * @brief - The order in which the pixels of the tile are packed by the kernels
+       *          when computing all of them.
+       */
+      kernels::Traversal m_traversal;
+
+      /**
+       * @brief - The precision to use to compute the pixels of the tile.
+       */
+      scalar::Precision m_precision;
+
       /**
        * @brief - The dimensions of the internal data array. Computed from the area
        *          and the discretization step, it is conservative in the sense that
@@ -104,6 +371,11 @@ namespace fractsim {
        *          needed to diverge for each one of them.
        */
       std::vector<float> m_data;
+
+      /**
+       * @brief - The statistics gathered during the last computation of this tile.
+       */
+      RenderingStatistics m_stats;
   };
 
   using RenderingTileShPtr = std::shared_ptr<RenderingTile>;
@@ -4,6 +4,39 @@
 # include "RenderingTile.hh"
 
 namespace fractsim {
+  namespace tile {
+
+    inline
+    std::string
+    toString(const Strategy& strategy) noexcept {
+      switch (strategy) {
+        case Strategy::Subdivision:
+          return "subdivision";
+        case Strategy::BoundaryTracing:
+          return "boundary_tracing";
+        case Strategy::PerPixel:
+        default:
+          return "per_pixel";
+      }
+    }
+
+    inline
+    std::string
+    toString(const kernels::Traversal& traversal) noexcept {
+      switch (traversal) {
+        case kernels::Traversal::Blocks:
+          return "blocks";
+        case kernels::Traversal::Morton:
+          return "morton";
+        case kernels::Traversal::Hilbert:
+          return "hilbert";
+        case kernels::Traversal::Rows:
+        default:
+          return "rows";
+      }
+    }
+
+  }
 
   inline
   utils::Boxf
@@ -11,6 +44,112 @@ namespace fractsim {
     return m_area;
   }
 
+  inline
+  GMPVector2ShPtr
+  RenderingTile::getAnchor() const noexcept {
+    return m_anchor;
+  }
+
+  inline
+  double
+  RenderingTile::getXMin() const noexcept {
+    return m_xMin;
+  }
+
+  inline
+  double
+  RenderingTile::getYMin() const noexcept {
+    return m_yMin;
+  }
+
+  inline
+  long
+  RenderingTile::getScale() const noexcept {
+    return m_scale;
+  }
+
+  inline
+  scalar::Precision
+  RenderingTile::getPrecision() const noexcept {
+    return m_precision;
+  }
+
+  inline
+  const RenderingStatistics&
+  RenderingTile::getStatistics() const noexcept {
+    return m_stats;
+  }
+
+  template <typename Scalar>
+  inline
+  void
+  RenderingTile::computePixels(const std::vector<unsigned>& pixels,
+                               std::vector<float>& values)
+  {
+    // Generate the coordinates of the pixels in the same way as it is done
+    // when computing the whole tile at once.
+    scalar::Arbitrary x0, y0;
+    getOrigin(x0, y0);
+
+    const Scalar xMin = static_cast<Scalar>(x0);
+    const Scalar yMin = static_cast<Scalar>(y0);
+    scalar::Arbitrary sx, sy;
+    getStep(sx, sy);
+
+    const Scalar stepX = static_cast<Scalar>(sx);
+    const Scalar stepY = static_cast<Scalar>(sy);
+
+    // The resolution of the fixed point values is absolute: at deep zooms
+    // the step between two pixels only keeps a few significant bits and
+    // the error would be multiplied by the index of the pixel. The offsets
+    // are then computed with arbitrary precision, once per column and row.
+    std::vector<Scalar> columns(m_dims.w(), xMin);
+    std::vector<Scalar> rows(m_dims.h(), yMin);
+
+    for (int x = 0 ; x < m_dims.w() ; ++x) {
+      if constexpr (fixed::isNumber<Scalar>) {
+        columns[x] = static_cast<Scalar>(x0 + sx * static_cast<double>(x));
+      }
+      else {
+        columns[x] = xMin + static_cast<unsigned>(x) * stepX;
+      }
+    }
+    for (int y = 0 ; y < m_dims.h() ; ++y) {
+      if constexpr (fixed::isNumber<Scalar>) {
+        rows[y] = static_cast<Scalar>(y0 + sy * static_cast<double>(y));
+      }
+      else {
+        rows[y] = yMin + static_cast<unsigned>(y) * stepY;
+      }
+    }
+
+    std::vector<Scalar> xs(pixels.size(), xMin);
+    std::vector<Scalar> ys(pixels.size(), yMin);
+
+    for (unsigned id = 0u ; id < pixels.size() ; ++id) {
+      xs[id] = columns[pixels[id] % m_dims.w()];
+      ys[id] = rows[pixels[id] / m_dims.w()];
+    }
+
+    m_computing->computePoints(
+      kernels::PointList<Scalar>{xs.data(), ys.data(), static_cast<unsigned>(pixels.size()), stepX, stepY},
+      values.data(),
+      m_stats
+    );
+  }
+
+  inline
+  int
+  RenderingTile::getSubdivisionMinSize() noexcept {
+    return 8;
+  }
+
+  inline
+  unsigned
+  RenderingTile::getTracingMinBatch() noexcept {
+    return 128u;
+  }
+
 }
 
 #endif    /* RENDERING_TILE_HXX */
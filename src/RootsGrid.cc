@@ -0,0 +1,83 @@
+
+# include "RootsGrid.hh"
+
+namespace fractsim {
+
+  RootsGrid::RootsGrid(const std::vector<float>& xs,
+                       const std::vector<float>& ys,
+                       float threshold):
+    m_xs(xs),
+    m_ys(ys),
+    m_threshold(threshold),
+
+    m_xMin(0.0f),
+    m_yMin(0.0f),
+    m_xMax(0.0f),
+    m_yMax(0.0f),
+    m_scale(0.0f),
+
+    m_w(0u),
+    m_h(0u),
+
+    m_offsets(),
+    m_roots()
+  {
+    if (m_xs.empty()) {
+      return;
+    }
+
+    // The grid covers the area where a point can match a root.
+    auto [xMin, xMax] = std::minmax_element(m_xs.cbegin(), m_xs.cend());
+    auto [yMin, yMax] = std::minmax_element(m_ys.cbegin(), m_ys.cend());
+
+    m_xMin = *xMin - m_threshold;
+    m_xMax = *xMax + m_threshold;
+    m_yMin = *yMin - m_threshold;
+    m_yMax = *yMax + m_threshold;
+
+    // The roots usually lie on a curve rather than fill the area so we use
+    // a number of cells proportional to the square root of their count. The
+    // cells are never smaller than the area matching a root so that a root
+    // is registered in at most four cells.
+    unsigned count = getCellsPerRoot() * static_cast<unsigned>(std::ceil(std::sqrt(1.0f * m_xs.size())));
+    float size = std::max(std::max(m_xMax - m_xMin, m_yMax - m_yMin) / count, 2.0f * m_threshold);
+
+    m_scale = 1.0f / size;
+    m_w = std::max(1u, static_cast<unsigned>(std::ceil((m_xMax - m_xMin) * m_scale)));
+    m_h = std::max(1u, static_cast<unsigned>(std::ceil((m_yMax - m_yMin) * m_scale)));
+
+    // Register each root in all the cells overlapping the area it matches:
+    // the first pass counts the roots of each cell, the second one assigns
+    // them. Processing the roots in order keeps them sorted in each cell.
+    m_offsets.resize(m_w * m_h + 1u, 0u);
+
+    auto forEachCell = [this](unsigned root, auto process) {
+      unsigned xs = getCell(m_xs[root] - m_threshold, m_xMin, m_w);
+      unsigned xe = getCell(m_xs[root] + m_threshold, m_xMin, m_w);
+      unsigned ys = getCell(m_ys[root] - m_threshold, m_yMin, m_h);
+      unsigned ye = getCell(m_ys[root] + m_threshold, m_yMin, m_h);
+
+      for (unsigned y = ys ; y <= ye ; ++y) {
+        for (unsigned x = xs ; x <= xe ; ++x) {
+          process(y * m_w + x);
+        }
+      }
+    };
+
+    for (unsigned root = 0u ; root < m_xs.size() ; ++root) {
+      forEachCell(root, [this](unsigned cell) { ++m_offsets[cell + 1u]; });
+    }
+
+    for (unsigned cell = 0u ; cell < m_w * m_h ; ++cell) {
+      m_offsets[cell + 1u] += m_offsets[cell];
+    }
+
+    m_roots.resize(m_offsets.back(), 0u);
+    std::vector<unsigned> filled(m_offsets.cbegin(), m_offsets.cend() - 1);
+
+    for (unsigned root = 0u ; root < m_xs.size() ; ++root) {
+      forEachCell(root, [this, &filled, root](unsigned cell) { m_roots[filled[cell]++] = root; });
+    }
+  }
+
+}
@@ -0,0 +1,147 @@
+#ifndef    ROOTS_GRID_HH
+# define   ROOTS_GRID_HH
+
+# include <vector>
+
+namespace fractsim {
+
+  class RootsGrid {
+    public:
+
+      /**
+       * @brief - Create an empty grid: no point matches any root.
+       */
+      RootsGrid();
+
+      /**
+       * @brief - Create a grid allowing to quickly retrieve the root close to some
+       *          point. The area covered by the roots is divided into cells and
+       *          each root is registered in all the cells it can match a point of:
+       *          finding the root close to a point only requires to scan the few
+       *          roots registered in the cell of the point, which does not depend
+       *          on the total number of roots.
+       * @param xs - the real part of the roots.
+       * @param ys - the imaginary part of the roots. Should have the same size as
+       *             `xs`.
+       * @param threshold - the distance along each axis below which a point is
+       *                    considered to match a root.
+       */
+      RootsGrid(const std::vector<float>& xs,
+                const std::vector<float>& ys,
+                float threshold);
+
+      /**
+       * @brief - Desctruction of the object.
+       */
+      ~RootsGrid() = default;
+
+      /**
+       * @brief - Used to retrieve the index of the first root matching the input
+       *          point, in the order of the roots provided when building the grid.
+       *          This gives the same result as a sequential scan of the roots.
+       * @param x - the real part of the point to match.
+       * @param y - the imaginary part of the point to match.
+       * @return - the index of the root matching the point or a negative value if
+       *           none is close enough.
+       */
+      int
+      find(float x,
+           float y) const noexcept;
+
+    private:
+
+      /**
+       * @brief - Used to retrieve the number of cells allocated for each root in
+       *          the grid along each axis: using more than one cell per root helps
+       *          keeping the number of roots registered in each cell small.
+       * @return - the number of cells per root along each axis.
+       */
+      static
+      unsigned
+      getCellsPerRoot() noexcept;
+
+      /**
+       * @brief - Used to compute the cell of the grid along one axis containing the
+       *          input coordinate. The coordinate is clamped to the grid.
+       * @param value - the coordinate to convert.
+       * @param min - the lower bound of the grid along this axis.
+       * @param count - the number of cells along this axis.
+       * @return - the index of the cell along this axis.
+       */
+      unsigned
+      getCell(float value,
+              float min,
+              unsigned count) const noexcept;
+
+    private:
+
+      /**
+       * @brief - The real part of the roots.
+       */
+      std::vector<float> m_xs;
+
+      /**
+       * @brief - The imaginary part of the roots.
+       */
+      std::vector<float> m_ys;
+
+      /**
+       * @brief - The distance along each axis below which a point matches a root.
+       */
+      float m_threshold;
+
+      /**
+       * @brief - The lower bound of the area covered by the grid along the `x` axis.
+       */
+      float m_xMin;
+
+      /**
+       * @brief - The lower bound of the area covered by the grid along the `y` axis.
+       */
+      float m_yMin;
+
+      /**
+       * @brief - The upper bound of the area covered by the grid along the `x` axis.
+       */
+      float m_xMax;
+
+      /**
+       * @brief - The upper bound of the area covered by the grid along the `y` axis.
+       */
+      float m_yMax;
+
+      /**
+       * @brief - The inverse of the dimensions of a cell, used to convert a point to
+       *          the cell it belongs to.
+       */
+      float m_scale;
+
+      /**
+       * @brief - The number of cells along the `x` axis.
+       */
+      unsigned m_w;
+
+      /**
+       * @brief - The number of cells along the `y` axis.
+       */
+      unsigned m_h;
+
+      /**
+       * @brief - For each cell, the index of the first root registered in it in the
+       *          `m_roots` array. The roots of the cell `id` span the range defined
+       *          by `m_offsets[id]` and `m_offsets[id + 1]`.
+       */
+      std::vector<unsigned> m_offsets;
+
+      /**
+       * @brief - The indices of the roots registered in each cell, sorted in order
+       *          of increasing index for each cell.
+       */
+      std::vector<unsigned> m_roots;
+  };
+
+}
+
+# include "RootsGrid.hxx"
+
+#endif    /* ROOTS_GRID_HH */
@@ -0,0 +1,71 @@
+#ifndef    ROOTS_GRID_HXX
+# define   ROOTS_GRID_HXX
+
+# include "RootsGrid.hh"
+# include <algorithm>
+# include <cmath>
+
+namespace fractsim {
+
+  inline
+  RootsGrid::RootsGrid():
+    m_xs(),
+    m_ys(),
+    m_threshold(0.0f),
+
+    m_xMin(0.0f),
+    m_yMin(0.0f),
+    m_xMax(0.0f),
+    m_yMax(0.0f),
+    m_scale(0.0f),
+
+    m_w(0u),
+    m_h(0u),
+
+    m_offsets(),
+    m_roots()
+  {}
+
+  inline
+  int
+  RootsGrid::find(float x,
+                  float y) const noexcept
+  {
+    // Points outside of the area covered by the grid can't match any root.
+    // Note that this also discards the `NaN` values.
+    if (!(x > m_xMin && x < m_xMax && y > m_yMin && y < m_yMax)) {
+      return -1;
+    }
+
+    unsigned cell = getCell(y, m_yMin, m_h) * m_w + getCell(x, m_xMin, m_w);
+
+    for (unsigned id = m_offsets[cell] ; id < m_offsets[cell + 1u] ; ++id) {
+      unsigned root = m_roots[id];
+
+      if (std::abs(x - m_xs[root]) < m_threshold && std::abs(y - m_ys[root]) < m_threshold) {
+        return static_cast<int>(root);
+      }
+    }
+
+    return -1;
+  }
+
+  inline
+  unsigned
+  RootsGrid::getCellsPerRoot() noexcept {
+    return 2u;
+  }
+
+  inline
+  unsigned
+  RootsGrid::getCell(float value,
+                     float min,
+                     unsigned count) const noexcept
+  {
+    float cell = std::floor((value - min) * m_scale);
+    return static_cast<unsigned>(std::min(std::max(cell, 0.0f), count - 1.0f));
+  }
+
+}
+
+#endif    /* ROOTS_GRID_HXX */
@@ -0,0 +1,245 @@
+#ifndef    SCALAR_PRECISION_HH
+# define   SCALAR_PRECISION_HH
+
+# include <string>
+# include <type_traits>
+# include <variant>
+# include "DoubleDouble.hh"
+# include "FixedPoint.hh"
+# include "GMPFloat.hh"
+
+namespace fractsim {
+  namespace scalar {
+
+    /**
+     * @brief - The quadruple precision floating point type. It is implemented in
+     *          software by the compiler so it is much slower than the hardware
+     *          types, but it allows to go much deeper before needing arbitrary
+     *          precision.
+     *          Not all the compilers provide it for all the targets: the extended
+     *          precision stands in for it otherwise, and the `Quadruple` precision
+     *          is then never selected.
+     */
+# ifdef __SIZEOF_FLOAT128__
+    using Quad = __float128;
+# else
+    using Quad = long double;
+# endif
+
+    /**
+     * @brief - The widest scalar type supported by the kernels. It is used to hold
+     *          the coordinates of the tiles so that they can be converted to any of
+     *          the precisions without losing information.
+     */
+    using Wide = Quad;
+
+    /**
+     * @brief - A value made of two double precision values. It provides almost as
+     *          many bits as the quadruple precision while relying on the hardware
+     *          operations, which allows to vectorize the kernels using it.
+     */
+    using DoubleDouble = dd::Number<double>;
+
+    /**
+     * @brief - Fixed point values made of two and three 64-bit limbs. They have
+     *          an absolute resolution, which suits the fractals as they all lie
+     *          close to the origin, and only rely on integer arithmetic: this is
+     *          much faster than the quadruple or the arbitrary precision for the
+     *          zoom levels just beyond the double-double precision.
+     */
+    using Fixed128 = fixed::Number<2u>;
+    using Fixed192 = fixed::Number<3u>;
+
+    /**
+     * @brief - A value with arbitrary precision. It is used when none of the other
+     *          types has enough bits: the kernels using it derive the precision of
+     *          their computations from the size of the pixels.
+     */
+    using Arbitrary = GMPFloat;
+
+    /**
+     * @brief - The type to use to call the math functions of the standard library
+     *          for values of type `Scalar`. The standard library does not provide
+     *          them for the types which are not natively supported by the compiler:
+     *          such values are computed in extended precision instead.
+     */
+    template <typename Scalar>
+    using Standard = std::conditional_t<
+      std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double> || std::is_same_v<Scalar, long double>,
+      Scalar,
+      long double
+    >;
+
+    /**
+     * @brief - Describes the possible precisions of the scalar type used to compute
+     *          the pixels of a view. The `Single`, `Double` and `DoubleDouble` ones
+     *          rely on the vectorized kernels while the `Extended` (`long double`),
+     *          the fixed point and the `Quadruple` precisions compute each pixel
+     *          individually. The `Arbitrary` precision relies on gmp and has no
+     *          fixed number of bits.
+     *          The values are sorted by increasing precision.
+     */
+    enum class Precision {
+      Single,
+      Double,
+      Extended,
+      DoubleDouble,
+      Fixed128,
+      Quadruple,
+      Fixed192,
+      Arbitrary
+    };
+
+    /**
+     * @brief - A list of scalar types, used to generate code for each of them.
+     */
+    template <typename... Scalars>
+    struct TypeList {};
+
+    /**
+     * @brief - The scalar types supported by the kernels, listed in the same order
+     *          as the precisions they correspond to. The quadruple precision is
+     *          only listed when it is distinct from the extended one.
+     */
+# ifdef __SIZEOF_FLOAT128__
+    using Types = TypeList<float, double, long double, DoubleDouble, Fixed128, Quad, Fixed192, Arbitrary>;
+# else
+    using Types = TypeList<float, double, long double, DoubleDouble, Fixed128, Fixed192, Arbitrary>;
+# endif
+
+    /**
+     * @brief - Builds a `std::variant` holding a pointer to a `Wrapper<Scalar>` for
+     *          each scalar type of the input list.
+     */
+    template <template <typename> class Wrapper, typename List>
+    struct Variant;
+
+    template <template <typename> class Wrapper, typename... Scalars>
+    struct Variant<Wrapper, TypeList<Scalars...>> {
+      using type = std::variant<const Wrapper<Scalars>*...>;
+    };
+
+    /**
+     * @brief - A pointer to a `Wrapper<Scalar>` for any of the supported scalar
+     *          types. This allows to pass a value templated on its precision to
+     *          a single virtual method, which retrieves the actual type with
+     *          `std::visit`.
+     */
+    template <template <typename> class Wrapper>
+    using AnyOf = typename Variant<Wrapper, Types>::type;
+
+    /**
+     * @brief - Used to retrieve a human readable name for the input precision.
+     * @param precision - the precision to convert.
+     * @return - a string describing the precision.
+     */
+    std::string
+    toString(const Precision& precision) noexcept;
+
+    /**
+     * @brief - Used to retrieve the number of bits of the mantissa of the scalar
+     *          type corresponding to the input precision.
+     * @param precision - the precision for which the mantissa should be returned.
+     * @return - the number of bits of the mantissa (including the implicit one). The
+     *           fixed point values have no exponent: the number of bits of their
+     *           fractional part is returned instead. The arbitrary precision is
+     *           not limited so the largest possible value is returned for it.
+     */
+    unsigned
+    getMantissaBits(const Precision& precision) noexcept;
+
+    /**
+     * @brief - Used to determine whether the input precision is provided by the
+     *          compiler for the current target. Only the `Quadruple` precision
+     *          might be missing.
+     * @param precision - the precision to check.
+     * @return - `true` if the precision can be used to compute the pixels.
+     */
+    bool
+    isAvailable(const Precision& precision) noexcept;
+
+    /**
+     * @brief - Used to retrieve the number of bits of the mantissa which are kept
+     *          as a margin when selecting a precision, so that the rounding errors
+     *          accumulated along the series do not become visible.
+     * @return - the number of bits of margin.
+     */
+    unsigned
+    getMarginBits() noexcept;
+
+    /**
+     * @brief - Used to retrieve the number of bits of margin needed to compute a
+     *          series of at most `accuracy` terms. The rounding errors of the terms
+     *          accumulate along the series: assuming they are independent, their
+     *          sum grows with the square root of the number of terms, which costs
+     *          half a bit each time the accuracy doubles. This comes in addition
+     *          to the margin returned by `getMarginBits()`.
+     * @param accuracy - the maximum number of terms of the series.
+     * @return - the number of bits of margin.
+     */
+    unsigned
+    getMarginBits(unsigned accuracy) noexcept;
+
+    /**
+     * @brief - Used to retrieve the number of bits returned by `getResolutionBits`
+     *          when the input values can't be resolved by any precision. This is
+     *          far beyond what any reachable zoom level needs.
+     * @return - the largest number of bits of resolution.
+     */
+    unsigned
+    getMaximumResolutionBits() noexcept;
+
+    /**
+     * @brief - Used to compute the number of bits of mantissa needed to distinguish
+     *          two consecutive pixels of size `pixel` at coordinates up to `extent`.
+     *          The margin is not included. A pixel which is not strictly positive,
+     *          a value which is not finite or a ratio too large to be represented
+     *          yield `getMaximumResolutionBits()`. The size of the pixel is given
+     *          with arbitrary precision as it is not bounded by the zoom level.
+     * @param extent - the largest absolute value of the coordinates.
+     * @param pixel - the size of a pixel.
+     * @return - the number of bits needed to resolve the pixels.
+     */
+    unsigned
+    getResolutionBits(float extent,
+                      const Arbitrary& pixel) noexcept;
+
+    /**
+     * @brief - Used to select the smallest precision allowing to distinguish pixels
+     *          of size `pixel` for coordinates up to `extent`. The largest precision
+     *          is returned in case none is enough. The `Extended` precision is never
+     *          selected as the `DoubleDouble` one is more accurate for a similar cost.
+     *          The fixed point precisions are only selected for views close to the
+     *          origin, as the resolution of their values does not depend on their
+     *          magnitude. Degenerate inputs select the `Arbitrary` precision.
+     *          The margin kept above the size of the pixels grows with the number
+     *          of terms of the series (see `getMarginBits(unsigned)`).
+     * @param extent - the largest absolute value of the coordinates of the view.
+     * @param pixel - the size of a pixel of the view.
+     * @param accuracy - the maximum number of terms of the series.
+     * @return - the precision to use to compute the view.
+     */
+    Precision
+    select(float extent,
+           const Arbitrary& pixel,
+           unsigned accuracy) noexcept;
+
+    /**
+     * @brief - Calls the input function with a value of the scalar type corresponding
+     *          to the input precision. This allows to select a templated version of a
+     *          computation from a precision only known at runtime, typically through
+     *          a generic lambda using `decltype` on its argument.
+     * @param precision - the precision for which the function should be called.
+     * @param func - the function to call.
+     */
+    template <typename Function>
+    void
+    dispatch(const Precision& precision,
+             Function func);
+
+  }
+}
+
+# include "ScalarPrecision.hxx"
+
+#endif    /* SCALAR_PRECISION_HH */
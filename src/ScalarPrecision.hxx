@@ -0,0 +1,217 @@
+#ifndef    SCALAR_PRECISION_HXX
+# define   SCALAR_PRECISION_HXX
+
+# include "ScalarPrecision.hh"
+# include <algorithm>
+# include <cfloat>
+# include <cmath>
+# include <limits>
+
+namespace fractsim {
+  namespace scalar {
+
+    inline
+    std::string
+    toString(const Precision& precision) noexcept {
+      switch (precision) {
+        case Precision::Double:
+          return "double";
+        case Precision::Extended:
+          return "extended";
+        case Precision::DoubleDouble:
+          return "double_double";
+        case Precision::Fixed128:
+          return "fixed_128";
+        case Precision::Quadruple:
+          return "quadruple";
+        case Precision::Fixed192:
+          return "fixed_192";
+        case Precision::Arbitrary:
+          return "arbitrary";
+        case Precision::Single:
+        default:
+          return "single";
+      }
+    }
+
+    inline
+    unsigned
+    getMantissaBits(const Precision& precision) noexcept {
+      switch (precision) {
+        case Precision::Double:
+          return DBL_MANT_DIG;
+        case Precision::Extended:
+          return LDBL_MANT_DIG;
+        case Precision::DoubleDouble:
+          return 2u * DBL_MANT_DIG;
+        case Precision::Fixed128:
+          return Fixed128::getFractionalBits();
+        case Precision::Quadruple:
+          return isAvailable(precision) ? 113u : LDBL_MANT_DIG;
+        case Precision::Fixed192:
+          return Fixed192::getFractionalBits();
+        case Precision::Arbitrary:
+          return std::numeric_limits<unsigned>::max();
+        case Precision::Single:
+        default:
+          return FLT_MANT_DIG;
+      }
+    }
+
+    inline
+    bool
+    isAvailable(const Precision& precision) noexcept {
+      // Only the quadruple precision depends on the support of the compiler.
+      if (precision != Precision::Quadruple) {
+        return true;
+      }
+
+# ifdef __SIZEOF_FLOAT128__
+      return true;
+# else
+      return false;
+# endif
+    }
+
+    inline
+    unsigned
+    getMarginBits() noexcept {
+      return 8u;
+    }
+
+    inline
+    unsigned
+    getMarginBits(unsigned accuracy) noexcept {
+      if (accuracy <= 1u) {
+        return getMarginBits();
+      }
+
+      double bits = std::ceil(std::log2(static_cast<double>(accuracy)) / 2.0);
+      return getMarginBits() + static_cast<unsigned>(bits);
+    }
+
+    inline
+    unsigned
+    getMaximumResolutionBits() noexcept {
+      return 1u << 20u;
+    }
+
+    inline
+    unsigned
+    getResolutionBits(float extent,
+                      const Arbitrary& pixel) noexcept
+    {
+      if (mpf_sgn(pixel.get()) <= 0 || !std::isfinite(extent)) {
+        return getMaximumResolutionBits();
+      }
+
+      if (!(extent > 0.0f)) {
+        return 0u;
+      }
+
+      // The pixel might not be representable as a double: the logarithm of the
+      // ratio is computed from its mantissa and exponent instead. The number of
+      // bits is still clamped before it is converted.
+      long exp = 0l;
+      double mantissa = mpf_get_d_2exp(&exp, pixel.get());
+
+      double bits = std::ceil(std::log2(extent) - std::log2(mantissa) - static_cast<double>(exp));
+      if (!(bits > 0.0)) {
+        return 0u;
+      }
+
+      if (!(bits < getMaximumResolutionBits())) {
+        return getMaximumResolutionBits();
+      }
+
+      return static_cast<unsigned>(bits);
+    }
+
+    inline
+    Precision
+    select(float extent,
+           const Arbitrary& pixel,
+           unsigned accuracy) noexcept
+    {
+      // We need enough bits to distinguish two consecutive pixels at the
+      // largest coordinate of the view, even after the rounding errors of
+      // all the terms of the series.
+      const unsigned margin = getMarginBits(accuracy);
+      unsigned bits = margin + getResolutionBits(extent, pixel);
+
+      // The fixed point values distinguish pixels down to their resolution
+      // whatever the coordinates, but their range is limited: the terms of
+      // the series should not overflow before diverging.
+      const float range = 4.0f;
+      unsigned fixedBits = margin + getResolutionBits(std::max(extent, 1.0f), pixel);
+
+      // The extended precision is skipped: the vectorized double-double values
+      // are about as fast while providing many more bits. The fixed point
+      // values are tried first as they are faster than the floating point
+      // values with a similar precision.
+      const Precision candidates[] = {
+        Precision::Single,
+        Precision::Double,
+        Precision::DoubleDouble,
+        Precision::Fixed128,
+        Precision::Quadruple,
+        Precision::Fixed192
+      };
+
+      for (unsigned id = 0u ; id < sizeof(candidates) / sizeof(candidates[0]) ; ++id) {
+        if (!isAvailable(candidates[id])) {
+          continue;
+        }
+
+        bool isFixed = (candidates[id] == Precision::Fixed128 || candidates[id] == Precision::Fixed192);
+        if (isFixed && extent > range) {
+          continue;
+        }
+
+        if ((isFixed ? fixedBits : bits) <= getMantissaBits(candidates[id])) {
+          return candidates[id];
+        }
+      }
+
+      return Precision::Arbitrary;
+    }
+
+    template <typename Function>
+    inline
+    void
+    dispatch(const Precision& precision,
+             Function func)
+    {
+      switch (precision) {
+        case Precision::Double:
+          func(0.0);
+          break;
+        case Precision::Extended:
+          func(0.0L);
+          break;
+        case Precision::DoubleDouble:
+          func(DoubleDouble{});
+          break;
+        case Precision::Fixed128:
+          func(Fixed128(0.0));
+          break;
+        case Precision::Quadruple:
+          func(static_cast<Quad>(0));
+          break;
+        case Precision::Fixed192:
+          func(Fixed192(0.0));
+          break;
+        case Precision::Arbitrary:
+          func(Arbitrary());
+          break;
+        case Precision::Single:
+        default:
+          func(0.0f);
+          break;
+      }
+    }
+
+  }
+}
+
+#endif    /* SCALAR_PRECISION_HXX */
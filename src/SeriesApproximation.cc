@@ -0,0 +1,99 @@
+
+# include "SeriesApproximation.hh"
+# include <cmath>
+# include <complex>
+# include <vector>
+
+namespace fractsim {
+
+  SeriesApproximation::SeriesApproximation(const ReferenceOrbit& reference,
+                                           double xMin,
+                                           double xMax,
+                                           double yMin,
+                                           double yMax,
+                                           double pixel):
+    m_xMin(xMin),
+    m_xMax(xMax),
+    m_yMin(yMin),
+    m_yMax(yMax),
+
+    m_data{0u, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}
+  {
+    compute(reference, pixel);
+  }
+
+  void
+  SeriesApproximation::compute(const ReferenceOrbit& reference,
+                               double pixel)
+  {
+    using Complex = std::complex<double>;
+
+    // The error of the approximation is the largest for the points which are
+    // the farthest from the reference: we probe the border of the area.
+    double xMid = (m_xMin + m_xMax) / 2.0;
+    double yMid = (m_yMin + m_yMax) / 2.0;
+
+    std::vector<Complex> probes = {
+      Complex(m_xMin, m_yMin), Complex(xMid, m_yMin), Complex(m_xMax, m_yMin),
+      Complex(m_xMin, yMid),                          Complex(m_xMax, yMid),
+      Complex(m_xMin, m_yMax), Complex(xMid, m_yMax), Complex(m_xMax, m_yMax)
+    };
+    std::vector<Complex> deltas(probes.size(), Complex());
+
+    kernels::ReferenceData orbit = reference.getData();
+    const kernels::PerturbationParams& params = reference.getParams();
+
+    Complex a, b, c;
+
+    // The last term of the series should not reach the accuracy, and we need
+    // the following term of the reference to check the probes.
+    for (unsigned n = 0u ; n + 1u < orbit.length && n + 1u < params.accuracy ; ++n) {
+      Complex z(orbit.real[n], orbit.imag[n]);
+
+      Complex na = 2.0 * z * a + 1.0;
+      Complex nb = 2.0 * z * b + a * a;
+      Complex nc = 2.0 * z * c + 2.0 * a * b;
+
+      if (!std::isfinite(std::norm(na)) || !std::isfinite(std::norm(nb)) || !std::isfinite(std::norm(nc))) {
+        return;
+      }
+
+      // The probes are iterated exactly (with respect to the reference) and
+      // compared to the approximation. The error is converted into a distance
+      // in the pixel space through the first order coefficient.
+      Complex next(orbit.real[n + 1u], orbit.imag[n + 1u]);
+      if (std::norm(next) >= params.threshold) {
+        return;
+      }
+
+      double maxError = getTolerance() * pixel * std::abs(na);
+
+      for (unsigned id = 0u ; id < probes.size() ; ++id) {
+        Complex dc = probes[id];
+        deltas[id] = 2.0 * z * deltas[id] + deltas[id] * deltas[id] + dc;
+
+        // A probe escaping means that some pixels cannot skip that many terms.
+        if (std::norm(next + deltas[id]) >= params.threshold) {
+          return;
+        }
+
+        Complex approx = na * dc + nb * dc * dc + nc * dc * dc * dc;
+        if (std::abs(approx - deltas[id]) > maxError) {
+          return;
+        }
+      }
+
+      a = na;
+      b = nb;
+      c = nc;
+
+      m_data = kernels::SeriesData{
+        n + 1u,
+        a.real(), a.imag(),
+        b.real(), b.imag(),
+        c.real(), c.imag()
+      };
+    }
+  }
+
+}
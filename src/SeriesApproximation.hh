@@ -0,0 +1,129 @@
+#ifndef    SERIES_APPROXIMATION_HH
+# define   SERIES_APPROXIMATION_HH
+
+# include <memory>
+# include "PerturbationKernel.hh"
+# include "ReferenceOrbit.hh"
+
+namespace fractsim {
+
+  class SeriesApproximation {
+    public:
+
+      /**
+       * @brief - Create a series approximating the offsets of the pixels of an area
+       *          to the input reference orbit. The offsets of the pixels follow the
+       *          recurrence `d(n+1) = 2 * Z(n) * d(n) + d(n)^2 + dc` which can be
+       *          approximated by a polynom in `dc` whose coefficients only depend
+       *          on the reference orbit:
+       *            `d(n) = A(n) * dc + B(n) * dc^2 + C(n) * dc^3`
+       *          As long as the approximation holds, the first terms of the series
+       *          of all the pixels can be skipped.
+       *          The number of terms to skip is determined by iterating some probe
+       *          points (on the border and at the corners of the area) along with
+       *          the coefficients: the approximation is kept as long as the error
+       *          on the offsets of the probes is small compared to a pixel.
+       *          The area is expressed in offsets to the reference point.
+       * @param reference - the reference orbit.
+       * @param xMin - the minimum offset of the area along the `x` axis.
+       * @param xMax - the maximum offset of the area along the `x` axis.
+       * @param yMin - the minimum offset of the area along the `y` axis.
+       * @param yMax - the maximum offset of the area along the `y` axis.
+       * @param pixel - the size of a pixel.
+       */
+      SeriesApproximation(const ReferenceOrbit& reference,
+                          double xMin,
+                          double xMax,
+                          double yMin,
+                          double yMax,
+                          double pixel);
+
+      /**
+       * @brief - Desctruction of the object.
+       */
+      ~SeriesApproximation() = default;
+
+      /**
+       * @brief - Used to retrieve the number of terms of the series of the pixels
+       *          that can be skipped thanks to the approximation.
+       * @return - the number of skipped terms, `0` if the series is not usable.
+       */
+      unsigned
+      getSkippedTerms() const noexcept;
+
+      /**
+       * @brief - Used to retrieve a description of the series suited for the
+       *          perturbation kernel.
+       * @return - the series approximating the first terms of the offsets.
+       */
+      const kernels::SeriesData&
+      getData() const noexcept;
+
+      /**
+       * @brief - Used to determine whether the input offset lies inside the area
+       *          for which the series has been validated. The series should not be
+       *          used for points outside of it.
+       * @param dx - the offset along the `x` axis.
+       * @param dy - the offset along the `y` axis.
+       * @return - `true` if the series can be used for this offset.
+       */
+      bool
+      contains(double dx,
+               double dy) const noexcept;
+
+    private:
+
+      /**
+       * @brief - Used to retrieve the maximum error allowed on the offsets of the
+       *          probes, expressed as a fraction of the size of a pixel.
+       * @return - the tolerance on the error of the series.
+       */
+      static
+      double
+      getTolerance() noexcept;
+
+      /**
+       * @brief - Used to compute the coefficients of the series and the number of
+       *          terms that can be skipped.
+       * @param reference - the reference orbit.
+       * @param pixel - the size of a pixel.
+       */
+      void
+      compute(const ReferenceOrbit& reference,
+              double pixel);
+
+    private:
+
+      /**
+       * @brief - The minimum offset of the area along the `x` axis.
+       */
+      double m_xMin;
+
+      /**
+       * @brief - The maximum offset of the area along the `x` axis.
+       */
+      double m_xMax;
+
+      /**
+       * @brief - The minimum offset of the area along the `y` axis.
+       */
+      double m_yMin;
+
+      /**
+       * @brief - The maximum offset of the area along the `y` axis.
+       */
+      double m_yMax;
+
+      /**
+       * @brief - The coefficients of the series and the number of terms it allows
+       *          to skip.
+       */
+      kernels::SeriesData m_data;
+  };
+
+  using SeriesApproximationShPtr = std::shared_ptr<SeriesApproximation>;
+}
+
+# include "SeriesApproximation.hxx"
+
+#endif    /* SERIES_APPROXIMATION_HH */
@@ -0,0 +1,36 @@
+#ifndef    SERIES_APPROXIMATION_HXX
+# define   SERIES_APPROXIMATION_HXX
+
+# include "SeriesApproximation.hh"
+
+namespace fractsim {
+
+  inline
+  unsigned
+  SeriesApproximation::getSkippedTerms() const noexcept {
+    return m_data.skip;
+  }
+
+  inline
+  const kernels::SeriesData&
+  SeriesApproximation::getData() const noexcept {
+    return m_data;
+  }
+
+  inline
+  bool
+  SeriesApproximation::contains(double dx,
+                                double dy) const noexcept
+  {
+    return dx >= m_xMin && dx <= m_xMax && dy >= m_yMin && dy <= m_yMax;
+  }
+
+  inline
+  double
+  SeriesApproximation::getTolerance() noexcept {
+    return 1.0e-3;
+  }
+
+}
+
+#endif    /* SERIES_APPROXIMATION_HXX */
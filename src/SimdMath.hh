@@ -0,0 +1,74 @@
+#ifndef    SIMD_MATH_HH
+# define   SIMD_MATH_HH
+
+/**
+ * @brief - Describes vectorized approximations of the elementary functions used
+ *          by the kernels. The standard library only provides scalar versions of
+ *          these functions: calling them lane by lane would prevent the kernels to
+ *          benefit from the vector units.
+ *          The approximations follow the classical range reduction and minimax
+ *          polynomials of the cephes library. Unless stated otherwise each result
+ *          is within `2` ulp of the correctly rounded value over the documented
+ *          domain, which is close to what the standard library achieves in single
+ *          precision. The special values (infinities, `NaN` and denormals) are not
+ *          handled unless stated otherwise.
+ *          Just like `SimdPacket.hh` this file should only be included by the
+ *          translation units defining kernels.
+ */
+
+# include "SimdPacket.hh"
+
+namespace fractsim {
+  namespace simd::inline FRACTSIM_KERNELS_VARIANT {
+
+    /**
+     * @brief - Computes the natural logarithm of each lane of the input packet.
+     * @param x - the values to process. Should be strictly positive and normal.
+     * @return - the logarithm of the input values.
+     */
+    Floats
+    log(const Floats& x) noexcept;
+
+    /**
+     * @brief - Computes the exponential of each lane of the input packet. Large
+     *          inputs produce infinite values while small ones are flushed to `0`
+     *          just like the standard library would do.
+     * @param x - the values to process.
+     * @return - the exponential of the input values.
+     */
+    Floats
+    exp(const Floats& x) noexcept;
+
+    /**
+     * @brief - Computes the angle of each lane of the input packet of points in
+     *          the range `[-pi; pi]`, following the conventions of `std::atan2`
+     *          including the sign of the zeros. The angle of the origin is `0`.
+     *          The absolute error is below `4e-7`.
+     * @param y - the ordinate of the points.
+     * @param x - the abscissa of the points.
+     * @return - the angle of the input points.
+     */
+    Floats
+    atan2(const Floats& y,
+          const Floats& x) noexcept;
+
+    /**
+     * @brief - Computes both the sine and the cosine of each lane of the input
+     *          packet. They share the reduction of the argument to `[-pi/4; pi/4]`
+     *          which is performed in extended precision: the error bound holds for
+     *          inputs up to `8192` in magnitude.
+     * @param x - the values to process.
+     * @param s - output packet receiving the sine of the input values.
+     * @param c - output packet receiving the cosine of the input values.
+     */
+    void
+    sincos(const Floats& x,
+           Floats& s,
+           Floats& c) noexcept;
+
+  }
+}
+
+# include "SimdMath.hxx"
+
+#endif    /* SIMD_MATH_HH */
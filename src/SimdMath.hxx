@@ -0,0 +1,170 @@
+#ifndef    SIMD_MATH_HXX
+# define   SIMD_MATH_HXX
+
+# include "SimdMath.hh"
+
+namespace fractsim {
+  namespace simd::inline FRACTSIM_KERNELS_VARIANT {
+
+    inline
+    Floats
+    log(const Floats& x) noexcept {
+      const Mask bits = reinterpret_cast<Mask>(x);
+
+      // Split the input into `m * 2^e` with `m` in `[sqrt(2)/2; sqrt(2)[` so
+      // that the polynomial is evaluated on `m - 1`, close to `0`.
+      Mask e = ((bits >> 23) & 0xff) - 126;
+      Floats m = reinterpret_cast<Floats>((bits & 0x007fffff) | 0x3f000000);
+
+      const Mask small = m < 0.707106781f;
+      e += small;
+      m = select(small, m + m, m) - 1.0f;
+
+      Floats z = m * m;
+
+      Floats y = 7.0376836292e-2f * m - 1.1514610310e-1f;
+      y = y * m + 1.1676998740e-1f;
+      y = y * m - 1.2420140846e-1f;
+      y = y * m + 1.4249322787e-1f;
+      y = y * m - 1.6668057665e-1f;
+      y = y * m + 2.0000714765e-1f;
+      y = y * m - 2.4999993993e-1f;
+      y = y * m + 3.3333331174e-1f;
+      y = y * m * z;
+
+      // The logarithm of two is split in two parts so that the product with
+      // the exponent is exact for the most significant one.
+      const Floats fe = __builtin_convertvector(e, Floats);
+
+      y += fe * -2.12194440e-4f;
+      y -= 0.5f * z;
+
+      return m + y + fe * 0.693359375f;
+    }
+
+    inline
+    Floats
+    exp(const Floats& x) noexcept {
+      // Beyond these bounds the result is respectively infinite and null: the
+      // clamping keeps the scaling below within the range of the exponents.
+      Floats v = select(x > 89.0f, broadcast<Floats>(89.0f), x);
+      v = select(v < -104.0f, broadcast<Floats>(-104.0f), v);
+
+      // Write `x = n * ln(2) + r` with `r` in `[-ln(2)/2; ln(2)/2]`. The
+      // conversion truncates towards zero so it is fixed to round down.
+      Floats fn = v * 1.44269504089f + 0.5f;
+      Mask n = __builtin_convertvector(fn, Mask);
+      n += __builtin_convertvector(n, Floats) > fn;
+      fn = __builtin_convertvector(n, Floats);
+
+      Floats r = v - fn * 0.693359375f;
+      r = r - fn * -2.12194440e-4f;
+
+      Floats z = r * r;
+
+      Floats y = 1.9875691500e-4f * r + 1.3981999507e-3f;
+      y = y * r + 8.3334519073e-3f;
+      y = y * r + 4.1665795894e-2f;
+      y = y * r + 1.6666665459e-1f;
+      y = y * r + 5.0000001201e-1f;
+      y = y * z + r + 1.0f;
+
+      // The scaling by `2^n` is performed in two steps as `n` may exceed the
+      // range of the exponents of normal values: this lets the result over-
+      // flow or become denormal as expected.
+      const Mask h = n >> 1;
+
+      y *= reinterpret_cast<Floats>((h + 127) << 23);
+      y *= reinterpret_cast<Floats>((n - h + 127) << 23);
+
+      return y;
+    }
+
+    inline
+    Floats
+    atan2(const Floats& y,
+          const Floats& x) noexcept
+    {
+      const Mask sign = reinterpret_cast<Mask>(broadcast<Floats>(-0.0f));
+      const Mask yb = reinterpret_cast<Mask>(y);
+      const Mask xb = reinterpret_cast<Mask>(x);
+
+      const Floats ay = reinterpret_cast<Floats>(yb & ~sign);
+      const Floats ax = reinterpret_cast<Floats>(xb & ~sign);
+
+      // Reduce the problem to the first octant: the ratio of the smallest to
+      // the largest coordinate is in `[0; 1]`. It is reduced further around
+      // `tan(pi/8)` with `atan(t) = pi/4 + atan((t - 1) / (t + 1))`, which is
+      // folded into the same division.
+      const Mask swap = ay > ax;
+      const Floats a = select(swap, ax, ay);
+      const Floats b = select(swap, ay, ax);
+
+      const Mask shift = a > 0.414213562f * b;
+      const Floats num = select(shift, a - b, a);
+      Floats den = select(shift, a + b, b);
+
+      // The origin has a null angle.
+      den = select(den == 0.0f, broadcast<Floats>(1.0f), den);
+
+      const Floats t = num / den;
+      const Floats z = t * t;
+
+      Floats r = 8.05374449538e-2f * z - 1.38776856032e-1f;
+      r = r * z + 1.99777106478e-1f;
+      r = r * z - 3.33329491539e-1f;
+      r = r * z * t + t;
+
+      r = select(shift, r + 0.785398163f, r);
+      r = select(swap, 1.570796327f - r, r);
+      r = select(xb < 0, 3.141592654f - r, r);
+
+      return reinterpret_cast<Floats>(reinterpret_cast<Mask>(r) ^ (yb & sign));
+    }
+
+    inline
+    void
+    sincos(const Floats& x,
+           Floats& s,
+           Floats& c) noexcept
+    {
+      const Mask sign = reinterpret_cast<Mask>(broadcast<Floats>(-0.0f));
+      const Mask xb = reinterpret_cast<Mask>(x);
+      const Floats ax = reinterpret_cast<Floats>(xb & ~sign);
+
+      // Compute the octant of the input, rounded up to an even value so that
+      // the input is reduced to `[-pi/4; pi/4]`. The multiple of `pi/4` is
+      // split in three parts to keep the subtraction accurate.
+      Mask j = __builtin_convertvector(ax * 1.27323954474f, Mask);
+      j = (j + 1) & ~1;
+
+      const Floats fj = __builtin_convertvector(j, Floats);
+
+      Floats r = ax - fj * 0.78515625f;
+      r = r - fj * 2.4187564849853515625e-4f;
+      r = r - fj * 3.77489497744594108e-8f;
+
+      const Floats z = r * r;
+
+      Floats cp = 2.443315711809948e-5f * z - 1.388731625493765e-3f;
+      cp = cp * z + 4.166664568298827e-2f;
+      cp = cp * z * z - 0.5f * z + 1.0f;
+
+      Floats sp = -1.9515295891e-4f * z + 8.3321608736e-3f;
+      sp = sp * z - 1.6666654611e-1f;
+      sp = sp * z * r + r;
+
+      // The octant determines which polynomial yields each function and the
+      // sign of the results.
+      const Mask straight = (j & 2) == 0;
+      const Mask sinSign = (((j & 4) != 0) & sign) ^ (xb & sign);
+      const Mask cosSign = (((j + 2) & 4) != 0) & sign;
+
+      s = reinterpret_cast<Floats>(reinterpret_cast<Mask>(select(straight, sp, cp)) ^ sinSign);
+      c = reinterpret_cast<Floats>(reinterpret_cast<Mask>(select(straight, cp, sp)) ^ cosSign);
+    }
+
+  }
+}
+
+#endif    /* SIMD_MATH_HXX */
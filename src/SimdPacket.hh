@@ -0,0 +1,355 @@
+#ifndef    SIMD_PACKET_HH
+# define   SIMD_PACKET_HH
+
+/**
+ * @brief - Describes the packed types used by the vectorized fractal kernels. The
+ *          types rely on the vector extensions of the compiler rather than on the
+ *          raw intrinsics: this allows to write a single version of each kernel and
+ *          let the compiler map it onto the widest instruction set enabled for the
+ *          translation unit (SSE, AVX2 or AVX-512).
+ *          Note that the width of the packets depends on the compilation flags: this
+ *          file should only be included by the translation units defining kernels
+ *          and the packed types should never appear in a public interface.
+ *          As the kernels can be built for several instruction sets in the same
+ *          program, the packed types and their operations are defined in the
+ *          namespace of the variant of the kernels (see `KernelDispatch.hh`).
+ */
+
+# include <type_traits>
+# include "KernelDispatch.hh"
+# include "ScalarPrecision.hh"
+
+namespace fractsim {
+  namespace simd::inline FRACTSIM_KERNELS_VARIANT {
+
+# if defined(__AVX512F__)
+    constexpr unsigned Width = 16u;
+# elif defined(__AVX2__)
+    constexpr unsigned Width = 8u;
+# else
+    constexpr unsigned Width = 4u;
+# endif
+
+    /**
+     * @brief - A packet of `Width` single precision values.
+     */
+    using Floats = float __attribute__((vector_size(Width * sizeof(float))));
+
+    /**
+     * @brief - A packet of `Width` iterations counters.
+     */
+    using Counters = unsigned __attribute__((vector_size(Width * sizeof(unsigned))));
+
+    /**
+     * @brief - The result of a comparison between two packets: each lane is either
+     *          `0` (false) or `-1` (true, all bits set).
+     */
+    using Mask = int __attribute__((vector_size(Width * sizeof(int))));
+
+    /**
+     * @brief - A packet of `Width` double precision values. Depending on the
+     *          instruction set it may span several registers.
+     */
+    using Doubles = double __attribute__((vector_size(Width * sizeof(double))));
+
+    /**
+     * @brief - The result of a comparison between two packets of doubles. Just
+     *          like for `Mask` each lane is either `0` or `-1`.
+     */
+    using WideMask = long long __attribute__((vector_size(Width * sizeof(long long))));
+
+    /**
+     * @brief - A packet of `Width` double-double values. The high and low parts of
+     *          the values are kept in separate packets so that the arithmetic can
+     *          be applied on all the lanes at once.
+     */
+    using DoubleDoubles = dd::Number<Doubles>;
+
+    /**
+     * @brief - Associates the packed type to use for each scalar type handled by
+     *          the vectorized kernels. Only single, double and double-double values
+     *          can be packed: the other types should be processed one at a time.
+     */
+    template <typename Scalar>
+    struct PacketOf;
+
+    template <>
+    struct PacketOf<float> {
+      using Type = Floats;
+    };
+
+    template <>
+    struct PacketOf<double> {
+      using Type = Doubles;
+    };
+
+    template <>
+    struct PacketOf<scalar::DoubleDouble> {
+      using Type = DoubleDoubles;
+    };
+
+    template <typename Scalar>
+    using Packet = typename PacketOf<Scalar>::Type;
+
+    /**
+     * @brief - Indicates whether values of type `Scalar` can be packed.
+     */
+    template <typename Scalar>
+    constexpr bool isPacked =
+      std::is_same_v<Scalar, float> ||
+      std::is_same_v<Scalar, double> ||
+      std::is_same_v<Scalar, scalar::DoubleDouble>
+    ;
+
+    /**
+     * @brief - Used to determine whether at least one lane of the input mask is set.
+     * @param m - the mask to check.
+     * @return - `true` if at least one lane is set.
+     */
+    bool
+    any(const Mask& m) noexcept;
+
+    /**
+     * @brief - Converts a mask resulting from a comparison between packets of
+     *          doubles into a mask usable with the single precision packets and
+     *          the counters.
+     * @param m - the mask to convert.
+     * @return - the equivalent mask.
+     */
+    Mask
+    narrow(const WideMask& m) noexcept;
+
+    /**
+     * @brief - The reverse operation of `narrow`: converts a mask so that it can
+     *          be used to select lanes of packets of doubles.
+     * @param m - the mask to convert.
+     * @return - the equivalent mask.
+     */
+    WideMask
+    widen(const Mask& m) noexcept;
+
+    /**
+     * @brief - Converts a packet to single precision. This is typically used to
+     *          perform comparisons, which are not natively supported on packets of
+     *          doubles spanning several registers. Only the high part of packets of
+     *          double-double values is relevant for the conversion.
+     * @param p - the packet to convert.
+     * @return - the packet converted to single precision.
+     */
+    Floats
+    toFloats(const Floats& p) noexcept;
+
+    Floats
+    toFloats(const Doubles& p) noexcept;
+
+    Floats
+    toFloats(const DoubleDoubles& p) noexcept;
+
+    /**
+     * @brief - Computes the squared modulus of the complex values described by the
+     *          input packets and converts it to single precision. This is used for
+     *          the escape tests which do not need the full precision: the low part
+     *          of double-double values is ignored.
+     * @param re - the real parts of the complex values.
+     * @param im - the imaginary parts of the complex values.
+     * @return - the squared modulus of each lane.
+     */
+    Floats
+    norm(const Floats& re,
+         const Floats& im) noexcept;
+
+    Floats
+    norm(const Doubles& re,
+         const Doubles& im) noexcept;
+
+    Floats
+    norm(const DoubleDoubles& re,
+         const DoubleDoubles& im) noexcept;
+
+    /**
+     * @brief - Checks whether the squared modulus of the complex values described
+     *          by the input packets is smaller than a bound. Unlike `norm` the
+     *          packets of doubles are compared in double precision: the bound is
+     *          typically of the order of the squared size of a pixel and would be
+     *          flushed to zero in single precision at deep zooms.
+     * @param re - the real parts of the complex values.
+     * @param im - the imaginary parts of the complex values.
+     * @param bound - the value to compare the squared modulus to.
+     * @return - a mask where the lanes for which the squared modulus is smaller
+     *           than the bound are set.
+     */
+    Mask
+    within(const Floats& re,
+           const Floats& im,
+           double bound) noexcept;
+
+    Mask
+    within(const Doubles& re,
+           const Doubles& im,
+           double bound) noexcept;
+
+    Mask
+    within(const DoubleDoubles& re,
+           const DoubleDoubles& im,
+           double bound) noexcept;
+
+    /**
+     * @brief - Compares two packets lane by lane. For packets of doubles the sign of
+     *          the difference is evaluated in single precision, which preserves the
+     *          result of the comparison.
+     * @param lhs - the left operand of the comparison.
+     * @param rhs - the right operand of the comparison.
+     * @return - a mask where the lanes for which `lhs < rhs` are set.
+     */
+    Mask
+    less(const Floats& lhs,
+         const Floats& rhs) noexcept;
+
+    Mask
+    less(const Doubles& lhs,
+         const Doubles& rhs) noexcept;
+
+    Mask
+    less(const DoubleDoubles& lhs,
+         const DoubleDoubles& rhs) noexcept;
+
+    /**
+     * @brief - Selects the lanes of `a` for which the mask is set and the lanes of
+     *          `b` for the others. The packets of doubles are blended with bitwise
+     *          operations as a conditional expression is not native for them.
+     * @param m - the mask selecting the lanes.
+     * @param a - the packet providing the lanes for which the mask is set.
+     * @param b - the packet providing the other lanes.
+     * @return - the blended packet.
+     */
+    Floats
+    select(const Mask& m,
+           const Floats& a,
+           const Floats& b) noexcept;
+
+    Doubles
+    select(const Mask& m,
+           const Doubles& a,
+           const Doubles& b) noexcept;
+
+    DoubleDoubles
+    select(const Mask& m,
+           const DoubleDoubles& a,
+           const DoubleDoubles& b) noexcept;
+
+    /**
+     * @brief - Computes the sum of all the lanes of the input counters. This is
+     *          not meant to be used in the inner loops of the kernels but rather
+     *          to gather statistics once a packet has been processed.
+     * @param c - the counters to sum.
+     * @return - the sum of all the lanes.
+     */
+    unsigned long long
+    sum(const Counters& c) noexcept;
+
+    /**
+     * @brief - Creates a packet where each lane is assigned its own index, i.e.
+     *          `{0, 1, 2, ..., Width - 1}`.
+     * @return - the packet of lanes indices.
+     */
+    template <typename Packet>
+    Packet
+    lanes() noexcept;
+
+    /**
+     * @brief - Creates a mask where only the first `count` lanes are set. This is
+     *          typically used to disable the lanes which are past the end of a row
+     *          of pixels.
+     * @param count - the number of lanes to enable.
+     * @return - the mask with the first `count` lanes set.
+     */
+    Mask
+    firstLanes(unsigned count) noexcept;
+
+    /**
+     * @brief - Creates a packet where all the lanes are set to the input value.
+     *          This is equivalent to adding the value to a null packet but it
+     *          allows the compiler to use a single broadcast instruction even
+     *          for packets spanning several registers.
+     * @param value - the value to assign to each lane.
+     * @return - the packet with all the lanes set to `value`.
+     */
+    template <typename Packet, typename Value>
+    Packet
+    broadcast(Value value) noexcept;
+
+    /**
+     * @brief - Loads at most `Width` values from the input array into a packet. In
+     *          case less than `Width` elements are available the remaining lanes
+     *          are set to `0`.
+     * @param in - the array to load values from.
+     * @param count - the number of elements available in the array.
+     * @return - the packet holding the loaded values.
+     */
+    template <typename Packet, typename Value>
+    Packet
+    load(const Value* in,
+         unsigned count) noexcept;
+
+    /**
+     * @brief - Stores the lanes of a packet into the output array. At most `count`
+     *          lanes are saved which allows to handle the end of rows.
+     * @param p - the packet to save.
+     * @param out - the output array.
+     * @param count - the number of elements available in the output array.
+     */
+    template <typename Packet, typename Value>
+    void
+    store(const Packet& p,
+          Value* out,
+          unsigned count) noexcept;
+
+    /**
+     * @brief - Stores the lanes of a packet at arbitrary positions of the output
+     *          array: each lane for which the mask is set is saved at the index
+     *          given by the corresponding lane of `indices`. This is used when the
+     *          lanes of a packet do not map to contiguous elements of the array.
+     * @param p - the packet to save.
+     * @param out - the output array.
+     * @param indices - the index of each lane in the output array.
+     * @param valid - the lanes to save.
+     */
+    template <typename Packet, typename Value>
+    void
+    scatter(const Packet& p,
+            Value* out,
+            const Counters& indices,
+            const Mask& valid) noexcept;
+
+    /**
+     * @brief - Retrieves the value held by a single lane of a packet. This is not
+     *          meant to be used in the inner loops of the kernels as the lanes are
+     *          accessed one at a time.
+     * @param p - the packet to read.
+     * @param lane - the index of the lane to read.
+     * @return - the value of the lane.
+     */
+    template <typename Value, typename Packet>
+    Value
+    extract(const Packet& p,
+            unsigned lane) noexcept;
+
+    /**
+     * @brief - Assigns a single lane of a packet, the other lanes being left
+     *          unchanged.
+     * @param p - the packet to modify.
+     * @param lane - the index of the lane to assign.
+     * @param value - the value to assign to the lane.
+     */
+    template <typename Packet, typename Value>
+    void
+    insert(Packet& p,
+           unsigned lane,
+           const Value& value) noexcept;
+
+  }
+}
+
+# include "SimdPacket.hxx"
+
+#endif    /* SIMD_PACKET_HH */
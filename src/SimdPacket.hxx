@@ -0,0 +1,318 @@
+#ifndef    SIMD_PACKET_HXX
+# define   SIMD_PACKET_HXX
+
+# include "SimdPacket.hh"
+# include <immintrin.h>
+
+namespace fractsim {
+  namespace simd::inline FRACTSIM_KERNELS_VARIANT {
+
+    inline
+    bool
+    any(const Mask& m) noexcept {
+      // This test is performed at each iteration of the kernels so we
+      // use a dedicated instruction rather than scanning each lane.
+# if defined(__AVX512F__)
+      return _mm512_test_epi32_mask(reinterpret_cast<__m512i>(m), reinterpret_cast<__m512i>(m)) != 0;
+# elif defined(__AVX2__)
+      return _mm256_testz_si256(reinterpret_cast<__m256i>(m), reinterpret_cast<__m256i>(m)) == 0;
+# else
+      return _mm_movemask_ps(reinterpret_cast<__m128>(m)) != 0;
+# endif
+    }
+
+    inline
+    Mask
+    narrow(const WideMask& m) noexcept {
+      return __builtin_convertvector(m, Mask);
+    }
+
+    inline
+    WideMask
+    widen(const Mask& m) noexcept {
+      return __builtin_convertvector(m, WideMask);
+    }
+
+    inline
+    Floats
+    toFloats(const Floats& p) noexcept {
+      return p;
+    }
+
+    inline
+    Floats
+    toFloats(const Doubles& p) noexcept {
+      return __builtin_convertvector(p, Floats);
+    }
+
+    inline
+    Floats
+    toFloats(const DoubleDoubles& p) noexcept {
+      return toFloats(p.hi);
+    }
+
+    inline
+    Floats
+    norm(const Floats& re,
+         const Floats& im) noexcept
+    {
+      return re * re + im * im;
+    }
+
+    inline
+    Floats
+    norm(const Doubles& re,
+         const Doubles& im) noexcept
+    {
+      return toFloats(re * re + im * im);
+    }
+
+    inline
+    Floats
+    norm(const DoubleDoubles& re,
+         const DoubleDoubles& im) noexcept
+    {
+      return norm(re.hi, im.hi);
+    }
+
+    inline
+    Mask
+    within(const Floats& re,
+           const Floats& im,
+           double bound) noexcept
+    {
+      return re * re + im * im < static_cast<float>(bound);
+    }
+
+    inline
+    Mask
+    within(const Doubles& re,
+           const Doubles& im,
+           double bound) noexcept
+    {
+      return narrow(re * re + im * im < bound);
+    }
+
+    inline
+    Mask
+    within(const DoubleDoubles& re,
+           const DoubleDoubles& im,
+           double bound) noexcept
+    {
+      // The low parts are negligible compared to the bound.
+      return within(re.hi, im.hi, bound);
+    }
+
+    inline
+    Mask
+    less(const Floats& lhs,
+         const Floats& rhs) noexcept
+    {
+      return lhs < rhs;
+    }
+
+    inline
+    Mask
+    less(const Doubles& lhs,
+         const Doubles& rhs) noexcept
+    {
+      return toFloats(lhs - rhs) < 0.0f;
+    }
+
+    inline
+    Mask
+    less(const DoubleDoubles& lhs,
+         const DoubleDoubles& rhs) noexcept
+    {
+      // The high part of the difference carries its sign.
+      return toFloats((lhs - rhs).hi) < 0.0f;
+    }
+
+    inline
+    Floats
+    select(const Mask& m,
+           const Floats& a,
+           const Floats& b) noexcept
+    {
+      return m ? a : b;
+    }
+
+    inline
+    Doubles
+    select(const Mask& m,
+           const Doubles& a,
+           const Doubles& b) noexcept
+    {
+      const WideMask w = widen(m);
+      const WideMask ia = reinterpret_cast<WideMask>(a);
+      const WideMask ib = reinterpret_cast<WideMask>(b);
+
+      return reinterpret_cast<Doubles>((ia & w) | (ib & ~w));
+    }
+
+    inline
+    DoubleDoubles
+    select(const Mask& m,
+           const DoubleDoubles& a,
+           const DoubleDoubles& b) noexcept
+    {
+      return DoubleDoubles(select(m, a.hi, b.hi), select(m, a.lo, b.lo));
+    }
+
+    inline
+    unsigned long long
+    sum(const Counters& c) noexcept {
+      unsigned long long out = 0u;
+
+      for (unsigned id = 0u ; id < Width ; ++id) {
+        out += c[id];
+      }
+
+      return out;
+    }
+
+    template <typename Packet>
+    inline
+    Packet
+    lanes() noexcept {
+      Packet out = Packet{};
+
+      if constexpr (std::is_same_v<Packet, DoubleDoubles>) {
+        out.hi = lanes<Doubles>();
+      }
+      else {
+        for (unsigned id = 0u ; id < Width ; ++id) {
+          out[id] = id;
+        }
+      }
+
+      return out;
+    }
+
+    inline
+    Mask
+    firstLanes(unsigned count) noexcept {
+      Mask out = Mask{};
+
+      for (unsigned id = 0u ; id < Width ; ++id) {
+        out[id] = (id < count ? -1 : 0);
+      }
+
+      return out;
+    }
+
+    template <typename Packet, typename Value>
+    inline
+    Packet
+    broadcast(Value value) noexcept {
+      Packet out;
+
+      if constexpr (std::is_same_v<Packet, DoubleDoubles>) {
+        const scalar::DoubleDouble v = static_cast<scalar::DoubleDouble>(value);
+
+        out.hi = broadcast<Doubles>(v.hi);
+        out.lo = broadcast<Doubles>(v.lo);
+      }
+      else {
+        for (unsigned id = 0u ; id < Width ; ++id) {
+          out[id] = value;
+        }
+      }
+
+      return out;
+    }
+
+    template <typename Packet, typename Value>
+    inline
+    Packet
+    load(const Value* in,
+         unsigned count) noexcept
+    {
+      Packet out = Packet{};
+
+      if constexpr (std::is_same_v<Packet, DoubleDoubles>) {
+        // The parts of the values are interleaved in the input array so they
+        // need to be gathered one by one.
+        for (unsigned id = 0u ; id < count && id < Width ; ++id) {
+          out.hi[id] = in[id].hi;
+          out.lo[id] = in[id].lo;
+        }
+      }
+      else if (count >= Width) {
+        __builtin_memcpy(&out, in, sizeof(Packet));
+      }
+      else {
+        for (unsigned id = 0u ; id < count ; ++id) {
+          out[id] = in[id];
+        }
+      }
+
+      return out;
+    }
+
+    template <typename Packet, typename Value>
+    inline
+    void
+    store(const Packet& p,
+          Value* out,
+          unsigned count) noexcept
+    {
+      if (count >= Width) {
+        __builtin_memcpy(out, &p, sizeof(Packet));
+        return;
+      }
+
+      for (unsigned id = 0u ; id < count ; ++id) {
+        out[id] = p[id];
+      }
+    }
+
+    template <typename Packet, typename Value>
+    inline
+    void
+    scatter(const Packet& p,
+            Value* out,
+            const Counters& indices,
+            const Mask& valid) noexcept
+    {
+      for (unsigned id = 0u ; id < Width ; ++id) {
+        if (valid[id] != 0) {
+          out[indices[id]] = p[id];
+        }
+      }
+    }
+
+    template <typename Value, typename Packet>
+    inline
+    Value
+    extract(const Packet& p,
+            unsigned lane) noexcept
+    {
+      if constexpr (std::is_same_v<Packet, DoubleDoubles>) {
+        return Value(p.hi[lane], p.lo[lane]);
+      }
+      else {
+        return p[lane];
+      }
+    }
+
+    template <typename Packet, typename Value>
+    inline
+    void
+    insert(Packet& p,
+           unsigned lane,
+           const Value& value) noexcept
+    {
+      if constexpr (std::is_same_v<Packet, DoubleDoubles>) {
+        p.hi[lane] = value.hi;
+        p.lo[lane] = value.lo;
+      }
+      else {
+        p[lane] = value;
+      }
+    }
+
+  }
+}
+
+#endif    /* SIMD_PACKET_HXX */
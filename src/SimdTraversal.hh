@@ -0,0 +1,132 @@
+#ifndef    SIMD_TRAVERSAL_HH
+# define   SIMD_TRAVERSAL_HH
+
+# include "PixelBlock.hh"
+# include "SimdPacket.hh"
+# include "RenderingStatistics.hh"
+
+/**
+ * @brief - Describes how the inputs of the kernels are split into packets. This
+ *          allows each kernel to only describe the processing of a single packet
+ *          and be used with all the supported inputs.
+ *          Just like the packed types, this file should only be included by the
+ *          translation units defining kernels.
+ */
+
+namespace fractsim {
+  namespace simd::inline FRACTSIM_KERNELS_VARIANT {
+
+    /**
+     * @brief - Describes the number of columns of pixels of the packets used by the
+     *          traversals packing 2D blocks of pixels. The packets are as square as
+     *          possible, the width being the largest dimension.
+     * @return - the width of the packets in pixels.
+     */
+    constexpr
+    unsigned
+    getPacketWidth() noexcept;
+
+    /**
+     * @brief - Describes the number of rows of pixels of the packets used by the
+     *          traversals packing 2D blocks of pixels.
+     * @return - the height of the packets in pixels.
+     */
+    constexpr
+    unsigned
+    getPacketHeight() noexcept;
+
+    /**
+     * @brief - Used to compute the position of a packet in the grid of packets of a
+     *          block from its index in the traversal. The curves of the `Morton`
+     *          and `Hilbert` traversals are defined on a square grid whose side is
+     *          a power of two: the positions lying outside of the actual grid of
+     *          the block should be skipped.
+     * @param order - the traversal of the block. Should not be `Rows`.
+     * @param id - the index of the packet in the traversal.
+     * @param columns - the number of packets in each row of the grid.
+     * @param side - the side of the square grid covered by the curves.
+     * @param x - output value receiving the column of the packet.
+     * @param y - output value receiving the row of the packet.
+     */
+    void
+    locatePacket(const kernels::Traversal& order,
+                 unsigned id,
+                 unsigned columns,
+                 unsigned side,
+                 unsigned& x,
+                 unsigned& y) noexcept;
+
+    /**
+     * @brief - Calls the input function for each packet of pixels of the block. The
+     *          pixels are grouped and ordered as defined by the traversal of the
+     *          block: with the `Rows` traversal the last packet of each row may
+     *          only be partially filled, while with the other ones the packets on
+     *          the right and top borders may be.
+     *          The function is called with the coordinates of the pixels of the
+     *          packet, the mask of the valid lanes and the index of each lane in
+     *          the output arrays.
+     *          The coordinates are packed according to the scalar type of the block
+     *          which should be supported according to `isPacked`.
+     * @param block - the block of pixels to traverse.
+     * @param func - the function to call for each packet.
+     */
+    template <typename Scalar, typename Function>
+    void
+    forEachPacket(const kernels::PixelBlock<Scalar>& block,
+                  Function func) noexcept;
+
+    /**
+     * @brief - Similar to the above method but traverses a list of pixels in the
+     *          order of the list. Only the last packet may be partially filled.
+     * @param points - the list of pixels to traverse.
+     * @param func - the function to call for each packet.
+     */
+    template <typename Scalar, typename Function>
+    void
+    forEachPacket(const kernels::PointList<Scalar>& points,
+                  Function func) noexcept;
+
+    /**
+     * @brief - Used to account for the coherence of a packet of pixels in the input
+     *          statistics, based on how much the number of terms of its pixels
+     *          differ. See the `span` and `spread` statistics for more details.
+     * @param terms - the number of terms of each lane of the packet.
+     * @param valid - the lanes which hold actual pixels.
+     * @param stats - the statistics to update.
+     */
+    void
+    accumulateSpread(const Counters& terms,
+                     const Mask& valid,
+                     RenderingStatistics& stats) noexcept;
+
+    /**
+     * @brief - Calls the input function for each pixel of the block. This is meant
+     *          for the scalar types which cannot be packed: the coordinates of the
+     *          pixels are generated in the same way as for the packets.
+     *          The function is called with the coordinates of the pixel and its
+     *          index in the output arrays. The pixels are always processed row by
+     *          row, whatever the traversal of the block.
+     * @param block - the block of pixels to traverse.
+     * @param func - the function to call for each pixel.
+     */
+    template <typename Scalar, typename Function>
+    void
+    forEachPixel(const kernels::PixelBlock<Scalar>& block,
+                 Function func) noexcept;
+
+    /**
+     * @brief - Similar to the above method but traverses a list of pixels.
+     * @param points - the list of pixels to traverse.
+     * @param func - the function to call for each pixel.
+     */
+    template <typename Scalar, typename Function>
+    void
+    forEachPixel(const kernels::PointList<Scalar>& points,
+                 Function func) noexcept;
+
+  }
+}
+
+# include "SimdTraversal.hxx"
+
+#endif    /* SIMD_TRAVERSAL_HH */
@@ -0,0 +1,229 @@
+#ifndef    SIMD_TRAVERSAL_HXX
+# define   SIMD_TRAVERSAL_HXX
+
+# include "SimdTraversal.hh"
+# include <algorithm>
+# include <utility>
+
+namespace fractsim {
+  namespace simd::inline FRACTSIM_KERNELS_VARIANT {
+
+    constexpr
+    unsigned
+    getPacketWidth() noexcept {
+      return Width / getPacketHeight();
+    }
+
+    constexpr
+    unsigned
+    getPacketHeight() noexcept {
+      // Half of the bits of the width of the packets, rounded down.
+      unsigned rows = 1u;
+      while (rows * rows * 4u <= Width) {
+        rows *= 2u;
+      }
+
+      return rows;
+    }
+
+    inline
+    void
+    locatePacket(const kernels::Traversal& order,
+                 unsigned id,
+                 unsigned columns,
+                 unsigned side,
+                 unsigned& x,
+                 unsigned& y) noexcept
+    {
+      x = 0u;
+      y = 0u;
+
+      switch (order) {
+        case kernels::Traversal::Morton:
+          // The bits of the index alternate between the column and the row.
+          for (unsigned bit = 0u ; (id >> (2u * bit)) != 0u ; ++bit) {
+            x |= ((id >> (2u * bit)) & 1u) << bit;
+            y |= ((id >> (2u * bit + 1u)) & 1u) << bit;
+          }
+          break;
+        case kernels::Traversal::Hilbert:
+          // See https://en.wikipedia.org/wiki/Hilbert_curve#Applications_and_mapping_algorithms
+          for (unsigned s = 1u ; s < side ; s *= 2u) {
+            const unsigned rx = 1u & (id / 2u);
+            const unsigned ry = 1u & (id ^ rx);
+
+            if (ry == 0u) {
+              if (rx == 1u) {
+                x = s - 1u - x;
+                y = s - 1u - y;
+              }
+
+              std::swap(x, y);
+            }
+
+            x += s * rx;
+            y += s * ry;
+            id /= 4u;
+          }
+          break;
+        case kernels::Traversal::Blocks:
+        case kernels::Traversal::Rows:
+        default:
+          x = id % columns;
+          y = id / columns;
+          break;
+      }
+    }
+
+    template <typename Scalar, typename Function>
+    inline
+    void
+    forEachPacket(const kernels::PixelBlock<Scalar>& block,
+                  Function func) noexcept
+    {
+      using Values = Packet<Scalar>;
+
+      const Values xMin = broadcast<Values>(block.xMin);
+      const Values stepX = broadcast<Values>(block.stepX);
+
+      if (block.order == kernels::Traversal::Rows) {
+        const Values lanes = simd::lanes<Values>();
+        const Counters ids = simd::lanes<Counters>();
+
+        for (unsigned y = 0u ; y < block.h ; ++y) {
+          const Values py = broadcast<Values>(block.yMin + y * block.stepY);
+          unsigned offset = y * block.w;
+
+          for (unsigned x = 0u ; x < block.w ; x += Width) {
+            // Generate the coordinates of the pixels of this packet in the same
+            // way as it is done for the scalar path.
+            Values px = xMin + (lanes + broadcast<Values>(static_cast<Scalar>(x))) * stepX;
+
+            func(px, py, firstLanes(block.w - x), ids + (offset + x));
+          }
+        }
+
+        return;
+      }
+
+      const Values yMin = broadcast<Values>(block.yMin);
+      const Values stepY = broadcast<Values>(block.stepY);
+
+      // Position of each lane in the packet: the pixels of a packet are laid
+      // out row by row.
+      Counters cx = Counters{}, cy = Counters{};
+      Values dx = Values{}, dy = Values{};
+
+      for (unsigned lane = 0u ; lane < Width ; ++lane) {
+        cx[lane] = lane % getPacketWidth();
+        cy[lane] = lane / getPacketWidth();
+
+        insert(dx, lane, static_cast<Scalar>(cx[lane]));
+        insert(dy, lane, static_cast<Scalar>(cy[lane]));
+      }
+
+      const unsigned columns = (block.w + getPacketWidth() - 1u) / getPacketWidth();
+      const unsigned rows = (block.h + getPacketHeight() - 1u) / getPacketHeight();
+
+      unsigned side = 1u;
+      while (side < columns || side < rows) {
+        side *= 2u;
+      }
+
+      const unsigned count = (block.order == kernels::Traversal::Blocks ? columns * rows : side * side);
+
+      for (unsigned id = 0u ; id < count ; ++id) {
+        unsigned bx, by;
+        locatePacket(block.order, id, columns, side, bx, by);
+
+        if (bx >= columns || by >= rows) {
+          continue;
+        }
+
+        const unsigned x = bx * getPacketWidth();
+        const unsigned y = by * getPacketHeight();
+
+        // The coordinates are computed from integer offsets just like for the
+        // scalar path so that the pixels are strictly identical.
+        Values px = xMin + (dx + broadcast<Values>(static_cast<Scalar>(x))) * stepX;
+        Values py = yMin + (dy + broadcast<Values>(static_cast<Scalar>(y))) * stepY;
+
+        const Counters gx = cx + x;
+        const Counters gy = cy + y;
+
+        func(px, py, (gx < block.w) & (gy < block.h), gy * block.w + gx);
+      }
+    }
+
+    template <typename Scalar, typename Function>
+    inline
+    void
+    forEachPacket(const kernels::PointList<Scalar>& points,
+                  Function func) noexcept
+    {
+      using Values = Packet<Scalar>;
+
+      const Counters ids = simd::lanes<Counters>();
+
+      for (unsigned id = 0u ; id < points.count ; id += Width) {
+        Values px = load<Values>(points.xs + id, points.count - id);
+        Values py = load<Values>(points.ys + id, points.count - id);
+
+        func(px, py, firstLanes(points.count - id), ids + id);
+      }
+    }
+
+    inline
+    void
+    accumulateSpread(const Counters& terms,
+                     const Mask& valid,
+                     RenderingStatistics& stats) noexcept
+    {
+      unsigned longest = 0u, count = 0u;
+      unsigned long long total = 0u;
+
+      for (unsigned lane = 0u ; lane < Width ; ++lane) {
+        if (valid[lane] != 0) {
+          longest = std::max(longest, terms[lane]);
+          total += terms[lane];
+          ++count;
+        }
+      }
+
+      const unsigned long long span = static_cast<unsigned long long>(longest) * count;
+
+      stats.span += span;
+      stats.spread += span - total;
+    }
+
+    template <typename Scalar, typename Function>
+    inline
+    void
+    forEachPixel(const kernels::PixelBlock<Scalar>& block,
+                 Function func) noexcept
+    {
+      for (unsigned y = 0u ; y < block.h ; ++y) {
+        const Scalar py = block.yMin + y * block.stepY;
+        unsigned offset = y * block.w;
+
+        for (unsigned x = 0u ; x < block.w ; ++x) {
+          func(block.xMin + static_cast<Scalar>(x) * block.stepX, py, offset + x);
+        }
+      }
+    }
+
+    template <typename Scalar, typename Function>
+    inline
+    void
+    forEachPixel(const kernels::PointList<Scalar>& points,
+                 Function func) noexcept
+    {
+      for (unsigned id = 0u ; id < points.count ; ++id) {
+        func(points.xs[id], points.ys[id], id);
+      }
+    }
+
+  }
+}
+
+#endif    /* SIMD_TRAVERSAL_HXX */